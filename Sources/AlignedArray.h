@@ -0,0 +1,139 @@
+#ifndef _ALIGNEDARRAY_H_
+#define _ALIGNEDARRAY_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : AlignedArray.h
+ *
+ * Creation Date : 10/17/2026 - 10:20
+ * Last Modified : 10/17/2026 - 10:20
+ * ==========================================================================================
+ * Description   : Fixed-size array of plain values, cache-line aligned and padded to a whole
+ *                 number of 512-bit registers so SIMD loops never need a scalar tail on loads.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+
+const unsigned int ALIGNED_ARRAY_ALIGNMENT = 64;
+const unsigned int ALIGNED_ARRAY_PADDING = 16;
+
+
+template <typename T>
+class AlignedArray
+{
+
+public:
+    AlignedArray()
+    {
+        data_ = nullptr;
+        size_ = 0;
+        capacity_ = 0;
+    }
+
+    explicit AlignedArray(unsigned int size) : AlignedArray()
+    {
+        Resize(size);
+    }
+
+    AlignedArray(const AlignedArray &other) : AlignedArray()
+    {
+        Resize(other.size_);
+        if (capacity_ > 0)
+        {
+            memcpy(data_, other.data_, capacity_ * sizeof(T));
+        }
+    }
+
+    AlignedArray &operator=(const AlignedArray &other)
+    {
+        if (this != &other)
+        {
+            Resize(other.size_);
+            if (capacity_ > 0)
+            {
+                memcpy(data_, other.data_, capacity_ * sizeof(T));
+            }
+        }
+        return *this;
+    }
+
+    ~AlignedArray()
+    {
+        Free();
+    }
+
+    // Contents are zeroed, including the padding past size.
+    void Resize(unsigned int size)
+    {
+        unsigned int capacity = (size + ALIGNED_ARRAY_PADDING - 1) / ALIGNED_ARRAY_PADDING * ALIGNED_ARRAY_PADDING;
+        if (capacity != capacity_)
+        {
+            Free();
+            if (capacity > 0)
+            {
+#if defined(_MSC_VER)
+                data_ = (T *)_aligned_malloc(capacity * sizeof(T), ALIGNED_ARRAY_ALIGNMENT);
+#else
+                void *memory = nullptr;
+                data_ = (posix_memalign(&memory, ALIGNED_ARRAY_ALIGNMENT, capacity * sizeof(T)) == 0) ? (T *)memory : nullptr;
+#endif
+                if (!data_)
+                {
+                    throw std::bad_alloc();
+                }
+            }
+            capacity_ = capacity;
+        }
+        size_ = size;
+        Fill(T());
+    }
+
+    void Fill(const T &value)
+    {
+        for (unsigned int index = 0; index < capacity_; ++index)
+        {
+            data_[index] = value;
+        }
+    }
+
+    T &operator[](unsigned int index) { return data_[index]; }
+    const T &operator[](unsigned int index) const { return data_[index]; }
+
+    T *Data() { return data_; }
+    const T *Data() const { return data_; }
+    unsigned int Size() const { return size_; }
+    unsigned int Capacity() const { return capacity_; }
+
+
+private:
+    T *data_;
+    unsigned int size_;
+    unsigned int capacity_;
+
+    void Free()
+    {
+        if (data_)
+        {
+#if defined(_MSC_VER)
+            _aligned_free(data_);
+#else
+            free(data_);
+#endif
+        }
+        data_ = nullptr;
+        capacity_ = 0;
+    }
+
+};
+
+
+#endif // _ALIGNEDARRAY_H_
@@ -0,0 +1,332 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : BendingConstraints.cpp
+ *
+ * Creation Date : 10/17/2026 - 20:30
+ * Last Modified : 10/18/2026 - 10:20
+ * ==========================================================================================
+ * Description   : References:
+ *                 (1) Bergou et al., "A Quadratic Bending Model for Inextensible Surfaces"
+ *
+ *                 (2) Bender et al., "Position-Based Simulation Methods in Computer Graphics"
+ *                     (isometric bending as a position-based constraint)
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <cmath>
+
+#include "BendingConstraints.h"
+#include "MeshTopology.h"
+#include "ParticleStore.h"
+
+#if CLOTH_SIMD_X86
+#include <immintrin.h>
+#endif
+
+
+static inline float
+Cotangent(const glm::vec3 &a, const glm::vec3 &b)
+{
+    float sine = glm::length(glm::cross(a, b));
+    return (sine > 0.0f) ? glm::dot(a, b) / sine : 0.0f;
+}
+
+
+// STRUCTURES
+// ----------
+
+void
+BendingBatch::Build(const std::vector<EdgeStencil> &stencils, const std::vector<unsigned int> &order,
+                    const std::vector<glm::vec3> &restPositions)
+{
+    Count = (unsigned int)order.size();
+    for (unsigned int corner = 0; corner < BENDING_STENCIL_SIZE; ++corner)
+    {
+        Index[corner].Resize(Count);
+        Weight[corner].Resize(Count);
+    }
+
+    for (unsigned int slot = 0; slot < Count; ++slot)
+    {
+        const EdgeStencil &stencil = stencils[order[slot]];
+        unsigned int vertices[BENDING_STENCIL_SIZE] = { stencil.Vertex1, stencil.Vertex2, stencil.Opposite1, stencil.Opposite2 };
+        for (unsigned int corner = 0; corner < BENDING_STENCIL_SIZE; ++corner)
+        {
+            Index[corner][slot] = vertices[corner];
+        }
+
+        // Q = 3 / (A0 + A1) K K^T, c.f. Bergou et al. section 4; stored as sqrt(3 / (A0 + A1)) K.
+        glm::vec3 x0 = restPositions[vertices[0]];
+        glm::vec3 e0 = restPositions[vertices[1]] - x0;
+        glm::vec3 e1 = restPositions[vertices[2]] - x0;
+        glm::vec3 e2 = restPositions[vertices[3]] - x0;
+        glm::vec3 e3 = restPositions[vertices[2]] - restPositions[vertices[1]];
+        glm::vec3 e4 = restPositions[vertices[3]] - restPositions[vertices[1]];
+        float area = 0.5f * (glm::length(glm::cross(e0, e1)) + glm::length(glm::cross(e0, e2)));
+        if (area <= 0.0f)
+        {
+            continue;
+        }
+
+        float c01 = Cotangent(e0, e1);
+        float c02 = Cotangent(e0, e2);
+        float c03 = Cotangent(-e0, e3);
+        float c04 = Cotangent(-e0, e4);
+        float scale = sqrtf(3.0f / area);
+        Weight[0][slot] = scale * (c03 + c04);
+        Weight[1][slot] = scale * (c01 + c02);
+        Weight[2][slot] = scale * (-c01 - c03);
+        Weight[3][slot] = scale * (-c02 - c04);
+    }
+}
+
+
+// KERNELS
+// -------
+
+// dx_j = w_j K_j d for the four vertices of a stencil, d being the (scaled) delta lambda.
+static inline void
+ApplyBendingCorrection(const BendingBatch &batch, unsigned int stencil, float dx, float dy, float dz,
+                       ParticleStore *particles)
+{
+    for (unsigned int corner = 0; corner < BENDING_STENCIL_SIZE; ++corner)
+    {
+        unsigned int vertex = batch.Index[corner][stencil];
+        float factor = particles->InvMass[vertex] * batch.Weight[corner][stencil];
+        particles->PredictedX[vertex] += factor * dx;
+        particles->PredictedY[vertex] += factor * dy;
+        particles->PredictedZ[vertex] += factor * dz;
+    }
+}
+
+static void
+SolveScalar(const BendingBatch &batch, unsigned int begin, unsigned int end, float stiffness, float compliance,
+            float *lambda, ParticleStore *particles)
+{
+    const float *px = particles->PredictedX.Data();
+    const float *py = particles->PredictedY.Data();
+    const float *pz = particles->PredictedZ.Data();
+    const float *w = particles->InvMass.Data();
+    float *lambdaX = lambda;
+    float *lambdaY = lambda ? lambda + batch.Count : nullptr;
+    float *lambdaZ = lambda ? lambda + 2 * batch.Count : nullptr;
+
+    for (unsigned int stencil = begin; stencil < end; ++stencil)
+    {
+        float sx = 0.0f;
+        float sy = 0.0f;
+        float sz = 0.0f;
+        float weightSum = 0.0f;
+        for (unsigned int corner = 0; corner < BENDING_STENCIL_SIZE; ++corner)
+        {
+            unsigned int vertex = batch.Index[corner][stencil];
+            float k = batch.Weight[corner][stencil];
+            sx += k * px[vertex];
+            sy += k * py[vertex];
+            sz += k * pz[vertex];
+            weightSum += w[vertex] * k * k;
+        }
+
+        // C = s, grad_j C = K_j I, so sum w_j |grad_j C|^2 = sum w_j K_j^2 for every row.
+        float denominator = weightSum + compliance;
+        if (denominator <= 0.0f)
+        {
+            continue;
+        }
+
+        float dx;
+        float dy;
+        float dz;
+        if (lambda)
+        {
+            dx = (-sx - compliance * lambdaX[stencil]) / denominator;
+            dy = (-sy - compliance * lambdaY[stencil]) / denominator;
+            dz = (-sz - compliance * lambdaZ[stencil]) / denominator;
+            lambdaX[stencil] += dx;
+            lambdaY[stencil] += dy;
+            lambdaZ[stencil] += dz;
+        }
+        else
+        {
+            dx = -sx / denominator;
+            dy = -sy / denominator;
+            dz = -sz / denominator;
+        }
+
+        ApplyBendingCorrection(batch, stencil, stiffness * dx, stiffness * dy, stiffness * dz, particles);
+    }
+}
+
+#if CLOTH_SIMD_X86
+
+CLOTH_TARGET_SSE static void
+SolveSse(const BendingBatch &batch, unsigned int begin, unsigned int end, float stiffness, float compliance,
+         float *lambda, ParticleStore *particles)
+{
+    const float *px = particles->PredictedX.Data();
+    const float *py = particles->PredictedY.Data();
+    const float *pz = particles->PredictedZ.Data();
+    const float *w = particles->InvMass.Data();
+    float *lambdaX = lambda;
+    float *lambdaY = lambda ? lambda + batch.Count : nullptr;
+    float *lambdaZ = lambda ? lambda + 2 * batch.Count : nullptr;
+    __m128 zero = _mm_setzero_ps();
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 vCompliance = _mm_set1_ps(compliance);
+    __m128 vStiffness = _mm_set1_ps(stiffness);
+    alignas(16) float d[3][4];
+
+    unsigned int stencil = begin;
+    for (; stencil + 4 <= end; stencil += 4)
+    {
+        __m128 sx = zero;
+        __m128 sy = zero;
+        __m128 sz = zero;
+        __m128 weightSum = zero;
+        for (unsigned int corner = 0; corner < BENDING_STENCIL_SIZE; ++corner)
+        {
+            const unsigned int *index = batch.Index[corner].Data() + stencil;
+            __m128 k = _mm_loadu_ps(batch.Weight[corner].Data() + stencil);
+            sx = _mm_add_ps(sx, _mm_mul_ps(k, _mm_set_ps(px[index[3]], px[index[2]], px[index[1]], px[index[0]])));
+            sy = _mm_add_ps(sy, _mm_mul_ps(k, _mm_set_ps(py[index[3]], py[index[2]], py[index[1]], py[index[0]])));
+            sz = _mm_add_ps(sz, _mm_mul_ps(k, _mm_set_ps(pz[index[3]], pz[index[2]], pz[index[1]], pz[index[0]])));
+            __m128 invMass = _mm_set_ps(w[index[3]], w[index[2]], w[index[1]], w[index[0]]);
+            weightSum = _mm_add_ps(weightSum, _mm_mul_ps(invMass, _mm_mul_ps(k, k)));
+        }
+
+        __m128 denominator = _mm_add_ps(weightSum, vCompliance);
+        __m128 active = _mm_cmpgt_ps(denominator, zero);
+        __m128 divisor = _mm_blendv_ps(one, denominator, active);
+        __m128 nx = _mm_sub_ps(zero, sx);
+        __m128 ny = _mm_sub_ps(zero, sy);
+        __m128 nz = _mm_sub_ps(zero, sz);
+        if (lambda)
+        {
+            __m128 previousX = _mm_loadu_ps(lambdaX + stencil);
+            __m128 previousY = _mm_loadu_ps(lambdaY + stencil);
+            __m128 previousZ = _mm_loadu_ps(lambdaZ + stencil);
+            nx = _mm_and_ps(active, _mm_div_ps(_mm_sub_ps(nx, _mm_mul_ps(vCompliance, previousX)), divisor));
+            ny = _mm_and_ps(active, _mm_div_ps(_mm_sub_ps(ny, _mm_mul_ps(vCompliance, previousY)), divisor));
+            nz = _mm_and_ps(active, _mm_div_ps(_mm_sub_ps(nz, _mm_mul_ps(vCompliance, previousZ)), divisor));
+            _mm_storeu_ps(lambdaX + stencil, _mm_add_ps(previousX, nx));
+            _mm_storeu_ps(lambdaY + stencil, _mm_add_ps(previousY, ny));
+            _mm_storeu_ps(lambdaZ + stencil, _mm_add_ps(previousZ, nz));
+        }
+        else
+        {
+            nx = _mm_and_ps(active, _mm_div_ps(nx, divisor));
+            ny = _mm_and_ps(active, _mm_div_ps(ny, divisor));
+            nz = _mm_and_ps(active, _mm_div_ps(nz, divisor));
+        }
+
+        _mm_store_ps(d[0], _mm_mul_ps(vStiffness, nx));
+        _mm_store_ps(d[1], _mm_mul_ps(vStiffness, ny));
+        _mm_store_ps(d[2], _mm_mul_ps(vStiffness, nz));
+        for (unsigned int lane = 0; lane < 4; ++lane)
+        {
+            ApplyBendingCorrection(batch, stencil + lane, d[0][lane], d[1][lane], d[2][lane], particles);
+        }
+    }
+
+    SolveScalar(batch, stencil, end, stiffness, compliance, lambda, particles);
+}
+
+CLOTH_TARGET_AVX2 static void
+SolveAvx2(const BendingBatch &batch, unsigned int begin, unsigned int end, float stiffness, float compliance,
+          float *lambda, ParticleStore *particles)
+{
+    const float *px = particles->PredictedX.Data();
+    const float *py = particles->PredictedY.Data();
+    const float *pz = particles->PredictedZ.Data();
+    const float *w = particles->InvMass.Data();
+    float *lambdaX = lambda;
+    float *lambdaY = lambda ? lambda + batch.Count : nullptr;
+    float *lambdaZ = lambda ? lambda + 2 * batch.Count : nullptr;
+    __m256 zero = _mm256_setzero_ps();
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 vCompliance = _mm256_set1_ps(compliance);
+    __m256 vStiffness = _mm256_set1_ps(stiffness);
+    alignas(32) float d[3][8];
+
+    unsigned int stencil = begin;
+    for (; stencil + 8 <= end; stencil += 8)
+    {
+        __m256 sx = zero;
+        __m256 sy = zero;
+        __m256 sz = zero;
+        __m256 weightSum = zero;
+        for (unsigned int corner = 0; corner < BENDING_STENCIL_SIZE; ++corner)
+        {
+            __m256i index = _mm256_loadu_si256((const __m256i *)(batch.Index[corner].Data() + stencil));
+            __m256 k = _mm256_loadu_ps(batch.Weight[corner].Data() + stencil);
+            sx = _mm256_fmadd_ps(k, _mm256_i32gather_ps(px, index, 4), sx);
+            sy = _mm256_fmadd_ps(k, _mm256_i32gather_ps(py, index, 4), sy);
+            sz = _mm256_fmadd_ps(k, _mm256_i32gather_ps(pz, index, 4), sz);
+            weightSum = _mm256_fmadd_ps(_mm256_i32gather_ps(w, index, 4), _mm256_mul_ps(k, k), weightSum);
+        }
+
+        __m256 denominator = _mm256_add_ps(weightSum, vCompliance);
+        __m256 active = _mm256_cmp_ps(denominator, zero, _CMP_GT_OQ);
+        __m256 divisor = _mm256_blendv_ps(one, denominator, active);
+        __m256 nx = _mm256_sub_ps(zero, sx);
+        __m256 ny = _mm256_sub_ps(zero, sy);
+        __m256 nz = _mm256_sub_ps(zero, sz);
+        if (lambda)
+        {
+            __m256 previousX = _mm256_loadu_ps(lambdaX + stencil);
+            __m256 previousY = _mm256_loadu_ps(lambdaY + stencil);
+            __m256 previousZ = _mm256_loadu_ps(lambdaZ + stencil);
+            nx = _mm256_and_ps(active, _mm256_div_ps(_mm256_fnmadd_ps(vCompliance, previousX, nx), divisor));
+            ny = _mm256_and_ps(active, _mm256_div_ps(_mm256_fnmadd_ps(vCompliance, previousY, ny), divisor));
+            nz = _mm256_and_ps(active, _mm256_div_ps(_mm256_fnmadd_ps(vCompliance, previousZ, nz), divisor));
+            _mm256_storeu_ps(lambdaX + stencil, _mm256_add_ps(previousX, nx));
+            _mm256_storeu_ps(lambdaY + stencil, _mm256_add_ps(previousY, ny));
+            _mm256_storeu_ps(lambdaZ + stencil, _mm256_add_ps(previousZ, nz));
+        }
+        else
+        {
+            nx = _mm256_and_ps(active, _mm256_div_ps(nx, divisor));
+            ny = _mm256_and_ps(active, _mm256_div_ps(ny, divisor));
+            nz = _mm256_and_ps(active, _mm256_div_ps(nz, divisor));
+        }
+
+        _mm256_store_ps(d[0], _mm256_mul_ps(vStiffness, nx));
+        _mm256_store_ps(d[1], _mm256_mul_ps(vStiffness, ny));
+        _mm256_store_ps(d[2], _mm256_mul_ps(vStiffness, nz));
+        for (unsigned int lane = 0; lane < 8; ++lane)
+        {
+            ApplyBendingCorrection(batch, stencil + lane, d[0][lane], d[1][lane], d[2][lane], particles);
+        }
+    }
+
+    SolveScalar(batch, stencil, end, stiffness, compliance, lambda, particles);
+}
+
+#endif
+
+
+// FUNCTIONS
+// ---------
+
+void
+SolveBendingConstraints(SimdLevel level,
+                        const BendingBatch &batch,
+                        unsigned int begin,
+                        unsigned int end,
+                        float stiffness,
+                        float compliance,
+                        float *lambda,
+                        ParticleStore *particles)
+{
+#if CLOTH_SIMD_X86
+    switch (level)
+    {
+        case SIMD_AVX512:
+        case SIMD_AVX2: SolveAvx2(batch, begin, end, stiffness, compliance, lambda, particles); return;
+        case SIMD_SSE: SolveSse(batch, begin, end, stiffness, compliance, lambda, particles); return;
+        default: break;
+    }
+#endif
+    SolveScalar(batch, begin, end, stiffness, compliance, lambda, particles);
+}
@@ -0,0 +1,66 @@
+#ifndef _BENDINGCONSTRAINTS_H_
+#define _BENDINGCONSTRAINTS_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : BendingConstraints.h
+ *
+ * Creation Date : 10/17/2026 - 20:30
+ * Last Modified : 10/18/2026 - 10:20
+ * ==========================================================================================
+ * Description   : Quadratic isometric bending. For an inextensible surface the bending energy
+ *                 of the two triangles around an interior edge is quadratic in the positions of
+ *                 their four vertices, E = 1/2 x^T Q x, with a constant Q = K K^T built from the
+ *                 rest cotangents and areas. So each stencil keeps its 4 weights K, and a
+ *                 projection treats s = sum K_j x_j as a 3-row constraint C = s with the
+ *                 constant gradient K_j I: E = 1/2 |s|^2 stays quadratic and the update is
+ *                 linear, a handful of multiply-adds, no angles, no normals, no acos.
+ *
+ *                 The energy is 0 for a flat stencil: the rest shape is assumed flat.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+#include "glm/glm.hpp"
+
+#include "AlignedArray.h"
+#include "CpuFeatures.h"
+
+
+struct EdgeStencil;
+class ParticleStore;
+
+
+const unsigned int BENDING_STENCIL_SIZE = 4;
+
+
+struct BendingBatch
+{
+    // Index[0] and Index[1] are the shared edge, Index[2] and Index[3] the opposite vertices.
+    AlignedArray<unsigned int> Index[BENDING_STENCIL_SIZE];
+    AlignedArray<float> Weight[BENDING_STENCIL_SIZE];
+    unsigned int Count = 0;
+
+    // Stencils are stored in the given order; weights come from the rest positions. Degenerate
+    // stencils get zero weights and never move anything.
+    void Build(const std::vector<EdgeStencil> &stencils, const std::vector<unsigned int> &order,
+               const std::vector<glm::vec3> &restPositions);
+};
+
+
+// Projects stencils [begin, end) in place, so the range must not contain two stencils sharing a
+// vertex (one color). XPBD when lambda is given: compliance is alpha / h^2 and lambda, one
+// vector per stencil stored as 3 blocks of batch.Count (x, then y, then z), accumulates over the
+// iterations of a substep. Otherwise PBD, each correction scaled by stiffness.
+void SolveBendingConstraints(SimdLevel level,
+                             const BendingBatch &batch,
+                             unsigned int begin,
+                             unsigned int end,
+                             float stiffness,
+                             float compliance,
+                             float *lambda,
+                             ParticleStore *particles);
+
+
+#endif // _BENDINGCONSTRAINTS_H_
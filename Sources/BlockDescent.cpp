@@ -0,0 +1,126 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : BlockDescent.cpp
+ *
+ * Creation Date : 10/17/2026 - 20:05
+ * Last Modified : 10/17/2026 - 20:05
+ * ==========================================================================================
+ * Description   : References:
+ *                 (1) Chen et al., "Vertex Block Descent"
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <algorithm>
+#include <cmath>
+#include "glm/glm.hpp"
+
+#include "BlockDescent.h"
+#include "DistanceKernels.h"
+#include "ParticleStore.h"
+#include "VertexIncidence.h"
+
+
+// STRUCTURES
+// ----------
+
+void
+BlockDescentState::Resize(unsigned int particleCount)
+{
+    InertiaX.Resize(particleCount);
+    InertiaY.Resize(particleCount);
+    InertiaZ.Resize(particleCount);
+    PreviousX.Resize(particleCount);
+    PreviousY.Resize(particleCount);
+    PreviousZ.Resize(particleCount);
+}
+
+
+// FUNCTIONS
+// ---------
+
+void
+SolveVertexBlockDescent(const unsigned int *order,
+                        unsigned int begin,
+                        unsigned int end,
+                        const DistanceConstraintBatch &constraints,
+                        const VertexIncidence &incidence,
+                        float stiffness,
+                        float timeStep,
+                        float omega,
+                        BlockDescentState *state,
+                        ParticleStore *particles,
+                        DistanceResidual *residual)
+{
+    float *px = particles->PredictedX.Data();
+    float *py = particles->PredictedY.Data();
+    float *pz = particles->PredictedZ.Data();
+    const float *w = particles->InvMass.Data();
+    float inverseTimeStepSquared = 1.0f / (timeStep * timeStep);
+
+    for (unsigned int entry = begin; entry < end; ++entry)
+    {
+        unsigned int vertex = order[entry];
+        if (w[vertex] <= 0.0f)
+        {
+            continue;
+        }
+
+        glm::vec3 position(px[vertex], py[vertex], pz[vertex]);
+        glm::vec3 inertia(state->InertiaX[vertex], state->InertiaY[vertex], state->InertiaZ[vertex]);
+        float inertiaWeight = inverseTimeStepSquared / w[vertex];
+
+        // Force (minus the gradient) and Hessian of the local energy.
+        glm::vec3 force = -inertiaWeight * (position - inertia);
+        glm::mat3 hessian(inertiaWeight);
+
+        for (unsigned int slot = incidence.Offsets[vertex]; slot < incidence.Offsets[vertex + 1]; ++slot)
+        {
+            unsigned int constraint = incidence.Constraints[slot];
+            unsigned int index1 = constraints.Index1[constraint];
+            unsigned int other = (index1 == vertex) ? constraints.Index2[constraint] : index1;
+
+            glm::vec3 delta = position - glm::vec3(px[other], py[other], pz[other]);
+            float length = glm::length(delta);
+            float restLength = constraints.RestLength[constraint];
+            if ((length <= restLength) || (length < 1e-6f))
+            {
+                continue;
+            }
+
+            if (((index1 == vertex) || (w[index1] <= 0.0f)) && (restLength > 0.0f))
+            {
+                float stretch = (length - restLength) / restLength;
+                residual->Max = std::max(residual->Max, stretch);
+                residual->SumSquares += (double)stretch * (double)stretch;
+            }
+
+            // Stretched spring: E = k / 2 (l - L)^2. The Hessian's transverse part, k (1 - L / l),
+            // is positive as long as the spring is stretched.
+            glm::vec3 direction = delta / length;
+            glm::mat3 outer = glm::outerProduct(direction, direction);
+            force -= stiffness * (length - restLength) * direction;
+            hessian += stiffness * (outer + (1.0f - restLength / length) * (glm::mat3(1.0f) - outer));
+        }
+
+        glm::vec3 updated = position;
+        if (fabsf(glm::determinant(hessian)) > 1e-12f)
+        {
+            updated += glm::inverse(hessian) * force;
+        }
+
+        // x_n+1 = omega (x^_n+1 - x_n-1) + x_n-1
+        if (omega != 1.0f)
+        {
+            glm::vec3 previous(state->PreviousX[vertex], state->PreviousY[vertex], state->PreviousZ[vertex]);
+            updated = omega * (updated - previous) + previous;
+        }
+
+        state->PreviousX[vertex] = position.x;
+        state->PreviousY[vertex] = position.y;
+        state->PreviousZ[vertex] = position.z;
+        px[vertex] = updated.x;
+        py[vertex] = updated.y;
+        pz[vertex] = updated.z;
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef _BLOCKDESCENT_H_
+#define _BLOCKDESCENT_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : BlockDescent.h
+ *
+ * Creation Date : 10/17/2026 - 20:05
+ * Last Modified : 10/17/2026 - 20:05
+ * ==========================================================================================
+ * Description   : Vertex Block Descent: each vertex in turn takes one Newton step on its local
+ *                 energy, the inertia term m / (2 h^2) |x - y|^2 plus the springs of its
+ *                 incident constraints, with the rest of the mesh held fixed. Vertices of one
+ *                 color share no constraint, so a color is updated in parallel.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include "AlignedArray.h"
+
+
+struct DistanceConstraintBatch;
+struct DistanceResidual;
+struct VertexIncidence;
+class ParticleStore;
+
+
+struct BlockDescentState
+{
+    // Inertial target y of every particle (the predicted positions at the start of the substep).
+    AlignedArray<float> InertiaX;
+    AlignedArray<float> InertiaY;
+    AlignedArray<float> InertiaZ;
+    // Positions two iterations back, for the Chebyshev step.
+    AlignedArray<float> PreviousX;
+    AlignedArray<float> PreviousY;
+    AlignedArray<float> PreviousZ;
+
+    void Resize(unsigned int particleCount);
+};
+
+
+// Updates the vertices order[begin, end) in place, in the predicted positions. With omega != 1
+// each new position is extrapolated from the one two iterations back, c.f. Chebyshev
+// acceleration. The stretch of each constraint, before its first free end moves, is added to
+// residual.
+void SolveVertexBlockDescent(const unsigned int *order,
+                             unsigned int begin,
+                             unsigned int end,
+                             const DistanceConstraintBatch &constraints,
+                             const VertexIncidence &incidence,
+                             float stiffness,
+                             float timeStep,
+                             float omega,
+                             BlockDescentState *state,
+                             ParticleStore *particles,
+                             DistanceResidual *residual);
+
+
+#endif // _BLOCKDESCENT_H_
@@ -0,0 +1,223 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : BlockSparseMatrix.cpp
+ *
+ * Creation Date : 10/17/2026 - 19:40
+ * Last Modified : 10/17/2026 - 19:40
+ * ==========================================================================================
+ * Description   :
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <algorithm>
+
+#include "BlockSparseMatrix.h"
+
+#if CLOTH_SIMD_X86
+#include <immintrin.h>
+#endif
+
+
+// STRUCTURES
+// ----------
+
+void
+BlockSparseMatrix::BuildPattern(unsigned int rowCount, const unsigned int *index1, const unsigned int *index2, unsigned int pairCount)
+{
+    // Counting sort of the (row, column) pairs, both directions, then sorted and deduplicated
+    // within each row.
+    std::vector<unsigned int> counts(rowCount + 1, 1);
+    for (unsigned int pair = 0; pair < pairCount; ++pair)
+    {
+        ++counts[index1[pair]];
+        ++counts[index2[pair]];
+    }
+
+    std::vector<unsigned int> starts(rowCount + 1, 0);
+    for (unsigned int row = 0; row < rowCount; ++row)
+    {
+        starts[row + 1] = starts[row] + counts[row];
+    }
+
+    std::vector<unsigned int> columns(starts[rowCount]);
+    std::vector<unsigned int> fill(starts.begin(), starts.end() - 1);
+    for (unsigned int row = 0; row < rowCount; ++row)
+    {
+        columns[fill[row]++] = row;
+    }
+    for (unsigned int pair = 0; pair < pairCount; ++pair)
+    {
+        columns[fill[index1[pair]]++] = index2[pair];
+        columns[fill[index2[pair]]++] = index1[pair];
+    }
+
+    RowOffsets.resize(rowCount + 1);
+    Diagonal.resize(rowCount);
+    Columns.clear();
+    RowOffsets[0] = 0;
+    for (unsigned int row = 0; row < rowCount; ++row)
+    {
+        auto rowBegin = columns.begin() + starts[row];
+        auto rowEnd = columns.begin() + starts[row + 1];
+        std::sort(rowBegin, rowEnd);
+        rowEnd = std::unique(rowBegin, rowEnd);
+
+        Diagonal[row] = (unsigned int)Columns.size() + (unsigned int)(std::lower_bound(rowBegin, rowEnd, row) - rowBegin);
+        Columns.insert(Columns.end(), rowBegin, rowEnd);
+        RowOffsets[row + 1] = (unsigned int)Columns.size();
+    }
+
+    Blocks.Resize((unsigned int)Columns.size() * BLOCK_FLOATS);
+}
+
+unsigned int
+BlockSparseMatrix::FindBlock(unsigned int row, unsigned int column) const
+{
+    auto rowBegin = Columns.begin() + RowOffsets[row];
+    auto rowEnd = Columns.begin() + RowOffsets[row + 1];
+    return RowOffsets[row] + (unsigned int)(std::lower_bound(rowBegin, rowEnd, column) - rowBegin);
+}
+
+unsigned int
+BlockSparseMatrix::GetRowCount() const
+{
+    return (unsigned int)Diagonal.size();
+}
+
+
+// KERNELS
+// -------
+
+static void
+MultiplyScalar(const BlockSparseMatrix &matrix, unsigned int begin, unsigned int end, const float *x, float *y)
+{
+    const float *blocks = matrix.Blocks.Data();
+    for (unsigned int row = begin; row < end; ++row)
+    {
+        float sum[3] = { 0.0f, 0.0f, 0.0f };
+        for (unsigned int block = matrix.RowOffsets[row]; block < matrix.RowOffsets[row + 1]; ++block)
+        {
+            const float *values = blocks + BLOCK_FLOATS * block;
+            const float *column = x + VECTOR_STRIDE * matrix.Columns[block];
+            for (unsigned int r = 0; r < 3; ++r)
+            {
+                sum[r] += values[r] * column[0] + values[4 + r] * column[1] + values[8 + r] * column[2];
+            }
+        }
+
+        y[VECTOR_STRIDE * row + 0] = sum[0];
+        y[VECTOR_STRIDE * row + 1] = sum[1];
+        y[VECTOR_STRIDE * row + 2] = sum[2];
+        y[VECTOR_STRIDE * row + 3] = 0.0f;
+    }
+}
+
+#if CLOTH_SIMD_X86
+
+// Each block column is one register: the block row times x is the sum of the columns scaled by
+// the broadcast components of x. The fourth lanes are always 0.
+CLOTH_TARGET_SSE static void
+MultiplySse(const BlockSparseMatrix &matrix, unsigned int begin, unsigned int end, const float *x, float *y)
+{
+    const float *blocks = matrix.Blocks.Data();
+    for (unsigned int row = begin; row < end; ++row)
+    {
+        __m128 sum = _mm_setzero_ps();
+        for (unsigned int block = matrix.RowOffsets[row]; block < matrix.RowOffsets[row + 1]; ++block)
+        {
+            const float *values = blocks + BLOCK_FLOATS * block;
+            __m128 column = _mm_load_ps(x + VECTOR_STRIDE * matrix.Columns[block]);
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_load_ps(values + 0), _mm_shuffle_ps(column, column, _MM_SHUFFLE(0, 0, 0, 0))));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_load_ps(values + 4), _mm_shuffle_ps(column, column, _MM_SHUFFLE(1, 1, 1, 1))));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_load_ps(values + 8), _mm_shuffle_ps(column, column, _MM_SHUFFLE(2, 2, 2, 2))));
+        }
+        _mm_store_ps(y + VECTOR_STRIDE * row, sum);
+    }
+}
+
+// Two block rows at a time, one per 128-bit lane.
+CLOTH_TARGET_AVX2 static void
+MultiplyAvx2(const BlockSparseMatrix &matrix, unsigned int begin, unsigned int end, const float *x, float *y)
+{
+    const float *blocks = matrix.Blocks.Data();
+    unsigned int row = begin;
+    for (; row + 2 <= end; row += 2)
+    {
+        unsigned int block0 = matrix.RowOffsets[row];
+        unsigned int end0 = matrix.RowOffsets[row + 1];
+        unsigned int block1 = end0;
+        unsigned int end1 = matrix.RowOffsets[row + 2];
+
+        __m256 sum = _mm256_setzero_ps();
+        for (; (block0 < end0) && (block1 < end1); ++block0, ++block1)
+        {
+            const float *values0 = blocks + BLOCK_FLOATS * block0;
+            const float *values1 = blocks + BLOCK_FLOATS * block1;
+            __m256 column = _mm256_set_m128(_mm_load_ps(x + VECTOR_STRIDE * matrix.Columns[block1]),
+                                            _mm_load_ps(x + VECTOR_STRIDE * matrix.Columns[block0]));
+            __m256 c0 = _mm256_set_m128(_mm_load_ps(values1 + 0), _mm_load_ps(values0 + 0));
+            __m256 c1 = _mm256_set_m128(_mm_load_ps(values1 + 4), _mm_load_ps(values0 + 4));
+            __m256 c2 = _mm256_set_m128(_mm_load_ps(values1 + 8), _mm_load_ps(values0 + 8));
+            sum = _mm256_fmadd_ps(c0, _mm256_shuffle_ps(column, column, _MM_SHUFFLE(0, 0, 0, 0)), sum);
+            sum = _mm256_fmadd_ps(c1, _mm256_shuffle_ps(column, column, _MM_SHUFFLE(1, 1, 1, 1)), sum);
+            sum = _mm256_fmadd_ps(c2, _mm256_shuffle_ps(column, column, _MM_SHUFFLE(2, 2, 2, 2)), sum);
+        }
+
+        // Whichever row has more blocks finishes on its own lane.
+        __m128 sum0 = _mm256_castps256_ps128(sum);
+        __m128 sum1 = _mm256_extractf128_ps(sum, 1);
+        for (; block0 < end0; ++block0)
+        {
+            const float *values = blocks + BLOCK_FLOATS * block0;
+            __m128 column = _mm_load_ps(x + VECTOR_STRIDE * matrix.Columns[block0]);
+            sum0 = _mm_fmadd_ps(_mm_load_ps(values + 0), _mm_shuffle_ps(column, column, _MM_SHUFFLE(0, 0, 0, 0)), sum0);
+            sum0 = _mm_fmadd_ps(_mm_load_ps(values + 4), _mm_shuffle_ps(column, column, _MM_SHUFFLE(1, 1, 1, 1)), sum0);
+            sum0 = _mm_fmadd_ps(_mm_load_ps(values + 8), _mm_shuffle_ps(column, column, _MM_SHUFFLE(2, 2, 2, 2)), sum0);
+        }
+        for (; block1 < end1; ++block1)
+        {
+            const float *values = blocks + BLOCK_FLOATS * block1;
+            __m128 column = _mm_load_ps(x + VECTOR_STRIDE * matrix.Columns[block1]);
+            sum1 = _mm_fmadd_ps(_mm_load_ps(values + 0), _mm_shuffle_ps(column, column, _MM_SHUFFLE(0, 0, 0, 0)), sum1);
+            sum1 = _mm_fmadd_ps(_mm_load_ps(values + 4), _mm_shuffle_ps(column, column, _MM_SHUFFLE(1, 1, 1, 1)), sum1);
+            sum1 = _mm_fmadd_ps(_mm_load_ps(values + 8), _mm_shuffle_ps(column, column, _MM_SHUFFLE(2, 2, 2, 2)), sum1);
+        }
+        _mm_store_ps(y + VECTOR_STRIDE * row, sum0);
+        _mm_store_ps(y + VECTOR_STRIDE * (row + 1), sum1);
+    }
+
+    MultiplySse(matrix, row, end, x, y);
+}
+
+#endif
+
+
+// FUNCTIONS
+// ---------
+
+void
+MultiplyBlockRows(SimdLevel level, const BlockSparseMatrix &matrix, unsigned int begin, unsigned int end,
+                  const float *x, float *y)
+{
+#if CLOTH_SIMD_X86
+    switch (level)
+    {
+        case SIMD_AVX512:
+        case SIMD_AVX2: MultiplyAvx2(matrix, begin, end, x, y); return;
+        case SIMD_SSE: MultiplySse(matrix, begin, end, x, y); return;
+        default: break;
+    }
+#endif
+    MultiplyScalar(matrix, begin, end, x, y);
+}
+
+void
+MultiplyBlock(const float *block, const float *x, float *y)
+{
+    for (unsigned int r = 0; r < 3; ++r)
+    {
+        y[r] = block[r] * x[0] + block[4 + r] * x[1] + block[8 + r] * x[2];
+    }
+    y[3] = 0.0f;
+}
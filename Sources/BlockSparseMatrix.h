@@ -0,0 +1,57 @@
+#ifndef _BLOCKSPARSEMATRIX_H_
+#define _BLOCKSPARSEMATRIX_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : BlockSparseMatrix.h
+ *
+ * Creation Date : 10/17/2026 - 19:40
+ * Last Modified : 10/17/2026 - 19:40
+ * ==========================================================================================
+ * Description   : Symmetric matrix of 3x3 blocks in block-compressed rows, one block row per
+ *                 particle. Vectors hold 4 floats per particle (x, y, z, unused) so a block
+ *                 times a vector is three SSE multiply-adds.
+ *
+ *                 Blocks are stored column by column, each column padded to 4 floats:
+ *                 Blocks[12 * b + 4 * c + r] is row r, column c of block b.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+
+#include "AlignedArray.h"
+#include "CpuFeatures.h"
+
+
+const unsigned int BLOCK_FLOATS = 12;
+const unsigned int VECTOR_STRIDE = 4;
+
+
+struct BlockSparseMatrix
+{
+    // Block row r is Columns / blocks [RowOffsets[r], RowOffsets[r + 1]), sorted by column.
+    std::vector<unsigned int> RowOffsets;
+    std::vector<unsigned int> Columns;
+    // Index of the diagonal block of every row.
+    std::vector<unsigned int> Diagonal;
+    AlignedArray<float> Blocks;
+
+    // Pattern of rowCount block rows with a diagonal block plus one block for each end of every
+    // (index1[e], index2[e]) pair. Duplicate pairs share their blocks.
+    void BuildPattern(unsigned int rowCount, const unsigned int *index1, const unsigned int *index2, unsigned int pairCount);
+    // Block (row, column), which must be in the pattern.
+    unsigned int FindBlock(unsigned int row, unsigned int column) const;
+    unsigned int GetRowCount() const;
+};
+
+
+// y = A x over block rows [begin, end).
+void MultiplyBlockRows(SimdLevel level, const BlockSparseMatrix &matrix, unsigned int begin, unsigned int end,
+                       const float *x, float *y);
+
+// y = block x for one block (12 floats) and one vector (4 floats).
+void MultiplyBlock(const float *block, const float *x, float *y);
+
+
+#endif // _BLOCKSPARSEMATRIX_H_
@@ -3,7 +3,7 @@
  * File Name     : ClothSimulation.cpp
  *
  * Creation Date : 09/24/2017
- * Last Modified : 12/12/2017 - 21:10
+ * Last Modified : 10/18/2026 - 11:00
  * ==========================================================================================
  * Description   : Largely based on the tutorials found here : https://learnopengl.com/
  *                 Other references used:
@@ -34,6 +34,9 @@
 #include "Shader.h"
 #include "Camera.h"
 #include "Model.h"
+#include "ClothSolver.h"
+#include "SimulationThread.h"
+#include "StateInterpolator.h"
 
 
 // CONSTANTS AND GLOBALS
@@ -44,10 +47,27 @@ const unsigned int SCREEN_HEIGHT = 720;
 
 const glm::vec3 WORLD_UP = glm::vec3(0.0f, 1.0f, 0.0f);
 
-const unsigned int SOLVER_ITERATIONS = 5;
-
-
-float LastTime = 0.0f;
+// The solver works in cloth space, which is placed in the world by CLOTH_POSITION. The ground
+// is drawn at GROUND_POSITION and collided with in cloth space, through both model matrices.
+const glm::vec3 CLOTH_POSITION = glm::vec3(0.0f, 2.95f, 4.0f);
+const glm::vec3 GROUND_POSITION = glm::vec3(0.0f, -4.0f, 0.0f);
+const float GROUND_FRICTION = 0.5f;
+
+// "Small steps": 5 substeps of usually 1 XPBD iteration each. Up to SOLVER_ITERATIONS when the
+// stretch goes above SOLVER_TOLERANCE, e.g. when the cloth is yanked around, as long as the
+// step fits in SOLVER_TIME_BUDGET milliseconds.
+const unsigned int SOLVER_ITERATIONS = 16;
+const unsigned int SOLVER_SUBSTEPS = 5;
+const float SOLVER_TOLERANCE = 1e-3f;
+const float SOLVER_TIME_BUDGET = 4.0f;
+// The display can run faster than this: frames in between are interpolated (I cycles the mode).
+const double SIMULATION_RATE = 60.0;
+const InterpolationMode DEFAULT_INTERPOLATION = INTERPOLATION_LINEAR;
+
+
+// NOTE(): Absolute time is kept in double: a float clock loses millisecond precision after a
+// few hours. Only the (small) frame delta is narrowed to float.
+double LastTime = 0.0;
 float DeltaTime = 0.0f;
 
 Camera camera(glm::vec3(0.0f, 5.0f, 10.0f));
@@ -63,6 +83,9 @@ bool FIsPressed = false;
 bool SimulationRunning = false;
 bool SpaceWasPressed = false;
 bool SpaceIsPressed = false;
+bool IWasPressed = false;
+bool IIsPressed = false;
+InterpolationMode Interpolation = DEFAULT_INTERPOLATION;
 bool UpdateNormals = true;
 
 
@@ -163,6 +186,7 @@ main()
 
     Model ground("../Assets/groundPlane.obj", glm::vec3(0.75f, 0.75f, 0.8f));
     Model cloth("../Assets/cloth.obj", glm::vec3(0.1f, 0.5f, 0.6f));
+    cloth.OptimizeLayout(VERTEX_ORDER_RCM);
 
 
     //
@@ -255,37 +279,29 @@ main()
     SHDR_ground.SetFloat("Shininess", 2.0f);
 
 
-    std::vector<glm::vec3> tentativePositions(cloth.Meshes[0].Vertices.size());
-    std::vector<glm::vec3> deltaPositions(cloth.Meshes[0].Vertices.size());
-    std::vector<unsigned int> neighborsIndices;
-
-    Mesh *mesh = &cloth.Meshes[0];
-
-    for (unsigned int index = 0; index < mesh->Vertices.size(); ++index)
-    {
-        float mass;
-
-        // Find closest fixed vertex
-        float minDist = 99999.9f;
-        unsigned int closestFixed;
-        for (unsigned int closest = 0; closest < cloth.TopRow.size(); ++closest)
-        {
-            float dist = glm::distance(mesh->Vertices[cloth.TopRow[closest]].Position, mesh->Vertices[index].Position);
-            if (dist < minDist)
-            {
-                minDist = dist;
-                closestFixed = closest;
-            }
-        }
+    //   Set up simulation
+    //   -----------------
 
-        // Mass relative to distance from closest fixed vertex.
-        // minDist will be 0 for fixed vertices => infinite inverse mass => they won't move.
-        mass = 50.0f / minDist;
+    glm::mat4 clothModel = glm::translate(glm::mat4(1.0f), CLOTH_POSITION);
+    glm::mat4 groundModel = glm::translate(glm::mat4(1.0f), GROUND_POSITION);
 
-        mesh->Masses.push_back(mass);
-        mesh->InvMasses.push_back(1.0f / mesh->Masses[index]);
-        mesh->Velocities.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
-    }
+    Mesh *mesh = &cloth.Meshes[0];
+    ClothSolver solver(*mesh, cloth.TopRow, SOLVER_ITERATIONS);
+    solver.SetSolverMode(SOLVER_XPBD);
+    solver.Substeps = SOLVER_SUBSTEPS;
+    solver.AdaptiveIterations = true;
+    solver.MinIterations = 1;
+    solver.Tolerance = SOLVER_TOLERANCE;
+    solver.TimeBudget = SOLVER_TIME_BUDGET;
+    solver.Tethers = true;
+    solver.GetColliders().Add(MakePlaneCollider(glm::inverse(clothModel) * groundModel, GROUND_FRICTION));
+    solver.GetColoring().PrintReport(std::cout);
+
+    // From here on the solver is only touched by the simulation thread.
+    SimulationThread simulation(&solver, SIMULATION_RATE);
+    simulation.SetPaused(!SimulationRunning);
+    simulation.Start();
+    StateInterpolator interpolator(&simulation, Interpolation);
 
 
     //
@@ -296,8 +312,8 @@ main()
     while (!glfwWindowShouldClose(window))
     {
         // Timing.
-        float currentTime = (float)glfwGetTime();
-        DeltaTime = currentTime - LastTime;
+        double currentTime = glfwGetTime();
+        DeltaTime = (float)(currentTime - LastTime);
         LastTime = currentTime;
 
         glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
@@ -323,7 +339,7 @@ main()
         SHDR_ground.Use();
         SHDR_ground.SetMat4("Projection", projection);
         SHDR_ground.SetMat4("View", view);
-        model = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -4.0f, 0.0f));
+        model = groundModel;
         normalMatrix = glm::transpose(glm::inverse(model));
         SHDR_ground.SetMat4("Model", model);
         SHDR_ground.SetMat4("NormalMatrix", normalMatrix);
@@ -335,64 +351,10 @@ main()
         // ----------
         //
 
-        if (SimulationRunning)
-        {
-            std::fill(tentativePositions.begin(), tentativePositions.end(), glm::vec3(0.0f, 0.0f, 0.0f));
-            std::fill(deltaPositions.begin(), deltaPositions.end(), glm::vec3(0.0f, 0.0f, 0.0f));
-
-            for (unsigned int index = 0; index < mesh->Vertices.size(); ++index)
-            {
-                if (std::find(cloth.TopRow.begin(), cloth.TopRow.end(), index) == cloth.TopRow.end())
-                {
-                    mesh->Velocities[index] += mesh->InvMasses[index] * glm::vec3(0.0f, -50.0f, 0.0f) * DeltaTime;
-                    tentativePositions[index] = mesh->Vertices[index].Position + mesh->Velocities[index] * DeltaTime;
-                }
-            }
-
-            // TODO(): Add collision detection.
-            //  (1) Find particles (any object) in a given radius
-            //  (2) Solve for collision
-
-            // TODO(): Add bending constraint.
-
-            // c.f. Unified Particle Physics paper Algorithm 3
-            for (unsigned int index = 0; index < SOLVER_ITERATIONS; ++index)
-            {
-                for (auto constraintIt = mesh->DistConstraints.begin();
-                     constraintIt != mesh->DistConstraints.end();
-                     ++constraintIt)
-                {
-                    constraintIt->Solve(mesh, &deltaPositions);
-                }
-            }
-
-            // Over-relaxation
-            for (unsigned int i = 0; i < mesh->Vertices.size(); ++i)
-            {
-                tentativePositions[i] += 2.0f/(float)mesh->ConstraintCount[i] * deltaPositions[i];
-            }
-
-            // Update velocities.
-            for (unsigned int index = 0; index < mesh->Vertices.size(); ++index)
-            {
-                if (std::find(cloth.TopRow.begin(), cloth.TopRow.end(), index) == cloth.TopRow.end())
-                {
-                    mesh->Velocities[index] = (tentativePositions[index] - mesh->Vertices[index].Position) * 1.0f / DeltaTime;
-                }
-            }
-
-            // Update positions.
-            for (unsigned int index = 0; index < mesh->Vertices.size(); ++index)
-            {
-                if (std::find(cloth.TopRow.begin(), cloth.TopRow.end(), index) == cloth.TopRow.end())
-                {
-                    if (glm::length(mesh->Velocities[index]) > 0.001f)
-                    {
-                        mesh->Vertices[index].Position = tentativePositions[index];
-                    }
-                }
-            }
-        }
+        // Stepped at a fixed rate on its own thread; here we only blend the last two states.
+        simulation.SetPaused(!SimulationRunning);
+        interpolator.Mode = Interpolation;
+        bool clothMoved = interpolator.Update(mesh);
 
 
         //
@@ -409,13 +371,16 @@ main()
             glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
         }
 
-        cloth.Update(UpdateNormals);
+        if (clothMoved)
+        {
+            cloth.Update(UpdateNormals);
+        }
 
 
         SHDR_basic.Use();
         SHDR_basic.SetMat4("Projection", projection);
         SHDR_basic.SetMat4("View", view);
-        model = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 2.95f, 4.0f));
+        model = clothModel;
         normalMatrix = glm::transpose(glm::inverse(model));
         SHDR_basic.SetMat4("Model", model);
         SHDR_basic.SetMat4("NormalMatrix", normalMatrix);
@@ -428,6 +393,8 @@ main()
     }
 
 
+    simulation.Stop();
+
     glfwTerminate();
     return 0;
 }
@@ -467,6 +434,14 @@ ProcessInput(GLFWwindow *window)
     {
         SpaceIsPressed = false;
     }
+    if (glfwGetKey(window, GLFW_KEY_I) == GLFW_PRESS)
+    {
+        IIsPressed = true;
+    }
+    if (glfwGetKey(window, GLFW_KEY_I) == GLFW_RELEASE)
+    {
+        IIsPressed = false;
+    }
     if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
     {
         camera.ProcessKeyboard(FORWARD, DeltaTime);
@@ -531,9 +506,16 @@ ProcessInput(GLFWwindow *window)
         }
     }
 
+    if (IIsPressed && !IWasPressed)
+    {
+        Interpolation = (InterpolationMode)((Interpolation + 1) % INTERPOLATION_MODE_COUNT);
+        std::cout << "Interpolation: " << GetInterpolationModeName(Interpolation) << std::endl;
+    }
+
     TabWasPressed = TabIsPressed;
     FWasPressed = FIsPressed;
     SpaceWasPressed = SpaceIsPressed;
+    IWasPressed = IIsPressed;
 }
 
 
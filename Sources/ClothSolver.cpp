@@ -0,0 +1,1108 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : ClothSolver.cpp
+ *
+ * Creation Date : 10/17/2026 - 09:12
+ * Last Modified : 10/18/2026 - 11:40
+ * ==========================================================================================
+ * Description   : References:
+ *                 (1) https://www.youtube.com/watch?v=b2An7OJJ-j0
+ *                     (lecture on Position-Based Dynamics from the University of Utah)
+ *
+ *                 (2) Macklin et al., "Unified Particle Physics for Real-Time Applications"
+ *
+ *                 (3) Wang, "A Chebyshev Semi-Iterative Approach for Accelerating Projective and
+ *                     Position-based Dynamics"
+ *
+ *                 (4) Macklin et al., "XPBD: Position-Based Simulation of Compliant Constrained
+ *                     Dynamics"
+ *
+ *                 (5) Macklin et al., "Small Steps in Physics Simulation"
+ *
+ *                 (6) Kim et al., "Long Range Attachments - A Method to Simulate Inextensible
+ *                     Clothing in Computer Games"
+ *
+ *                 (7) Mueller, "Hierarchical Position Based Dynamics"
+ *
+ *                 (8) Bouaziz et al., "Projective Dynamics: Fusing Constraint Projections for
+ *                     Fast Simulation"
+ *
+ *                 (9) Baraff, Witkin, "Large Steps in Cloth Simulation"
+ *
+ *                 (10) Chen et al., "Vertex Block Descent"
+ *
+ *                 (11) Bergou et al., "A Quadratic Bending Model for Inextensible Surfaces"
+ *
+ *                 (12) Mueller et al., "Strain Based Dynamics"
+ *
+ *                 (13) Bridson et al., "Robust Treatment of Collisions, Contact and Friction for
+ *                      Cloth Animation"
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+
+#include "ClothSolver.h"
+#include "Mesh.h"
+
+
+// PUBLIC METHODS
+// --------------
+
+// Below this many constraints (or particles) per thread, splitting a loop costs more than it saves.
+const unsigned int MIN_PARALLEL_CHUNK = 2048;
+
+// Coarse levels are fully projected: they only exist to remove large-scale stretch quickly, the
+// mesh iterations that follow give the material its actual stiffness.
+const float COARSE_STIFFNESS = 1.0f;
+const unsigned int MIN_COARSE_PARTICLES = 32;
+
+// Weight of the newest sample in the running cost averages.
+const float COST_SMOOTHING = 0.1f;
+
+const float PROJECTIVE_STIFFNESS = 1e6f;
+
+const float IMPLICIT_STIFFNESS = 1e5f;
+const float IMPLICIT_DAMPING = 10.0f;
+const unsigned int IMPLICIT_ITERATIONS = 100;
+const float IMPLICIT_TOLERANCE = 1e-4f;
+
+const float BLOCK_DESCENT_STIFFNESS = 1e6f;
+
+// Default Chebyshev spectral radius estimates. Block descent diverges above about 0.5.
+const float CHEBYSHEV_RHO = 0.9f;
+const float BLOCK_DESCENT_CHEBYSHEV_RHO = 0.4f;
+
+const float BENDING_STIFFNESS = 0.5f;
+const float BENDING_COMPLIANCE = 1e-3f;
+
+const glm::vec3 STRAIN_STIFFNESS = glm::vec3(1.0f, 1.0f, 0.5f);
+const glm::vec3 STRAIN_COMPLIANCE = glm::vec3(1e-7f, 1e-7f, 1e-6f);
+
+// Default thickness relative to the mean edge length, and search radius relative to thickness:
+// the margin catches pairs that only come into contact during the iterations.
+const float SELF_COLLISION_THICKNESS = 0.5f;
+const float SELF_COLLISION_SEARCH_SCALE = 1.5f;
+
+// Default substeps between hash searches, and skin relative to the mean edge length. The cache
+// is off by default: on folding cloth the particles move past half the skin too often for the
+// hits to pay for the longer searches.
+const unsigned int CONTACT_CACHE_INTERVAL = 1;
+const float CONTACT_CACHE_SKIN = 0.25f;
+
+// Default continuous collision thickness relative to the mean edge length.
+const float CONTINUOUS_THICKNESS = 0.1f;
+
+// Default collider thickness relative to the mean edge length.
+const float COLLIDER_THICKNESS = 0.1f;
+
+typedef std::chrono::steady_clock Clock;
+
+static inline float
+MillisecondsBetween(Clock::time_point start, Clock::time_point end)
+{
+    return std::chrono::duration<float, std::milli>(end - start).count();
+}
+
+
+ClothSolver::ClothSolver(const Mesh &mesh,
+                         const std::vector<unsigned int> &pinned,
+                         unsigned int iterations,
+                         unsigned int threadCount)
+{
+    Gravity = glm::vec3(0.0f, -50.0f, 0.0f);
+    Iterations = iterations;
+    Substeps = 1;
+    AdaptiveIterations = false;
+    MinIterations = 1;
+    Tolerance = 1e-3f;
+    TimeBudget = 0.0f;
+    Tethers = false;
+    TetherSlack = 1.0f;
+    CoarseIterations = 2;
+    Bending = false;
+    BendingStiffness = BENDING_STIFFNESS;
+    BendingCompliance = BENDING_COMPLIANCE;
+    Strain = false;
+    StrainStiffness = STRAIN_STIFFNESS;
+    StrainCompliance = STRAIN_COMPLIANCE;
+    SelfCollision = false;
+    ContactCacheInterval = CONTACT_CACHE_INTERVAL;
+    ContinuousCollision = false;
+    tethersDirty_ = true;
+    iterationCost_ = 0.0f;
+    substepOverhead_ = 0.0f;
+    ChebyshevAcceleration = false;
+    ChebyshevRho = CHEBYSHEV_RHO;
+    BlockDescentChebyshevRho = BLOCK_DESCENT_CHEBYSHEV_RHO;
+    ProjectiveStiffness = PROJECTIVE_STIFFNESS;
+    ImplicitStiffness = IMPLICIT_STIFFNESS;
+    ImplicitDamping = IMPLICIT_DAMPING;
+    ImplicitIterations = IMPLICIT_ITERATIONS;
+    ImplicitTolerance = IMPLICIT_TOLERANCE;
+    BlockDescentStiffness = BLOCK_DESCENT_STIFFNESS;
+
+    unsigned int vertexCount = (unsigned int)mesh.Vertices.size();
+
+    particles_.Resize(vertexCount);
+    for (unsigned int index = 0; index < vertexCount; ++index)
+    {
+        particles_.SetPosition(index, mesh.Vertices[index].Position);
+    }
+
+    previousX_.Resize(vertexCount);
+    previousY_.Resize(vertexCount);
+    previousZ_.Resize(vertexCount);
+    chebyshevOmega_ = 1.0f;
+
+    // Over-relaxation factor, c.f. Unified Particle Physics paper section 4.2.
+    relaxation_.Resize(vertexCount);
+    for (unsigned int index = 0; index < vertexCount; ++index)
+    {
+        unsigned int count = mesh.ConstraintCount[index];
+        relaxation_[index] = (count > 0) ? 2.0f / (float)count : 0.0f;
+    }
+
+    // Store constraints grouped by color so each color is a contiguous range for the kernels.
+    coloring_ = ColorConstraints(mesh.DistConstraints, vertexCount);
+    constraints_.reserve(mesh.DistConstraints.size());
+    constraintSlot_.resize(mesh.DistConstraints.size());
+    for (unsigned int index = 0; index < coloring_.Order.size(); ++index)
+    {
+        constraints_.push_back(mesh.DistConstraints[coloring_.Order[index]]);
+        constraintSlot_[coloring_.Order[index]] = index;
+    }
+
+    InitializeMasses(mesh, pinned);
+
+    pins_.Resize(vertexCount);
+    for (unsigned int index = 0; index < pinned.size(); ++index)
+    {
+        Pin(pinned[index]);
+    }
+
+    batch_.Build(constraints_, particles_);
+    corrections_.Resize(batch_.Count);
+    incidence_ = BuildVertexIncidence(constraints_, vertexCount);
+    VertexGraph graph = BuildVertexGraph(mesh.Neighbors, mesh.DistConstraints, vertexCount);
+    vertexColoring_ = ColorVertices(graph);
+    selfCollision_.Build(graph, vertexCount);
+    continuousCollision_.Build(mesh.Faces, vertexCount);
+    blockDescent_.Resize(vertexCount);
+
+    std::vector<EdgeStencil> stencils = BuildEdgeStencils(mesh.Faces);
+    std::vector<unsigned int> stencilVertices;
+    stencilVertices.reserve(stencils.size() * BENDING_STENCIL_SIZE);
+    for (auto stencilIt = stencils.begin(); stencilIt != stencils.end(); ++stencilIt)
+    {
+        unsigned int vertices[BENDING_STENCIL_SIZE] = { stencilIt->Vertex1, stencilIt->Vertex2, stencilIt->Opposite1, stencilIt->Opposite2 };
+        stencilVertices.insert(stencilVertices.end(), vertices, vertices + BENDING_STENCIL_SIZE);
+    }
+    std::vector<glm::vec3> restPositions(vertexCount);
+    std::vector<glm::vec2> texCoords(vertexCount);
+    for (unsigned int index = 0; index < vertexCount; ++index)
+    {
+        restPositions[index] = mesh.Vertices[index].Position;
+        texCoords[index] = mesh.Vertices[index].TexCoords;
+    }
+    bendingColoring_ = ColorStencils(stencilVertices, BENDING_STENCIL_SIZE, vertexCount);
+    bending_.Build(stencils, bendingColoring_.Order, restPositions);
+    bendingLambda_.Resize(3 * bending_.Count);
+
+    std::vector<unsigned int> triangleVertices;
+    triangleVertices.reserve(mesh.Faces.size() * STRAIN_STENCIL_SIZE);
+    for (auto faceIt = mesh.Faces.begin(); faceIt != mesh.Faces.end(); ++faceIt)
+    {
+        triangleVertices.insert(triangleVertices.end(), faceIt->Indices, faceIt->Indices + STRAIN_STENCIL_SIZE);
+    }
+    strainColoring_ = ColorStencils(triangleVertices, STRAIN_STENCIL_SIZE, vertexCount);
+    strain_.Build(mesh.Faces, strainColoring_.Order, restPositions, texCoords);
+    strainLambda_.Resize(strain_.Count * STRAIN_COMPONENT_COUNT);
+
+    float edgeLengthSum = 0.0f;
+    for (auto faceIt = mesh.Faces.begin(); faceIt != mesh.Faces.end(); ++faceIt)
+    {
+        for (unsigned int corner = 0; corner < 3; ++corner)
+        {
+            edgeLengthSum += glm::distance(restPositions[faceIt->Indices[corner]], restPositions[faceIt->Indices[(corner + 1) % 3]]);
+        }
+    }
+    float meanEdgeLength = mesh.Faces.empty() ? 0.0f : edgeLengthSum / (float)(mesh.Faces.size() * 3);
+    SelfCollisionThickness = SELF_COLLISION_THICKNESS * meanEdgeLength;
+    ContactCacheSkin = CONTACT_CACHE_SKIN * meanEdgeLength;
+    ContinuousThickness = CONTINUOUS_THICKNESS * meanEdgeLength;
+    ColliderThickness = COLLIDER_THICKNESS * meanEdgeLength;
+    constraintDeltaX_.Resize(batch_.Count);
+    constraintDeltaY_.Resize(batch_.Count);
+    constraintDeltaZ_.Resize(batch_.Count);
+    compliance_.Resize(batch_.Count);
+    compliance_.Fill(DISTANCE_COMPLIANCE);
+    lambda_.Resize(batch_.Count);
+    simdLevel_ = GetSupportedSimdLevel();
+    mode_ = SOLVER_JACOBI;
+    threadPool_.reset(new ThreadPool(threadCount));
+    chunkResiduals_.resize(threadPool_->GetThreadCount());
+}
+
+void
+ClothSolver::Step(float deltaTime)
+{
+    unsigned int substepCount = (Substeps > 0) ? Substeps : 1;
+    float timeStep = deltaTime / (float)substepCount;
+    bool budgeted = (TimeBudget > 0.0f);
+    unsigned int plannedIterations = budgeted ? PlanIterations(substepCount) : Iterations;
+    DistanceResidual residual;
+    float iterationTime = 0.0f;
+    float overheadTime = 0.0f;
+
+    if (Tethers && tethersDirty_)
+    {
+        tethers_.Build(batch_, incidence_, pins_, particles_);
+        tethersDirty_ = false;
+    }
+
+    stats_.Iterations = 0;
+    stats_.PlannedIterations = plannedIterations;
+    stats_.OverBudget = false;
+    stats_.Contacts = 0;
+    stats_.CollisionTime = 0.0f;
+    stats_.ColliderContacts = 0;
+    stats_.ColliderTime = 0.0f;
+    Clock::time_point stepStart = Clock::now();
+
+    bool positionBased = (mode_ == SOLVER_JACOBI) || (mode_ == SOLVER_GAUSS_SEIDEL) || (mode_ == SOLVER_XPBD);
+    bool bending = Bending && positionBased;
+    // The strain stretch joins the edge stretch in the residual, so the adaptive exit still
+    // works on a cloth with only triangles.
+    bool strain = Strain && positionBased;
+    unsigned int residualCount = batch_.Count + (strain ? strain_.Count : 0);
+
+    for (unsigned int substep = 0; substep < substepCount; ++substep)
+    {
+        // Each substep gets an equal share of the budget, measured from the start of the step so
+        // a slow substep eats into the next one's share rather than the frame.
+        Clock::time_point deadline = stepStart + std::chrono::microseconds(
+            (long long)(TimeBudget * 1000.0f * (float)(substep + 1) / (float)substepCount));
+        Clock::time_point substepStart = budgeted ? Clock::now() : stepStart;
+
+        if (mode_ == SOLVER_IMPLICIT_EULER)
+        {
+            residual = StepImplicit(timeStep);
+            continue;
+        }
+
+        Predict(timeStep);
+
+        // Before anything reads the prediction, so the solvers start from positions outside the
+        // colliders (and the inertia targets of PD and VBD are outside too).
+        bool colliders = (colliders_.GetCount() > 0);
+        if (colliders)
+        {
+            Clock::time_point colliderStart = Clock::now();
+            stats_.ColliderContacts = colliders_.Resolve(threadPool_.get(), simdLevel_, ColliderThickness, true, &particles_);
+            stats_.ColliderTime += MillisecondsBetween(colliderStart, Clock::now());
+        }
+
+        if (mode_ == SOLVER_PROJECTIVE_DYNAMICS)
+        {
+            projective_.Prepare(batch_, incidence_, particles_, timeStep, ProjectiveStiffness);
+            projective_.SetInertia(particles_);
+        }
+        else if (mode_ == SOLVER_BLOCK_DESCENT)
+        {
+            blockDescent_.InertiaX = particles_.PredictedX;
+            blockDescent_.InertiaY = particles_.PredictedY;
+            blockDescent_.InertiaZ = particles_.PredictedZ;
+        }
+
+        bool selfCollision = SelfCollision && (SelfCollisionThickness > 0.0f);
+        if (selfCollision)
+        {
+            Clock::time_point detectStart = Clock::now();
+            stats_.Contacts = selfCollision_.Detect(threadPool_.get(), particles_,
+                                                    SelfCollisionThickness * SELF_COLLISION_SEARCH_SCALE,
+                                                    ContactCacheSkin, ContactCacheInterval);
+            stats_.CollisionTime += MillisecondsBetween(detectStart, Clock::now());
+        }
+
+        if (hierarchy_.GetLevelCount() > 0)
+        {
+            SolveHierarchy();
+        }
+
+        if (mode_ == SOLVER_XPBD)
+        {
+            lambda_.Fill(0.0f);
+            bendingLambda_.Fill(0.0f);
+            strainLambda_.Fill(0.0f);
+        }
+        Clock::time_point iterationStart = budgeted ? Clock::now() : stepStart;
+        Clock::time_point iterationEnd = iterationStart;
+        for (unsigned int iteration = 0; iteration < plannedIterations; ++iteration)
+        {
+            switch (mode_)
+            {
+                case SOLVER_GAUSS_SEIDEL: SolveGaussSeidel(batch_, coloring_, DISTANCE_STIFFNESS); break;
+                case SOLVER_XPBD: SolveXpbd(timeStep); break;
+                case SOLVER_PROJECTIVE_DYNAMICS: SolveProjectiveDynamics(iteration); break;
+                case SOLVER_BLOCK_DESCENT: SolveBlockDescent(iteration, timeStep); break;
+                default: SolveJacobi(iteration); break;
+            }
+            if (strain)
+            {
+                SolveStrain(timeStep);
+            }
+            if (bending)
+            {
+                SolveBending(timeStep);
+            }
+            if (selfCollision)
+            {
+                selfCollision_.Solve(threadPool_.get(), SelfCollisionThickness, &particles_);
+            }
+            if (Tethers)
+            {
+                SolveTethers();
+            }
+
+            ++stats_.Iterations;
+            residual = MergeResiduals();
+            if (iteration + 1 < MinIterations)
+            {
+                continue;
+            }
+            if (AdaptiveIterations && (residual.Max <= Tolerance))
+            {
+                break;
+            }
+            if (budgeted && (iteration + 1 < plannedIterations))
+            {
+                iterationEnd = Clock::now();
+                if (iterationEnd >= deadline)
+                {
+                    stats_.OverBudget = true;
+                    break;
+                }
+            }
+        }
+
+        if (budgeted)
+        {
+            iterationEnd = Clock::now();
+            iterationTime += MillisecondsBetween(iterationStart, iterationEnd);
+            overheadTime += MillisecondsBetween(substepStart, iterationStart);
+        }
+
+        // Friction was applied once already: this pass only undoes what the constraints pushed
+        // back in.
+        if (colliders)
+        {
+            Clock::time_point colliderStart = Clock::now();
+            colliders_.Resolve(threadPool_.get(), simdLevel_, ColliderThickness, false, &particles_);
+            stats_.ColliderTime += MillisecondsBetween(colliderStart, Clock::now());
+        }
+
+        // Last, so nothing moves the particles back into a collision before the velocity update.
+        if (ContinuousCollision && (ContinuousThickness > 0.0f))
+        {
+            continuousCollision_.Step(threadPool_.get(), ContinuousThickness, &particles_);
+        }
+
+        UpdateVelocities(timeStep);
+
+        if (budgeted)
+        {
+            overheadTime += MillisecondsBetween(iterationEnd, Clock::now());
+        }
+    }
+
+    stats_.MaxResidual = residual.Max;
+    stats_.RmsResidual = (residualCount > 0) ? (float)sqrt(residual.SumSquares / (double)residualCount) : 0.0f;
+    stats_.StepTime = MillisecondsBetween(stepStart, Clock::now());
+
+    // Update the cost model; the first sample replaces the initial guess outright.
+    if (budgeted && (stats_.Iterations > 0))
+    {
+        float iterationSample = iterationTime / (float)stats_.Iterations;
+        float overheadSample = overheadTime / (float)substepCount;
+        float weight = (iterationCost_ > 0.0f) ? COST_SMOOTHING : 1.0f;
+        iterationCost_ += weight * (iterationSample - iterationCost_);
+        substepOverhead_ += weight * (overheadSample - substepOverhead_);
+    }
+}
+
+void
+ClothSolver::WriteTo(Mesh *mesh) const
+{
+    // The only place the solver touches the interleaved Vertex data: once per frame.
+    unsigned int count = particles_.GetCount();
+    for (unsigned int index = 0; index < count; ++index)
+    {
+        mesh->Vertices[index].Position = particles_.GetPosition(index);
+    }
+}
+
+bool
+ClothSolver::Pin(unsigned int index)
+{
+    if (!pins_.Add(index))
+    {
+        return false;
+    }
+
+    particles_.InvMass[index] = 0.0f;
+    particles_.VelocityX[index] = 0.0f;
+    particles_.VelocityY[index] = 0.0f;
+    particles_.VelocityZ[index] = 0.0f;
+    batch_.UpdateWeights(particles_);
+    hierarchy_.UpdateWeights(particles_);
+    projective_.Invalidate();
+    selfCollision_.InvalidateCache();
+    tethersDirty_ = true;
+
+    return true;
+}
+
+bool
+ClothSolver::Unpin(unsigned int index)
+{
+    if (!pins_.Remove(index))
+    {
+        return false;
+    }
+
+    particles_.InvMass[index] = baseInvMass_[index];
+    batch_.UpdateWeights(particles_);
+    hierarchy_.UpdateWeights(particles_);
+    projective_.Invalidate();
+    selfCollision_.InvalidateCache();
+    tethersDirty_ = true;
+
+    return true;
+}
+
+bool
+ClothSolver::IsPinned(unsigned int index) const
+{
+    return pins_.Contains(index);
+}
+
+void
+ClothSolver::MovePin(unsigned int index, const glm::vec3 &position)
+{
+    if (pins_.Contains(index))
+    {
+        particles_.SetPosition(index, position);
+    }
+}
+
+const PinSet &
+ClothSolver::GetPins() const
+{
+    return pins_;
+}
+
+void
+ClothSolver::SetSimdLevel(SimdLevel level)
+{
+    simdLevel_ = (level < GetSupportedSimdLevel()) ? level : GetSupportedSimdLevel();
+}
+
+SimdLevel
+ClothSolver::GetSimdLevel() const
+{
+    return simdLevel_;
+}
+
+float
+ClothSolver::VerifyKernel(SimdLevel level) const
+{
+    SimdLevel clamped = (level < GetSupportedSimdLevel()) ? level : GetSupportedSimdLevel();
+    return CompareDistanceKernel(clamped, constraints_, batch_, particles_);
+}
+
+void
+ClothSolver::SetCompliance(float compliance)
+{
+    compliance_.Fill(compliance);
+}
+
+void
+ClothSolver::SetConstraintCompliance(unsigned int constraint, float compliance)
+{
+    compliance_[constraintSlot_[constraint]] = compliance;
+}
+
+void
+ClothSolver::SetHierarchyLevels(unsigned int levelCount)
+{
+    hierarchy_.Build(constraints_, particles_, levelCount, MIN_COARSE_PARTICLES);
+
+    unsigned int correctionCount = batch_.Count;
+    for (auto levelIt = hierarchy_.Levels.begin(); levelIt != hierarchy_.Levels.end(); ++levelIt)
+    {
+        correctionCount = std::max(correctionCount, levelIt->Batch.Count);
+    }
+    corrections_.Resize(correctionCount);
+
+    unsigned int count = (hierarchy_.GetLevelCount() > 0) ? particles_.GetCount() : 0;
+    coarseStartX_.Resize(count);
+    coarseStartY_.Resize(count);
+    coarseStartZ_.Resize(count);
+}
+
+const ParticleHierarchy &
+ClothSolver::GetHierarchy() const
+{
+    return hierarchy_;
+}
+
+const ProjectiveDynamicsSystem &
+ClothSolver::GetProjectiveDynamics() const
+{
+    return projective_;
+}
+
+void
+ClothSolver::SetSolverMode(SolverMode mode)
+{
+    mode_ = mode;
+}
+
+SolverMode
+ClothSolver::GetSolverMode() const
+{
+    return mode_;
+}
+
+void
+ClothSolver::SetThreadCount(unsigned int threadCount)
+{
+    threadPool_.reset(new ThreadPool(threadCount));
+    chunkResiduals_.resize(threadPool_->GetThreadCount());
+}
+
+unsigned int
+ClothSolver::GetThreadCount() const
+{
+    return threadPool_->GetThreadCount();
+}
+
+const ConstraintColoring &
+ClothSolver::GetColoring() const
+{
+    return coloring_;
+}
+
+const ConstraintColoring &
+ClothSolver::GetVertexColoring() const
+{
+    return vertexColoring_;
+}
+
+const ConstraintColoring &
+ClothSolver::GetTriangleColoring() const
+{
+    return strainColoring_;
+}
+
+const SolverStats &
+ClothSolver::GetLastStepStats() const
+{
+    return stats_;
+}
+
+const ContinuousCollisionSystem &
+ClothSolver::GetContinuousCollision() const
+{
+    return continuousCollision_;
+}
+
+const SelfCollisionSystem &
+ClothSolver::GetSelfCollision() const
+{
+    return selfCollision_;
+}
+
+ColliderSet &
+ClothSolver::GetColliders()
+{
+    return colliders_;
+}
+
+const ColliderSet &
+ClothSolver::GetColliders() const
+{
+    return colliders_;
+}
+
+unsigned int
+ClothSolver::GetTetherCount() const
+{
+    return tethers_.Count;
+}
+
+unsigned int
+ClothSolver::GetVertexCount() const
+{
+    return particles_.GetCount();
+}
+
+const ParticleStore &
+ClothSolver::GetParticles() const
+{
+    return particles_;
+}
+
+
+// PRIVATE METHODS
+// ---------------
+
+void
+ClothSolver::InitializeMasses(const Mesh &mesh, const std::vector<unsigned int> &pinned)
+{
+    unsigned int count = particles_.GetCount();
+
+    // Pinned vertices are 0 away from the closest fixed vertex, which would give them an
+    // infinite mass. Clamp to the shortest edge so they get a sensible mass if unpinned later.
+    // The triangle edges count too, for a mesh built without distance constraints (see Strain).
+    float shortestEdge = 99999.9f;
+    for (auto constraintIt = constraints_.begin(); constraintIt != constraints_.end(); ++constraintIt)
+    {
+        if (constraintIt->RestLength > 0.0f)
+        {
+            shortestEdge = std::min(shortestEdge, constraintIt->RestLength);
+        }
+    }
+    for (auto faceIt = mesh.Faces.begin(); faceIt != mesh.Faces.end(); ++faceIt)
+    {
+        for (unsigned int corner = 0; corner < 3; ++corner)
+        {
+            float length = glm::distance(mesh.Vertices[faceIt->Indices[corner]].Position,
+                                         mesh.Vertices[faceIt->Indices[(corner + 1) % 3]].Position);
+            if (length > 0.0f)
+            {
+                shortestEdge = std::min(shortestEdge, length);
+            }
+        }
+    }
+
+    baseInvMass_.Resize(count);
+    for (unsigned int index = 0; index < count; ++index)
+    {
+        glm::vec3 position = particles_.GetPosition(index);
+
+        // Find closest fixed vertex
+        float minDist = 99999.9f;
+        for (unsigned int closest = 0; closest < pinned.size(); ++closest)
+        {
+            float dist = glm::distance(particles_.GetPosition(pinned[closest]), position);
+            if (dist < minDist)
+            {
+                minDist = dist;
+            }
+        }
+
+        // Mass relative to distance from closest fixed vertex.
+        float mass = 50.0f / std::max(minDist, shortestEdge);
+        baseInvMass_[index] = 1.0f / mass;
+        particles_.InvMass[index] = baseInvMass_[index];
+    }
+}
+
+void
+ClothSolver::Predict(float timeStep)
+{
+    unsigned int count = particles_.GetCount();
+    const float *x = particles_.X.Data();
+    const float *y = particles_.Y.Data();
+    const float *z = particles_.Z.Data();
+    float *px = particles_.PredictedX.Data();
+    float *py = particles_.PredictedY.Data();
+    float *pz = particles_.PredictedZ.Data();
+    float *vx = particles_.VelocityX.Data();
+    float *vy = particles_.VelocityY.Data();
+    float *vz = particles_.VelocityZ.Data();
+    const float *w = particles_.InvMass.Data();
+
+    // Pinned particles have a zero inverse mass and velocity, so nothing below needs to know
+    // about pins: they predict their own position and every correction they get is scaled to 0.
+    for (unsigned int index = 0; index < count; ++index)
+    {
+        vx[index] += w[index] * Gravity.x * timeStep;
+        vy[index] += w[index] * Gravity.y * timeStep;
+        vz[index] += w[index] * Gravity.z * timeStep;
+        px[index] = x[index] + vx[index] * timeStep;
+        py[index] = y[index] + vy[index] * timeStep;
+        pz[index] = z[index] + vz[index] * timeStep;
+    }
+}
+
+void
+ClothSolver::UpdateVelocities(float timeStep)
+{
+    unsigned int count = particles_.GetCount();
+    float *x = particles_.X.Data();
+    float *y = particles_.Y.Data();
+    float *z = particles_.Z.Data();
+    const float *px = particles_.PredictedX.Data();
+    const float *py = particles_.PredictedY.Data();
+    const float *pz = particles_.PredictedZ.Data();
+    float *vx = particles_.VelocityX.Data();
+    float *vy = particles_.VelocityY.Data();
+    float *vz = particles_.VelocityZ.Data();
+
+    float inverseTimeStep = 1.0f / timeStep;
+    for (unsigned int index = 0; index < count; ++index)
+    {
+        vx[index] = (px[index] - x[index]) * inverseTimeStep;
+        vy[index] = (py[index] - y[index]) * inverseTimeStep;
+        vz[index] = (pz[index] - z[index]) * inverseTimeStep;
+
+        // Particles slower than the threshold stay put. Written as a blend so it compiles to a
+        // select rather than a branch.
+        float speedSquared = vx[index]*vx[index] + vy[index]*vy[index] + vz[index]*vz[index];
+        float moving = (speedSquared > 0.001f*0.001f) ? 1.0f : 0.0f;
+        x[index] += moving * (px[index] - x[index]);
+        y[index] += moving * (py[index] - y[index]);
+        z[index] += moving * (pz[index] - z[index]);
+    }
+}
+
+// Iterations per substep that fit in TimeBudget according to the cost model, within
+// [MinIterations, Iterations]. Without a cost estimate yet, the first step runs Iterations.
+unsigned int
+ClothSolver::PlanIterations(unsigned int substepCount) const
+{
+    if (iterationCost_ <= 0.0f)
+    {
+        return Iterations;
+    }
+
+    float available = TimeBudget / (float)substepCount - substepOverhead_;
+    unsigned int fit = (available > 0.0f) ? (unsigned int)(available / iterationCost_) : 0;
+    fit = std::min(fit, Iterations);
+    return std::max(fit, std::min(MinIterations, Iterations));
+}
+
+// Merges in chunk order and resets the chunks for the next iteration.
+DistanceResidual
+ClothSolver::MergeResiduals()
+{
+    DistanceResidual residual;
+    for (auto chunkIt = chunkResiduals_.begin(); chunkIt != chunkResiduals_.end(); ++chunkIt)
+    {
+        residual.Merge(*chunkIt);
+        chunkIt->Reset();
+    }
+    return residual;
+}
+
+// c.f. Unified Particle Physics paper Algorithm 3
+// Every constraint is projected against the same predicted positions, then each vertex applies
+// the averaged (over-relaxed) sum of its constraints' corrections.
+// Both passes only write data owned by their chunk, and each vertex sums its constraints in a
+// fixed order, so the result does not depend on the thread count.
+void
+ClothSolver::SolveJacobi(unsigned int iteration)
+{
+    float *px = particles_.PredictedX.Data();
+    float *py = particles_.PredictedY.Data();
+    float *pz = particles_.PredictedZ.Data();
+    const float *w = particles_.InvMass.Data();
+    float *cx = constraintDeltaX_.Data();
+    float *cy = constraintDeltaY_.Data();
+    float *cz = constraintDeltaZ_.Data();
+
+    threadPool_->ParallelFor(0, batch_.Count, MIN_PARALLEL_CHUNK,
+        [&](unsigned int begin, unsigned int end, unsigned int chunk)
+        {
+            for (unsigned int constraint = begin; constraint < end; ++constraint)
+            {
+                cx[constraint] = 0.0f;
+                cy[constraint] = 0.0f;
+                cz[constraint] = 0.0f;
+            }
+
+            unsigned int activeCount = SolveDistanceConstraints(simdLevel_, batch_, begin, end, particles_,
+                                                                DISTANCE_STIFFNESS, &corrections_);
+            for (unsigned int entry = begin; entry < begin + activeCount; ++entry)
+            {
+                unsigned int constraint = corrections_.Constraint[entry];
+                cx[constraint] = corrections_.X[entry];
+                cy[constraint] = corrections_.Y[entry];
+                cz[constraint] = corrections_.Z[entry];
+            }
+            MeasureDistanceResidual(batch_, corrections_, begin, activeCount, DISTANCE_STIFFNESS, &chunkResiduals_[chunk]);
+        });
+
+    float omega = GetChebyshevOmega(iteration);
+
+    threadPool_->ParallelFor(0, particles_.GetCount(), MIN_PARALLEL_CHUNK,
+        [&](unsigned int begin, unsigned int end, unsigned int)
+        {
+            for (unsigned int vertex = begin; vertex < end; ++vertex)
+            {
+                float dx = 0.0f;
+                float dy = 0.0f;
+                float dz = 0.0f;
+                for (unsigned int slot = incidence_.Offsets[vertex]; slot < incidence_.Offsets[vertex + 1]; ++slot)
+                {
+                    unsigned int constraint = incidence_.Constraints[slot];
+                    float sign = incidence_.Signs[slot];
+                    dx += sign * cx[constraint];
+                    dy += sign * cy[constraint];
+                    dz += sign * cz[constraint];
+                }
+
+                float scale = relaxation_[vertex] * w[vertex];
+                float x = px[vertex] + scale * dx;
+                float y = py[vertex] + scale * dy;
+                float z = pz[vertex] + scale * dz;
+
+                // q_k+1 = omega (q^_k+1 - q_k-1) + q_k-1, with q^ the plain Jacobi iterate.
+                if (omega != 1.0f)
+                {
+                    x = omega * (x - previousX_[vertex]) + previousX_[vertex];
+                    y = omega * (y - previousY_[vertex]) + previousY_[vertex];
+                    z = omega * (z - previousZ_[vertex]) + previousZ_[vertex];
+                }
+
+                previousX_[vertex] = px[vertex];
+                previousY_[vertex] = py[vertex];
+                previousZ_[vertex] = pz[vertex];
+                px[vertex] = x;
+                py[vertex] = y;
+                pz[vertex] = z;
+            }
+        });
+}
+
+// Chebyshev weights: omega_1 = 1, omega_2 = 2 / (2 - rho^2), omega_k+1 = 4 / (4 - rho^2 omega_k).
+float
+ClothSolver::GetChebyshevOmega(unsigned int iteration)
+{
+    float omega = 1.0f;
+    if (ChebyshevAcceleration && (iteration > 0))
+    {
+        float rho = (mode_ == SOLVER_BLOCK_DESCENT) ? BlockDescentChebyshevRho : ChebyshevRho;
+        float rhoSquared = rho * rho;
+        omega = (iteration == 1) ? 2.0f / (2.0f - rhoSquared) : 4.0f / (4.0f - rhoSquared * chebyshevOmega_);
+    }
+    chebyshevOmega_ = omega;
+    return omega;
+}
+
+// Constraints of one color share no vertex, so a color is split across threads and every
+// chunk writes its corrections straight into the predicted positions: no atomics, no locks.
+// Colors are processed in order, which keeps the result independent of the thread count.
+void
+ClothSolver::SolveGaussSeidel(const DistanceConstraintBatch &batch, const ConstraintColoring &coloring, float stiffness)
+{
+    float *px = particles_.PredictedX.Data();
+    float *py = particles_.PredictedY.Data();
+    float *pz = particles_.PredictedZ.Data();
+
+    for (unsigned int color = 0; color < coloring.GetColorCount(); ++color)
+    {
+        threadPool_->ParallelFor(coloring.Offsets[color], coloring.Offsets[color + 1], MIN_PARALLEL_CHUNK,
+            [&](unsigned int begin, unsigned int end, unsigned int chunk)
+            {
+                unsigned int activeCount = SolveDistanceConstraints(simdLevel_, batch, begin, end, particles_,
+                                                                    stiffness, &corrections_);
+                MeasureDistanceResidual(batch, corrections_, begin, activeCount, stiffness, &chunkResiduals_[chunk]);
+                ScatterDistanceCorrections(batch, corrections_, begin, activeCount, particles_, px, py, pz);
+            });
+    }
+}
+
+// Coarsest level first. A particle dropped by level l is on no coarser level either, so it has
+// not moved yet when it is handed the weighted motion of its parents since the pass started.
+void
+ClothSolver::SolveHierarchy()
+{
+    float *px = particles_.PredictedX.Data();
+    float *py = particles_.PredictedY.Data();
+    float *pz = particles_.PredictedZ.Data();
+
+    coarseStartX_ = particles_.PredictedX;
+    coarseStartY_ = particles_.PredictedY;
+    coarseStartZ_ = particles_.PredictedZ;
+
+    for (auto levelIt = hierarchy_.Levels.begin(); levelIt != hierarchy_.Levels.end(); ++levelIt)
+    {
+        const HierarchyLevel &level = *levelIt;
+        for (unsigned int iteration = 0; iteration < CoarseIterations; ++iteration)
+        {
+            SolveGaussSeidel(level.Batch, level.Coloring, COARSE_STIFFNESS);
+        }
+
+        threadPool_->ParallelFor(0, (unsigned int)level.FineParticles.size(), MIN_PARALLEL_CHUNK,
+            [&](unsigned int begin, unsigned int end, unsigned int)
+            {
+                for (unsigned int fine = begin; fine < end; ++fine)
+                {
+                    float dx = 0.0f;
+                    float dy = 0.0f;
+                    float dz = 0.0f;
+                    for (unsigned int slot = level.ParentOffsets[fine]; slot < level.ParentOffsets[fine + 1]; ++slot)
+                    {
+                        unsigned int parent = level.Parents[slot];
+                        float weight = level.ParentWeights[slot];
+                        dx += weight * (px[parent] - coarseStartX_[parent]);
+                        dy += weight * (py[parent] - coarseStartY_[parent]);
+                        dz += weight * (pz[parent] - coarseStartZ_[parent]);
+                    }
+
+                    // Pinned particles stay where they are.
+                    unsigned int particle = level.FineParticles[fine];
+                    float free = (particles_.InvMass[particle] > 0.0f) ? 1.0f : 0.0f;
+                    px[particle] += free * dx;
+                    py[particle] += free * dy;
+                    pz[particle] += free * dz;
+                }
+            });
+    }
+
+    // The coarse residuals are not the mesh's.
+    MergeResiduals();
+}
+
+// Same color-by-color traversal as SolveGaussSeidel(); each constraint owns its multiplier, so
+// the chunks of a color still share nothing.
+void
+ClothSolver::SolveXpbd(float timeStep)
+{
+    for (unsigned int color = 0; color < coloring_.GetColorCount(); ++color)
+    {
+        threadPool_->ParallelFor(coloring_.Offsets[color], coloring_.Offsets[color + 1], MIN_PARALLEL_CHUNK,
+            [&](unsigned int begin, unsigned int end, unsigned int chunk)
+            {
+                SolveDistanceConstraintsXpbd(batch_, begin, end, compliance_.Data(), timeStep, &particles_, lambda_.Data(),
+                                             &chunkResiduals_[chunk]);
+            });
+    }
+}
+
+// One color at a time, like SolveGaussSeidel(); stencils of a color share no vertex.
+void
+ClothSolver::SolveBending(float timeStep)
+{
+    bool xpbd = (mode_ == SOLVER_XPBD);
+    float stiffness = xpbd ? 1.0f : BendingStiffness;
+    float compliance = xpbd ? BendingCompliance / (timeStep * timeStep) : 0.0f;
+    float *lambda = xpbd ? bendingLambda_.Data() : nullptr;
+
+    for (unsigned int color = 0; color < bendingColoring_.GetColorCount(); ++color)
+    {
+        threadPool_->ParallelFor(bendingColoring_.Offsets[color], bendingColoring_.Offsets[color + 1], MIN_PARALLEL_CHUNK,
+            [&](unsigned int begin, unsigned int end, unsigned int)
+            {
+                SolveBendingConstraints(simdLevel_, bending_, begin, end, stiffness, compliance, lambda, &particles_);
+            });
+    }
+}
+
+// Same as SolveBending(); the per-area compliance is divided by each triangle's area in the kernel.
+void
+ClothSolver::SolveStrain(float timeStep)
+{
+    bool xpbd = (mode_ == SOLVER_XPBD);
+    float stiffness[STRAIN_COMPONENT_COUNT] = { StrainStiffness.x, StrainStiffness.y, StrainStiffness.z };
+    float compliance[STRAIN_COMPONENT_COUNT];
+    for (unsigned int component = 0; component < STRAIN_COMPONENT_COUNT; ++component)
+    {
+        compliance[component] = StrainCompliance[component] / (timeStep * timeStep);
+        stiffness[component] = xpbd ? 1.0f : stiffness[component];
+    }
+    float *lambda = xpbd ? strainLambda_.Data() : nullptr;
+
+    for (unsigned int color = 0; color < strainColoring_.GetColorCount(); ++color)
+    {
+        threadPool_->ParallelFor(strainColoring_.Offsets[color], strainColoring_.Offsets[color + 1], MIN_PARALLEL_CHUNK,
+            [&](unsigned int begin, unsigned int end, unsigned int chunk)
+            {
+                SolveStrainConstraints(simdLevel_, strain_, begin, end, stiffness, compliance, lambda, &particles_,
+                                       &chunkResiduals_[chunk]);
+            });
+    }
+}
+
+void
+ClothSolver::SolveTethers()
+{
+    threadPool_->ParallelFor(0, tethers_.Count, MIN_PARALLEL_CHUNK,
+        [&](unsigned int begin, unsigned int end, unsigned int)
+        {
+            ::SolveTethers(tethers_, begin, end, TetherSlack, &particles_);
+        });
+}
+
+// Local steps in parallel over the constraints, then the right-hand side in parallel over the
+// particles, then the back-substitution. Falls back to Jacobi iterations if the system could not
+// be factored.
+void
+ClothSolver::SolveProjectiveDynamics(unsigned int iteration)
+{
+    if (!projective_.IsFactored())
+    {
+        SolveJacobi(iteration);
+        return;
+    }
+
+    threadPool_->ParallelFor(0, batch_.Count, MIN_PARALLEL_CHUNK,
+        [&](unsigned int begin, unsigned int end, unsigned int chunk)
+        {
+            projective_.Project(batch_, begin, end, particles_, &chunkResiduals_[chunk]);
+        });
+
+    threadPool_->ParallelFor(0, projective_.GetUnknownCount(), MIN_PARALLEL_CHUNK,
+        [&](unsigned int begin, unsigned int end, unsigned int)
+        {
+            projective_.Gather(batch_, incidence_, begin, end, particles_);
+        });
+
+    projective_.Solve(&particles_);
+}
+
+// Stats count the conjugate gradient iterations.
+DistanceResidual
+ClothSolver::StepImplicit(float timeStep)
+{
+    if (!implicit_.IsBuilt())
+    {
+        implicit_.Build(batch_, incidence_, particles_.GetCount());
+    }
+
+    ImplicitEulerSettings settings;
+    settings.Stiffness = ImplicitStiffness;
+    settings.Damping = ImplicitDamping;
+    settings.Gravity = Gravity;
+    settings.MaxIterations = ImplicitIterations;
+    settings.Tolerance = ImplicitTolerance;
+
+    stats_.Iterations += implicit_.Step(threadPool_.get(), simdLevel_, batch_, incidence_, settings, timeStep, &particles_,
+                                        &chunkResiduals_);
+    return MergeResiduals();
+}
+
+// Colors in order, each split across threads. A vertex only reads its neighbors, none of which
+// is in its color, so the result does not depend on the thread count.
+void
+ClothSolver::SolveBlockDescent(unsigned int iteration, float timeStep)
+{
+    float omega = GetChebyshevOmega(iteration);
+
+    for (unsigned int color = 0; color < vertexColoring_.GetColorCount(); ++color)
+    {
+        threadPool_->ParallelFor(vertexColoring_.Offsets[color], vertexColoring_.Offsets[color + 1], MIN_PARALLEL_CHUNK,
+            [&](unsigned int begin, unsigned int end, unsigned int chunk)
+            {
+                SolveVertexBlockDescent(vertexColoring_.Order.data(), begin, end, batch_, incidence_, BlockDescentStiffness,
+                                        timeStep, omega, &blockDescent_, &particles_, &chunkResiduals_[chunk]);
+            });
+    }
+}
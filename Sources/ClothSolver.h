@@ -0,0 +1,313 @@
+#ifndef _CLOTHSOLVER_H_
+#define _CLOTHSOLVER_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : ClothSolver.h
+ *
+ * Creation Date : 10/17/2026 - 09:12
+ * Last Modified : 10/18/2026 - 11:40
+ * ==========================================================================================
+ * Description   : Position-Based Dynamics solver for a single cloth mesh.
+ *                 Owns the particle state and does not touch OpenGL or GLFW, so it can be
+ *                 stepped headless (see Headless/ClothHeadless.cpp).
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+#include <memory>
+#include "glm/glm.hpp"
+
+#include "DistanceConstraint.h"
+#include "DistanceKernels.h"
+#include "ParticleStore.h"
+#include "PinSet.h"
+#include "ConstraintColoring.h"
+#include "VertexIncidence.h"
+#include "ThreadPool.h"
+#include "Tethers.h"
+#include "ParticleHierarchy.h"
+#include "ProjectiveDynamics.h"
+#include "ImplicitEuler.h"
+#include "VertexGraph.h"
+#include "BlockDescent.h"
+#include "BendingConstraints.h"
+#include "StrainConstraints.h"
+#include "SelfCollision.h"
+#include "ContinuousCollision.h"
+#include "Colliders.h"
+
+
+class Mesh;
+
+
+enum SolverMode : unsigned char
+{
+    // All constraints projected against the same positions, then each vertex gathers and
+    // averages the corrections of its constraints. Parallel over constraints, then vertices.
+    SOLVER_JACOBI,
+    // Constraints projected in place one color at a time, each color in parallel.
+    SOLVER_GAUSS_SEIDEL,
+    // Extended PBD: Gauss-Seidel over colors with per-constraint compliance and Lagrange
+    // multipliers, so stiffness no longer depends on Iterations or the time step. Best used
+    // with several Substeps of one iteration each.
+    SOLVER_XPBD,
+    // Projective Dynamics: every iteration projects each constraint on its rest length (in
+    // parallel) and then solves the global system M / h^2 + k L, prefactored once, by
+    // back-substitution. Pinning or unpinning refactors it on the next Step().
+    SOLVER_PROJECTIVE_DYNAMICS,
+    // Backward Euler on springs made from the constraints, solved with conjugate gradient.
+    // Stable at any time step. Iterations, tethers and coarse levels do not apply; see the
+    // Implicit* settings instead.
+    SOLVER_IMPLICIT_EULER,
+    // Vertex Block Descent: every iteration sweeps the vertex colors, each vertex taking a
+    // Newton step on its inertia and incident springs, one color in parallel. Chebyshev
+    // acceleration applies as for SOLVER_JACOBI, with BlockDescentChebyshevRho: it diverges
+    // above about 0.5.
+    SOLVER_BLOCK_DESCENT
+};
+
+
+struct SolverStats
+{
+    // Iterations actually run, over all the substeps of the last Step().
+    unsigned int Iterations = 0;
+    // Relative stretch of the constraints, and of the triangles with Strain, measured during the
+    // last iteration (see DistanceResidual).
+    float MaxResidual = 0.0f;
+    float RmsResidual = 0.0f;
+    // Iterations per substep the time budget allowed (Iterations when there is no budget), and
+    // the wall-clock time Step() took in milliseconds.
+    unsigned int PlannedIterations = 0;
+    float StepTime = 0.0f;
+    // True when an iteration was cut short by the budget deadline.
+    bool OverBudget = false;
+    // Self-collision pairs found in the last substep, and the time spent finding them over the
+    // whole step in milliseconds.
+    unsigned int Contacts = 0;
+    float CollisionTime = 0.0f;
+    // Particle-collider contacts found right after the last prediction, and the time spent
+    // resolving the colliders over the whole step in milliseconds.
+    unsigned int ColliderContacts = 0;
+    float ColliderTime = 0.0f;
+};
+
+
+class ClothSolver
+{
+
+public:
+    glm::vec3 Gravity;
+    unsigned int Iterations;
+    // Each Step() is split into this many substeps, each with its own prediction, Iterations
+    // solver iterations and velocity update. Many substeps of 1 iteration converge much better
+    // than 1 step of many iterations for the same cost.
+    unsigned int Substeps;
+    // Adaptive iteration count: each substep stops iterating as soon as the largest relative
+    // stretch is below Tolerance, after at least MinIterations and at most Iterations. The
+    // test is on the max, which does not depend on summation order, so where it stops does
+    // not depend on the thread count either.
+    bool AdaptiveIterations;
+    unsigned int MinIterations;
+    float Tolerance;
+    // Wall-clock budget of one Step() in milliseconds, 0 for none. With a budget, the iteration
+    // count per substep is planned from a running estimate of the cost of an iteration (up to
+    // Iterations), and a substep that runs past its share of the budget stops iterating (after
+    // MinIterations). Whatever stretch is left is carried over to the next step.
+    float TimeBudget;
+    // Long-range attachments: after every iteration, free particles are pulled back within
+    // TetherSlack times their rest geodesic distance to the nearest pin.
+    bool Tethers;
+    float TetherSlack;
+    // Quadratic isometric bending on every interior edge, projected after the distance
+    // constraints in the position-based modes (Jacobi, Gauss-Seidel, XPBD). BendingStiffness
+    // scales the PBD corrections; XPBD uses BendingCompliance instead.
+    bool Bending;
+    float BendingStiffness;
+    float BendingCompliance;
+    // Continuum stretch and shear on every triangle (see StrainConstraints.h), projected after
+    // the distance constraints in the same modes as Bending. Warp, weft and shear in x, y, z:
+    // StrainStiffness scales the PBD corrections, XPBD uses StrainCompliance (per unit area)
+    // instead. The triangles cover shear too, so the mesh only needs structural edges, or none.
+    bool Strain;
+    glm::vec3 StrainStiffness;
+    glm::vec3 StrainCompliance;
+    // Particle self-collision (see SelfCollision.h) in every mode but SOLVER_IMPLICIT_EULER:
+    // particles that are not neighbors in the mesh are kept SelfCollisionThickness apart.
+    // Defaults to half the mean edge length; much more and particles two edges apart collide
+    // at rest.
+    bool SelfCollision;
+    float SelfCollisionThickness;
+    // The hash search for self-collision can be cached (see SelfCollision.h): it then looks
+    // ContactCacheSkin further than it needs to, and its candidates are reused for up to
+    // ContactCacheInterval substeps, or until a particle moves more than half the skin. The
+    // interval defaults to 1, searching every substep; the skin to a quarter of the mean edge
+    // length.
+    unsigned int ContactCacheInterval;
+    float ContactCacheSkin;
+    // Continuous triangle self-collision (see ContinuousCollision.h), once per substep after the
+    // iterations, in every mode but SOLVER_IMPLICIT_EULER. Catches what particle collision
+    // misses: edges and faces passing through each other, and fast particles tunnelling.
+    // Defaults to a tenth of the mean edge length.
+    bool ContinuousCollision;
+    float ContinuousThickness;
+    // Distance the particles keep from the colliders (see GetColliders()), in every mode but
+    // SOLVER_IMPLICIT_EULER. Defaults to a tenth of the mean edge length.
+    float ColliderThickness;
+    // Iterations run on each coarse level (see SetHierarchyLevels()) at the start of a substep.
+    unsigned int CoarseIterations;
+    // Chebyshev semi-iterative acceleration of the Jacobi and block descent iterations. Rho is
+    // an estimate of the iteration's spectral radius: higher converges faster until it starts
+    // oscillating. Block descent has its own, lower rho (0.4 by default).
+    bool ChebyshevAcceleration;
+    float ChebyshevRho;
+    float BlockDescentChebyshevRho;
+    // Spring stiffness k of the Projective Dynamics solver.
+    float ProjectiveStiffness;
+    // Implicit Euler springs, and the conjugate gradient's iteration cap and relative tolerance.
+    float ImplicitStiffness;
+    float ImplicitDamping;
+    unsigned int ImplicitIterations;
+    float ImplicitTolerance;
+    // Spring stiffness of the Vertex Block Descent solver.
+    float BlockDescentStiffness;
+
+    ClothSolver(const Mesh &mesh,
+                const std::vector<unsigned int> &pinned,
+                unsigned int iterations = 5,
+                unsigned int threadCount = 0);
+
+    void Step(float deltaTime);
+    void WriteTo(Mesh *mesh) const;
+
+    // Pins hold a particle at its current position (zero inverse mass) until unpinned.
+    // MovePin() drives a pinned particle kinematically, e.g. to drag an attachment around.
+    bool Pin(unsigned int index);
+    bool Unpin(unsigned int index);
+    bool IsPinned(unsigned int index) const;
+    void MovePin(unsigned int index, const glm::vec3 &position);
+    const PinSet &GetPins() const;
+
+    // Instruction set used by the distance-constraint kernels. Defaults to the widest one the
+    // CPU supports; requests above that are clamped.
+    void SetSimdLevel(SimdLevel level);
+    SimdLevel GetSimdLevel() const;
+    // Max difference between the given kernel and the scalar reference on the current state.
+    float VerifyKernel(SimdLevel level) const;
+
+    // XPBD compliance (inverse stiffness, 0 = inextensible), for every constraint or for one
+    // constraint given by its index in Mesh::DistConstraints.
+    void SetCompliance(float compliance);
+    void SetConstraintCompliance(unsigned int constraint, float compliance);
+
+    // Hierarchical PBD: builds up to levelCount coarse levels from the current positions (so call
+    // it before stepping); 0 removes them. Every substep then solves the levels coarsest first,
+    // carrying each level's motion down to the particles it dropped, before the usual iterations
+    // on the mesh itself.
+    void SetHierarchyLevels(unsigned int levelCount);
+    const ParticleHierarchy &GetHierarchy() const;
+    const ProjectiveDynamicsSystem &GetProjectiveDynamics() const;
+
+    void SetSolverMode(SolverMode mode);
+    SolverMode GetSolverMode() const;
+    // threadCount includes the calling thread; 0 picks the hardware concurrency.
+    void SetThreadCount(unsigned int threadCount);
+    unsigned int GetThreadCount() const;
+    // Constraints are stored in color order, so color c is the constraint range
+    // [Offsets[c], Offsets[c + 1]).
+    const ConstraintColoring &GetColoring() const;
+    // Vertices grouped by color, over the mesh's vertex adjacency (see VertexGraph.h).
+    const ConstraintColoring &GetVertexColoring() const;
+    // Mesh faces grouped by color, for Strain.
+    const ConstraintColoring &GetTriangleColoring() const;
+
+    const SolverStats &GetLastStepStats() const;
+    const ContinuousCollisionSystem &GetContinuousCollision() const;
+    const SelfCollisionSystem &GetSelfCollision() const;
+    // Colliders the cloth is kept out of, resolved in one pass over the particles right after
+    // every prediction (with friction) and again after the iterations (without), so the
+    // constraints cannot leave particles inside. Empty by default.
+    ColliderSet &GetColliders();
+    const ColliderSet &GetColliders() const;
+    // Tethers are rebuilt by the first Step() after the pins change.
+    unsigned int GetTetherCount() const;
+
+    unsigned int GetVertexCount() const;
+    const ParticleStore &GetParticles() const;
+
+
+private:
+    ParticleStore particles_;
+    AlignedArray<float> relaxation_;
+    AlignedArray<float> baseInvMass_;
+    PinSet pins_;
+    std::vector<DistanceConstraint> constraints_;
+    DistanceConstraintBatch batch_;
+    DistanceCorrections corrections_;
+    VertexIncidence incidence_;
+    AlignedArray<float> constraintDeltaX_;
+    AlignedArray<float> constraintDeltaY_;
+    AlignedArray<float> constraintDeltaZ_;
+    AlignedArray<float> previousX_;
+    AlignedArray<float> previousY_;
+    AlignedArray<float> previousZ_;
+    float chebyshevOmega_;
+    AlignedArray<float> compliance_;
+    AlignedArray<float> lambda_;
+    // Mesh constraint index -> index in constraints_ (color order).
+    std::vector<unsigned int> constraintSlot_;
+    // One per thread-pool chunk, merged after every iteration.
+    std::vector<DistanceResidual> chunkResiduals_;
+    SolverStats stats_;
+    // Running averages, in milliseconds, of one solver iteration and of the rest of a substep.
+    float iterationCost_;
+    float substepOverhead_;
+    TetherBatch tethers_;
+    bool tethersDirty_;
+    ParticleHierarchy hierarchy_;
+    // Predicted positions at the start of the coarse pass.
+    AlignedArray<float> coarseStartX_;
+    AlignedArray<float> coarseStartY_;
+    AlignedArray<float> coarseStartZ_;
+    ProjectiveDynamicsSystem projective_;
+    ImplicitEulerSystem implicit_;
+    ConstraintColoring vertexColoring_;
+    // Bending stencils in color order.
+    BendingBatch bending_;
+    ConstraintColoring bendingColoring_;
+    AlignedArray<float> bendingLambda_;
+    // Triangles in color order.
+    StrainBatch strain_;
+    ConstraintColoring strainColoring_;
+    AlignedArray<float> strainLambda_;
+    SelfCollisionSystem selfCollision_;
+    ContinuousCollisionSystem continuousCollision_;
+    ColliderSet colliders_;
+    BlockDescentState blockDescent_;
+    SimdLevel simdLevel_;
+    SolverMode mode_;
+    ConstraintColoring coloring_;
+    std::unique_ptr<ThreadPool> threadPool_;
+
+    void InitializeMasses(const Mesh &mesh, const std::vector<unsigned int> &pinned);
+    void Predict(float timeStep);
+    void UpdateVelocities(float timeStep);
+    DistanceResidual MergeResiduals();
+    unsigned int PlanIterations(unsigned int substepCount) const;
+    void SolveJacobi(unsigned int iteration);
+    void SolveGaussSeidel(const DistanceConstraintBatch &batch, const ConstraintColoring &coloring, float stiffness);
+    void SolveHierarchy();
+    void SolveXpbd(float timeStep);
+    void SolveTethers();
+    void SolveBending(float timeStep);
+    void SolveStrain(float timeStep);
+    void SolveProjectiveDynamics(unsigned int iteration);
+    DistanceResidual StepImplicit(float timeStep);
+    void SolveBlockDescent(unsigned int iteration, float timeStep);
+    float GetChebyshevOmega(unsigned int iteration);
+
+};
+
+
+#endif // _CLOTHSOLVER_H_
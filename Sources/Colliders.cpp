@@ -0,0 +1,848 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : Colliders.cpp
+ *
+ * Creation Date : 10/17/2026 - 22:10
+ * Last Modified : 10/17/2026 - 22:35
+ * ==========================================================================================
+ * Description   : References:
+ *                 (1) Macklin et al., "Unified Particle Physics for Real-Time Applications"
+ *                     (position-based friction, section 6.1)
+ *
+ *                 Every contact is a penetration depth d along a unit normal n, from the
+ *                 distance between the particle and the shape: the particle moves by d n, then
+ *                 its motion over the step along the surface, t, shrinks by
+ *                     min(friction d / |t|, 1)
+ *                 so it sticks while |t| < friction d (static friction) and slides slower
+ *                 otherwise (kinetic friction, with the same coefficient).
+ *
+ *                 The scalar loop is the reference; the SSE and AVX2 kernels do the same
+ *                 operations in the same order, lane by lane. AVX-512 runs the AVX2 kernel.
+ *                 Distance fields are sampled one particle at a time in every kernel, last,
+ *                 after the vector lanes are stored back.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <algorithm>
+#include <cmath>
+
+#include "Colliders.h"
+#include "ParticleStore.h"
+#include "SignedDistanceField.h"
+#include "ThreadPool.h"
+
+#if CLOTH_SIMD_X86
+#include <immintrin.h>
+#endif
+
+
+// Record layouts, one float each:
+//     plane   : normal x, y, z, offset (normal . point on the plane), friction
+//     sphere  : center x, y, z, radius, friction
+//     capsule : start x, y, z, axis x, y, z (start to end), 1 / |axis|^2 (0 if none), radius,
+//               friction
+//     box     : center x, y, z, axes u, v, w (x, y, z each), half extents, friction
+//     field   : origin x, y, z, axes u, v, w (x, y, z each), friction; the grid is in
+//               ColliderBatch::FieldGrids at the same index
+const unsigned int PLANE_STRIDE = 5;
+const unsigned int SPHERE_STRIDE = 5;
+const unsigned int CAPSULE_STRIDE = 9;
+const unsigned int BOX_STRIDE = 16;
+const unsigned int FIELD_STRIDE = 13;
+
+// Below this many particles per thread, splitting the pass costs more than it saves.
+const unsigned int COLLIDER_MIN_CHUNK = 1024;
+
+// Distances below this have no usable direction.
+const float COLLIDER_EPSILON = 1e-8f;
+
+
+// PUBLIC METHODS
+// --------------
+
+ColliderSet::ColliderSet()
+{
+}
+
+unsigned int
+ColliderSet::Add(const Collider &collider)
+{
+    colliders_.push_back(collider);
+    Pack();
+    return (unsigned int)colliders_.size() - 1;
+}
+
+void
+ColliderSet::SetTransform(unsigned int index, const glm::mat4 &transform)
+{
+    colliders_[index].Transform = transform;
+    Pack();
+}
+
+void
+ColliderSet::Clear()
+{
+    colliders_.clear();
+    Pack();
+}
+
+unsigned int
+ColliderSet::GetCount() const
+{
+    return (unsigned int)colliders_.size();
+}
+
+const Collider &
+ColliderSet::Get(unsigned int index) const
+{
+    return colliders_[index];
+}
+
+const ColliderBatch &
+ColliderSet::GetBatch() const
+{
+    return batch_;
+}
+
+unsigned int
+ColliderSet::Resolve(ThreadPool *pool, SimdLevel level, float thickness, bool friction, ParticleStore *particles)
+{
+    if (colliders_.empty())
+    {
+        return 0;
+    }
+
+    float frictionScale = friction ? 1.0f : 0.0f;
+    chunkContacts_.assign(pool->GetThreadCount(), 0);
+    pool->ParallelFor(0, particles->GetCount(), COLLIDER_MIN_CHUNK,
+        [&](unsigned int begin, unsigned int end, unsigned int chunk)
+        {
+            chunkContacts_[chunk] = ResolveColliders(level, batch_, begin, end, thickness, frictionScale, particles);
+        });
+
+    unsigned int contacts = 0;
+    for (auto countIt = chunkContacts_.begin(); countIt != chunkContacts_.end(); ++countIt)
+    {
+        contacts += *countIt;
+    }
+    return contacts;
+}
+
+
+// PRIVATE METHODS
+// ---------------
+
+void
+ColliderSet::Pack()
+{
+    batch_.Planes.clear();
+    batch_.Spheres.clear();
+    batch_.Capsules.clear();
+    batch_.Boxes.clear();
+    batch_.Fields.clear();
+    batch_.FieldGrids.clear();
+
+    for (auto colliderIt = colliders_.begin(); colliderIt != colliders_.end(); ++colliderIt)
+    {
+        const glm::mat4 &transform = colliderIt->Transform;
+        glm::vec3 origin = glm::vec3(transform[3]);
+        glm::vec3 u = glm::normalize(glm::vec3(transform[0]));
+        glm::vec3 v = glm::normalize(glm::vec3(transform[1]));
+        glm::vec3 w = glm::normalize(glm::vec3(transform[2]));
+
+        switch (colliderIt->Type)
+        {
+            case COLLIDER_PLANE:
+            {
+                float record[PLANE_STRIDE] = { v.x, v.y, v.z, glm::dot(v, origin), colliderIt->Friction };
+                batch_.Planes.insert(batch_.Planes.end(), record, record + PLANE_STRIDE);
+            } break;
+
+            case COLLIDER_SPHERE:
+            {
+                float record[SPHERE_STRIDE] = { origin.x, origin.y, origin.z, colliderIt->Size.x, colliderIt->Friction };
+                batch_.Spheres.insert(batch_.Spheres.end(), record, record + SPHERE_STRIDE);
+            } break;
+
+            case COLLIDER_CAPSULE:
+            {
+                glm::vec3 start = origin - colliderIt->Size.y * v;
+                glm::vec3 axis = 2.0f * colliderIt->Size.y * v;
+                float lengthSquared = glm::dot(axis, axis);
+                float record[CAPSULE_STRIDE] = { start.x, start.y, start.z, axis.x, axis.y, axis.z,
+                                                 (lengthSquared > 0.0f) ? 1.0f / lengthSquared : 0.0f,
+                                                 colliderIt->Size.x, colliderIt->Friction };
+                batch_.Capsules.insert(batch_.Capsules.end(), record, record + CAPSULE_STRIDE);
+            } break;
+
+            case COLLIDER_BOX:
+            {
+                float record[BOX_STRIDE] = { origin.x, origin.y, origin.z, u.x, u.y, u.z, v.x, v.y, v.z, w.x, w.y, w.z,
+                                             colliderIt->Size.x, colliderIt->Size.y, colliderIt->Size.z,
+                                             colliderIt->Friction };
+                batch_.Boxes.insert(batch_.Boxes.end(), record, record + BOX_STRIDE);
+            } break;
+
+            case COLLIDER_FIELD:
+            {
+                if (!colliderIt->Field || colliderIt->Field->IsEmpty())
+                {
+                    break;
+                }
+
+                float record[FIELD_STRIDE] = { origin.x, origin.y, origin.z, u.x, u.y, u.z, v.x, v.y, v.z, w.x, w.y, w.z,
+                                               colliderIt->Friction };
+                batch_.Fields.insert(batch_.Fields.end(), record, record + FIELD_STRIDE);
+                batch_.FieldGrids.push_back(colliderIt->Field);
+            } break;
+        }
+    }
+}
+
+
+// KERNELS
+// -------
+
+// Pushes the particle out by depth along the normal and applies friction to its motion from
+// (x, y, z). Returns 1 for a contact.
+static inline unsigned int
+ApplyContact(float depth, float nx, float ny, float nz, float friction,
+             float x, float y, float z, float *px, float *py, float *pz)
+{
+    if (depth <= 0.0f)
+    {
+        return 0;
+    }
+
+    *px += depth * nx;
+    *py += depth * ny;
+    *pz += depth * nz;
+
+    float mx = *px - x;
+    float my = *py - y;
+    float mz = *pz - z;
+    float normalMotion = mx*nx + my*ny + mz*nz;
+    float tx = mx - normalMotion * nx;
+    float ty = my - normalMotion * ny;
+    float tz = mz - normalMotion * nz;
+    float tangent = sqrtf(tx*tx + ty*ty + tz*tz);
+    float scale = std::min(friction * depth / std::max(tangent, COLLIDER_EPSILON), 1.0f);
+    *px -= scale * tx;
+    *py -= scale * ty;
+    *pz -= scale * tz;
+    return 1;
+}
+
+// Contact with a point grown by radius, (dx, dy, dz) being the particle minus the point. A
+// particle right on the point is pushed up.
+static inline unsigned int
+ApplyRoundContact(float dx, float dy, float dz, float radius, float friction,
+                  float x, float y, float z, float *px, float *py, float *pz)
+{
+    float distance = sqrtf(dx*dx + dy*dy + dz*dz);
+    bool valid = (distance > COLLIDER_EPSILON);
+    float inverse = 1.0f / std::max(distance, COLLIDER_EPSILON);
+    float nx = valid ? dx * inverse : 0.0f;
+    float ny = valid ? dy * inverse : 1.0f;
+    float nz = valid ? dz * inverse : 0.0f;
+    return ApplyContact(radius - distance, nx, ny, nz, friction, x, y, z, px, py, pz);
+}
+
+// Every distance field against one particle, its position being (px, py, pz). Points where the
+// field has no gradient (beyond the grid) are left alone.
+static unsigned int
+ApplyFieldContacts(const ColliderBatch &batch, float thickness, float frictionScale,
+                   float x, float y, float z, float *px, float *py, float *pz)
+{
+    unsigned int contacts = 0;
+    unsigned int fieldCount = (unsigned int)batch.FieldGrids.size();
+    for (unsigned int field = 0; field < fieldCount; ++field)
+    {
+        const float *r = batch.Fields.data() + field * FIELD_STRIDE;
+        float rx = *px - r[0];
+        float ry = *py - r[1];
+        float rz = *pz - r[2];
+        glm::vec3 local(rx*r[3] + ry*r[4] + rz*r[5], rx*r[6] + ry*r[7] + rz*r[8], rx*r[9] + ry*r[10] + rz*r[11]);
+        glm::vec3 gradient;
+        float distance = batch.FieldGrids[field]->Sample(local, &gradient);
+        float length = glm::length(gradient);
+        if (length <= COLLIDER_EPSILON)
+        {
+            continue;
+        }
+
+        gradient /= length;
+        contacts += ApplyContact(thickness - distance, gradient.x*r[3] + gradient.y*r[6] + gradient.z*r[9],
+                                 gradient.x*r[4] + gradient.y*r[7] + gradient.z*r[10],
+                                 gradient.x*r[5] + gradient.y*r[8] + gradient.z*r[11], r[12] * frictionScale,
+                                 x, y, z, px, py, pz);
+    }
+    return contacts;
+}
+
+// The particles in [begin, end) with a non-zero inverse mass against every distance field.
+static unsigned int
+ApplyFieldContacts(const ColliderBatch &batch, unsigned int begin, unsigned int end,
+                   float thickness, float frictionScale, ParticleStore *particles)
+{
+    if (batch.FieldGrids.empty())
+    {
+        return 0;
+    }
+
+    unsigned int contacts = 0;
+    for (unsigned int index = begin; index < end; ++index)
+    {
+        if (particles->InvMass[index] > 0.0f)
+        {
+            contacts += ApplyFieldContacts(batch, thickness, frictionScale,
+                                           particles->X[index], particles->Y[index], particles->Z[index],
+                                           &particles->PredictedX[index], &particles->PredictedY[index],
+                                           &particles->PredictedZ[index]);
+        }
+    }
+    return contacts;
+}
+
+static unsigned int
+ResolveScalar(const ColliderBatch &batch, unsigned int begin, unsigned int end,
+              float thickness, float frictionScale, ParticleStore *particles)
+{
+    const float *x = particles->X.Data();
+    const float *y = particles->Y.Data();
+    const float *z = particles->Z.Data();
+    float *px = particles->PredictedX.Data();
+    float *py = particles->PredictedY.Data();
+    float *pz = particles->PredictedZ.Data();
+    const float *w = particles->InvMass.Data();
+    unsigned int planeCount = (unsigned int)batch.Planes.size() / PLANE_STRIDE;
+    unsigned int sphereCount = (unsigned int)batch.Spheres.size() / SPHERE_STRIDE;
+    unsigned int capsuleCount = (unsigned int)batch.Capsules.size() / CAPSULE_STRIDE;
+    unsigned int boxCount = (unsigned int)batch.Boxes.size() / BOX_STRIDE;
+
+    unsigned int contacts = 0;
+    for (unsigned int index = begin; index < end; ++index)
+    {
+        if (w[index] <= 0.0f)
+        {
+            continue;
+        }
+
+        float startX = x[index];
+        float startY = y[index];
+        float startZ = z[index];
+        float positionX = px[index];
+        float positionY = py[index];
+        float positionZ = pz[index];
+
+        for (unsigned int plane = 0; plane < planeCount; ++plane)
+        {
+            const float *r = batch.Planes.data() + plane * PLANE_STRIDE;
+            float distance = r[0]*positionX + r[1]*positionY + r[2]*positionZ - r[3];
+            contacts += ApplyContact(thickness - distance, r[0], r[1], r[2], r[4] * frictionScale,
+                                     startX, startY, startZ, &positionX, &positionY, &positionZ);
+        }
+
+        for (unsigned int sphere = 0; sphere < sphereCount; ++sphere)
+        {
+            const float *r = batch.Spheres.data() + sphere * SPHERE_STRIDE;
+            contacts += ApplyRoundContact(positionX - r[0], positionY - r[1], positionZ - r[2], r[3] + thickness,
+                                          r[4] * frictionScale, startX, startY, startZ,
+                                          &positionX, &positionY, &positionZ);
+        }
+
+        for (unsigned int capsule = 0; capsule < capsuleCount; ++capsule)
+        {
+            const float *r = batch.Capsules.data() + capsule * CAPSULE_STRIDE;
+            float ax = positionX - r[0];
+            float ay = positionY - r[1];
+            float az = positionZ - r[2];
+            float along = std::min(std::max((ax*r[3] + ay*r[4] + az*r[5]) * r[6], 0.0f), 1.0f);
+            contacts += ApplyRoundContact(ax - along * r[3], ay - along * r[4], az - along * r[5], r[7] + thickness,
+                                          r[8] * frictionScale, startX, startY, startZ,
+                                          &positionX, &positionY, &positionZ);
+        }
+
+        for (unsigned int box = 0; box < boxCount; ++box)
+        {
+            const float *r = batch.Boxes.data() + box * BOX_STRIDE;
+            float rx = positionX - r[0];
+            float ry = positionY - r[1];
+            float rz = positionZ - r[2];
+            // In the box's frame.
+            float qx = rx*r[3] + ry*r[4] + rz*r[5];
+            float qy = rx*r[6] + ry*r[7] + rz*r[8];
+            float qz = rx*r[9] + ry*r[10] + rz*r[11];
+            float dx = qx - std::min(std::max(qx, -r[12]), r[12]);
+            float dy = qy - std::min(std::max(qy, -r[13]), r[13]);
+            float dz = qz - std::min(std::max(qz, -r[14]), r[14]);
+            float distanceSquared = dx*dx + dy*dy + dz*dz;
+            float distance = sqrtf(distanceSquared);
+            bool outside = (distanceSquared > 0.0f);
+            float inverse = 1.0f / std::max(distance, COLLIDER_EPSILON);
+
+            // Inside, out through the nearest face.
+            float ex = r[12] - fabsf(qx);
+            float ey = r[13] - fabsf(qy);
+            float ez = r[14] - fabsf(qz);
+            bool useX = (ex <= ey) && (ex <= ez);
+            bool useY = !useX && (ey <= ez);
+            bool useZ = !useX && !useY;
+            float insideDepth = std::min(std::min(ex, ey), ez) + thickness;
+
+            float lx = outside ? dx * inverse : (useX ? copysignf(1.0f, qx) : 0.0f);
+            float ly = outside ? dy * inverse : (useY ? copysignf(1.0f, qy) : 0.0f);
+            float lz = outside ? dz * inverse : (useZ ? copysignf(1.0f, qz) : 0.0f);
+            float depth = outside ? thickness - distance : insideDepth;
+            contacts += ApplyContact(depth, lx*r[3] + ly*r[6] + lz*r[9], lx*r[4] + ly*r[7] + lz*r[10],
+                                     lx*r[5] + ly*r[8] + lz*r[11], r[15] * frictionScale,
+                                     startX, startY, startZ, &positionX, &positionY, &positionZ);
+        }
+
+        contacts += ApplyFieldContacts(batch, thickness, frictionScale, startX, startY, startZ,
+                                       &positionX, &positionY, &positionZ);
+
+        px[index] = positionX;
+        py[index] = positionY;
+        pz[index] = positionZ;
+    }
+
+    return contacts;
+}
+
+
+#if CLOTH_SIMD_X86
+
+// Particles being resolved, one per lane.
+struct ParticleLanesSse
+{
+    __m128 X, Y, Z;
+    __m128 PX, PY, PZ;
+    // All bits set for particles that can move.
+    __m128 Movable;
+    // 1 per contact, per lane.
+    __m128 Contacts;
+};
+
+CLOTH_TARGET_SSE static inline void
+ApplyContactSse(const __m128 &penetration, const __m128 &nx, const __m128 &ny, const __m128 &nz, const __m128 &friction,
+                ParticleLanesSse *lanes)
+{
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 active = _mm_and_ps(_mm_cmpgt_ps(penetration, _mm_setzero_ps()), lanes->Movable);
+    __m128 depth = _mm_and_ps(penetration, active);
+    lanes->Contacts = _mm_add_ps(lanes->Contacts, _mm_and_ps(active, one));
+
+    lanes->PX = _mm_add_ps(lanes->PX, _mm_mul_ps(depth, nx));
+    lanes->PY = _mm_add_ps(lanes->PY, _mm_mul_ps(depth, ny));
+    lanes->PZ = _mm_add_ps(lanes->PZ, _mm_mul_ps(depth, nz));
+
+    __m128 mx = _mm_sub_ps(lanes->PX, lanes->X);
+    __m128 my = _mm_sub_ps(lanes->PY, lanes->Y);
+    __m128 mz = _mm_sub_ps(lanes->PZ, lanes->Z);
+    __m128 normalMotion = _mm_add_ps(_mm_add_ps(_mm_mul_ps(mx, nx), _mm_mul_ps(my, ny)), _mm_mul_ps(mz, nz));
+    __m128 tx = _mm_sub_ps(mx, _mm_mul_ps(normalMotion, nx));
+    __m128 ty = _mm_sub_ps(my, _mm_mul_ps(normalMotion, ny));
+    __m128 tz = _mm_sub_ps(mz, _mm_mul_ps(normalMotion, nz));
+    __m128 tangent = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, tx), _mm_mul_ps(ty, ty)), _mm_mul_ps(tz, tz)));
+    __m128 scale = _mm_min_ps(_mm_div_ps(_mm_mul_ps(friction, depth), _mm_max_ps(tangent, _mm_set1_ps(COLLIDER_EPSILON))), one);
+    lanes->PX = _mm_sub_ps(lanes->PX, _mm_mul_ps(scale, tx));
+    lanes->PY = _mm_sub_ps(lanes->PY, _mm_mul_ps(scale, ty));
+    lanes->PZ = _mm_sub_ps(lanes->PZ, _mm_mul_ps(scale, tz));
+}
+
+CLOTH_TARGET_SSE static inline void
+ApplyRoundContactSse(const __m128 &dx, const __m128 &dy, const __m128 &dz, const __m128 &radius,
+                     const __m128 &friction, ParticleLanesSse *lanes)
+{
+    __m128 epsilon = _mm_set1_ps(COLLIDER_EPSILON);
+    __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+    __m128 valid = _mm_cmpgt_ps(distance, epsilon);
+    __m128 inverse = _mm_div_ps(_mm_set1_ps(1.0f), _mm_max_ps(distance, epsilon));
+    __m128 nx = _mm_and_ps(valid, _mm_mul_ps(dx, inverse));
+    __m128 ny = _mm_blendv_ps(_mm_set1_ps(1.0f), _mm_mul_ps(dy, inverse), valid);
+    __m128 nz = _mm_and_ps(valid, _mm_mul_ps(dz, inverse));
+    ApplyContactSse(_mm_sub_ps(radius, distance), nx, ny, nz, friction, lanes);
+}
+
+CLOTH_TARGET_SSE static unsigned int
+ResolveSse(const ColliderBatch &batch, unsigned int begin, unsigned int end,
+           float thickness, float frictionScale, ParticleStore *particles)
+{
+    float *px = particles->PredictedX.Data();
+    float *py = particles->PredictedY.Data();
+    float *pz = particles->PredictedZ.Data();
+    unsigned int planeCount = (unsigned int)batch.Planes.size() / PLANE_STRIDE;
+    unsigned int sphereCount = (unsigned int)batch.Spheres.size() / SPHERE_STRIDE;
+    unsigned int capsuleCount = (unsigned int)batch.Capsules.size() / CAPSULE_STRIDE;
+    unsigned int boxCount = (unsigned int)batch.Boxes.size() / BOX_STRIDE;
+    __m128 zero = _mm_setzero_ps();
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 signBit = _mm_set1_ps(-0.0f);
+    __m128 vThickness = _mm_set1_ps(thickness);
+    __m128 contacts = zero;
+
+    unsigned int index = begin;
+    for (; index + 4 <= end; index += 4)
+    {
+        ParticleLanesSse lanes;
+        lanes.X = _mm_loadu_ps(particles->X.Data() + index);
+        lanes.Y = _mm_loadu_ps(particles->Y.Data() + index);
+        lanes.Z = _mm_loadu_ps(particles->Z.Data() + index);
+        lanes.PX = _mm_loadu_ps(px + index);
+        lanes.PY = _mm_loadu_ps(py + index);
+        lanes.PZ = _mm_loadu_ps(pz + index);
+        lanes.Movable = _mm_cmpgt_ps(_mm_loadu_ps(particles->InvMass.Data() + index), zero);
+        lanes.Contacts = zero;
+
+        for (unsigned int plane = 0; plane < planeCount; ++plane)
+        {
+            const float *r = batch.Planes.data() + plane * PLANE_STRIDE;
+            __m128 nx = _mm_set1_ps(r[0]);
+            __m128 ny = _mm_set1_ps(r[1]);
+            __m128 nz = _mm_set1_ps(r[2]);
+            __m128 distance = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, lanes.PX), _mm_mul_ps(ny, lanes.PY)),
+                                                    _mm_mul_ps(nz, lanes.PZ)), _mm_set1_ps(r[3]));
+            ApplyContactSse(_mm_sub_ps(vThickness, distance), nx, ny, nz, _mm_set1_ps(r[4] * frictionScale), &lanes);
+        }
+
+        for (unsigned int sphere = 0; sphere < sphereCount; ++sphere)
+        {
+            const float *r = batch.Spheres.data() + sphere * SPHERE_STRIDE;
+            ApplyRoundContactSse(_mm_sub_ps(lanes.PX, _mm_set1_ps(r[0])), _mm_sub_ps(lanes.PY, _mm_set1_ps(r[1])),
+                                 _mm_sub_ps(lanes.PZ, _mm_set1_ps(r[2])), _mm_set1_ps(r[3] + thickness),
+                                 _mm_set1_ps(r[4] * frictionScale), &lanes);
+        }
+
+        for (unsigned int capsule = 0; capsule < capsuleCount; ++capsule)
+        {
+            const float *r = batch.Capsules.data() + capsule * CAPSULE_STRIDE;
+            __m128 axisX = _mm_set1_ps(r[3]);
+            __m128 axisY = _mm_set1_ps(r[4]);
+            __m128 axisZ = _mm_set1_ps(r[5]);
+            __m128 ax = _mm_sub_ps(lanes.PX, _mm_set1_ps(r[0]));
+            __m128 ay = _mm_sub_ps(lanes.PY, _mm_set1_ps(r[1]));
+            __m128 az = _mm_sub_ps(lanes.PZ, _mm_set1_ps(r[2]));
+            __m128 along = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, axisX), _mm_mul_ps(ay, axisY)), _mm_mul_ps(az, axisZ)),
+                                      _mm_set1_ps(r[6]));
+            along = _mm_min_ps(_mm_max_ps(along, zero), one);
+            ApplyRoundContactSse(_mm_sub_ps(ax, _mm_mul_ps(along, axisX)), _mm_sub_ps(ay, _mm_mul_ps(along, axisY)),
+                                 _mm_sub_ps(az, _mm_mul_ps(along, axisZ)), _mm_set1_ps(r[7] + thickness),
+                                 _mm_set1_ps(r[8] * frictionScale), &lanes);
+        }
+
+        for (unsigned int box = 0; box < boxCount; ++box)
+        {
+            const float *r = batch.Boxes.data() + box * BOX_STRIDE;
+            __m128 ux = _mm_set1_ps(r[3]), uy = _mm_set1_ps(r[4]), uz = _mm_set1_ps(r[5]);
+            __m128 vx = _mm_set1_ps(r[6]), vy = _mm_set1_ps(r[7]), vz = _mm_set1_ps(r[8]);
+            __m128 wx = _mm_set1_ps(r[9]), wy = _mm_set1_ps(r[10]), wz = _mm_set1_ps(r[11]);
+            __m128 hx = _mm_set1_ps(r[12]), hy = _mm_set1_ps(r[13]), hz = _mm_set1_ps(r[14]);
+            __m128 rx = _mm_sub_ps(lanes.PX, _mm_set1_ps(r[0]));
+            __m128 ry = _mm_sub_ps(lanes.PY, _mm_set1_ps(r[1]));
+            __m128 rz = _mm_sub_ps(lanes.PZ, _mm_set1_ps(r[2]));
+            __m128 qx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, ux), _mm_mul_ps(ry, uy)), _mm_mul_ps(rz, uz));
+            __m128 qy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, vx), _mm_mul_ps(ry, vy)), _mm_mul_ps(rz, vz));
+            __m128 qz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, wx), _mm_mul_ps(ry, wy)), _mm_mul_ps(rz, wz));
+            __m128 dx = _mm_sub_ps(qx, _mm_min_ps(_mm_max_ps(qx, _mm_xor_ps(hx, signBit)), hx));
+            __m128 dy = _mm_sub_ps(qy, _mm_min_ps(_mm_max_ps(qy, _mm_xor_ps(hy, signBit)), hy));
+            __m128 dz = _mm_sub_ps(qz, _mm_min_ps(_mm_max_ps(qz, _mm_xor_ps(hz, signBit)), hz));
+            __m128 distanceSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            __m128 distance = _mm_sqrt_ps(distanceSquared);
+            __m128 outside = _mm_cmpgt_ps(distanceSquared, zero);
+            __m128 inverse = _mm_div_ps(one, _mm_max_ps(distance, _mm_set1_ps(COLLIDER_EPSILON)));
+
+            __m128 ex = _mm_sub_ps(hx, _mm_andnot_ps(signBit, qx));
+            __m128 ey = _mm_sub_ps(hy, _mm_andnot_ps(signBit, qy));
+            __m128 ez = _mm_sub_ps(hz, _mm_andnot_ps(signBit, qz));
+            __m128 useX = _mm_and_ps(_mm_cmple_ps(ex, ey), _mm_cmple_ps(ex, ez));
+            __m128 useY = _mm_andnot_ps(useX, _mm_cmple_ps(ey, ez));
+            __m128 insideDepth = _mm_add_ps(_mm_min_ps(_mm_min_ps(ex, ey), ez), vThickness);
+
+            __m128 lx = _mm_blendv_ps(_mm_and_ps(useX, _mm_or_ps(_mm_and_ps(qx, signBit), one)), _mm_mul_ps(dx, inverse), outside);
+            __m128 ly = _mm_blendv_ps(_mm_and_ps(useY, _mm_or_ps(_mm_and_ps(qy, signBit), one)), _mm_mul_ps(dy, inverse), outside);
+            __m128 lz = _mm_blendv_ps(_mm_andnot_ps(_mm_or_ps(useX, useY), _mm_or_ps(_mm_and_ps(qz, signBit), one)),
+                                      _mm_mul_ps(dz, inverse), outside);
+            __m128 depth = _mm_blendv_ps(insideDepth, _mm_sub_ps(vThickness, distance), outside);
+            ApplyContactSse(depth,
+                            _mm_add_ps(_mm_add_ps(_mm_mul_ps(lx, ux), _mm_mul_ps(ly, vx)), _mm_mul_ps(lz, wx)),
+                            _mm_add_ps(_mm_add_ps(_mm_mul_ps(lx, uy), _mm_mul_ps(ly, vy)), _mm_mul_ps(lz, wy)),
+                            _mm_add_ps(_mm_add_ps(_mm_mul_ps(lx, uz), _mm_mul_ps(ly, vz)), _mm_mul_ps(lz, wz)),
+                            _mm_set1_ps(r[15] * frictionScale), &lanes);
+        }
+
+        _mm_storeu_ps(px + index, lanes.PX);
+        _mm_storeu_ps(py + index, lanes.PY);
+        _mm_storeu_ps(pz + index, lanes.PZ);
+        contacts = _mm_add_ps(contacts, lanes.Contacts);
+    }
+
+    alignas(16) float counts[4];
+    _mm_store_ps(counts, contacts);
+    return (unsigned int)(counts[0] + counts[1] + counts[2] + counts[3])
+         + ApplyFieldContacts(batch, begin, index, thickness, frictionScale, particles)
+         + ResolveScalar(batch, index, end, thickness, frictionScale, particles);
+}
+
+struct ParticleLanesAvx2
+{
+    __m256 X, Y, Z;
+    __m256 PX, PY, PZ;
+    __m256 Movable;
+    __m256 Contacts;
+};
+
+CLOTH_TARGET_AVX2 static inline void
+ApplyContactAvx2(const __m256 &penetration, const __m256 &nx, const __m256 &ny, const __m256 &nz, const __m256 &friction,
+                 ParticleLanesAvx2 *lanes)
+{
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 active = _mm256_and_ps(_mm256_cmp_ps(penetration, _mm256_setzero_ps(), _CMP_GT_OQ), lanes->Movable);
+    __m256 depth = _mm256_and_ps(penetration, active);
+    lanes->Contacts = _mm256_add_ps(lanes->Contacts, _mm256_and_ps(active, one));
+
+    lanes->PX = _mm256_add_ps(lanes->PX, _mm256_mul_ps(depth, nx));
+    lanes->PY = _mm256_add_ps(lanes->PY, _mm256_mul_ps(depth, ny));
+    lanes->PZ = _mm256_add_ps(lanes->PZ, _mm256_mul_ps(depth, nz));
+
+    __m256 mx = _mm256_sub_ps(lanes->PX, lanes->X);
+    __m256 my = _mm256_sub_ps(lanes->PY, lanes->Y);
+    __m256 mz = _mm256_sub_ps(lanes->PZ, lanes->Z);
+    __m256 normalMotion = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(mx, nx), _mm256_mul_ps(my, ny)), _mm256_mul_ps(mz, nz));
+    __m256 tx = _mm256_sub_ps(mx, _mm256_mul_ps(normalMotion, nx));
+    __m256 ty = _mm256_sub_ps(my, _mm256_mul_ps(normalMotion, ny));
+    __m256 tz = _mm256_sub_ps(mz, _mm256_mul_ps(normalMotion, nz));
+    __m256 tangent = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(tx, tx), _mm256_mul_ps(ty, ty)), _mm256_mul_ps(tz, tz)));
+    __m256 scale = _mm256_min_ps(_mm256_div_ps(_mm256_mul_ps(friction, depth),
+                                               _mm256_max_ps(tangent, _mm256_set1_ps(COLLIDER_EPSILON))), one);
+    lanes->PX = _mm256_sub_ps(lanes->PX, _mm256_mul_ps(scale, tx));
+    lanes->PY = _mm256_sub_ps(lanes->PY, _mm256_mul_ps(scale, ty));
+    lanes->PZ = _mm256_sub_ps(lanes->PZ, _mm256_mul_ps(scale, tz));
+}
+
+CLOTH_TARGET_AVX2 static inline void
+ApplyRoundContactAvx2(const __m256 &dx, const __m256 &dy, const __m256 &dz, const __m256 &radius,
+                      const __m256 &friction, ParticleLanesAvx2 *lanes)
+{
+    __m256 epsilon = _mm256_set1_ps(COLLIDER_EPSILON);
+    __m256 distance = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz)));
+    __m256 valid = _mm256_cmp_ps(distance, epsilon, _CMP_GT_OQ);
+    __m256 inverse = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_max_ps(distance, epsilon));
+    __m256 nx = _mm256_and_ps(valid, _mm256_mul_ps(dx, inverse));
+    __m256 ny = _mm256_blendv_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(dy, inverse), valid);
+    __m256 nz = _mm256_and_ps(valid, _mm256_mul_ps(dz, inverse));
+    ApplyContactAvx2(_mm256_sub_ps(radius, distance), nx, ny, nz, friction, lanes);
+}
+
+CLOTH_TARGET_AVX2 static unsigned int
+ResolveAvx2(const ColliderBatch &batch, unsigned int begin, unsigned int end,
+            float thickness, float frictionScale, ParticleStore *particles)
+{
+    float *px = particles->PredictedX.Data();
+    float *py = particles->PredictedY.Data();
+    float *pz = particles->PredictedZ.Data();
+    unsigned int planeCount = (unsigned int)batch.Planes.size() / PLANE_STRIDE;
+    unsigned int sphereCount = (unsigned int)batch.Spheres.size() / SPHERE_STRIDE;
+    unsigned int capsuleCount = (unsigned int)batch.Capsules.size() / CAPSULE_STRIDE;
+    unsigned int boxCount = (unsigned int)batch.Boxes.size() / BOX_STRIDE;
+    __m256 zero = _mm256_setzero_ps();
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 signBit = _mm256_set1_ps(-0.0f);
+    __m256 vThickness = _mm256_set1_ps(thickness);
+    __m256 contacts = zero;
+
+    unsigned int index = begin;
+    for (; index + 8 <= end; index += 8)
+    {
+        ParticleLanesAvx2 lanes;
+        lanes.X = _mm256_loadu_ps(particles->X.Data() + index);
+        lanes.Y = _mm256_loadu_ps(particles->Y.Data() + index);
+        lanes.Z = _mm256_loadu_ps(particles->Z.Data() + index);
+        lanes.PX = _mm256_loadu_ps(px + index);
+        lanes.PY = _mm256_loadu_ps(py + index);
+        lanes.PZ = _mm256_loadu_ps(pz + index);
+        lanes.Movable = _mm256_cmp_ps(_mm256_loadu_ps(particles->InvMass.Data() + index), zero, _CMP_GT_OQ);
+        lanes.Contacts = zero;
+
+        for (unsigned int plane = 0; plane < planeCount; ++plane)
+        {
+            const float *r = batch.Planes.data() + plane * PLANE_STRIDE;
+            __m256 nx = _mm256_set1_ps(r[0]);
+            __m256 ny = _mm256_set1_ps(r[1]);
+            __m256 nz = _mm256_set1_ps(r[2]);
+            __m256 distance = _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, lanes.PX), _mm256_mul_ps(ny, lanes.PY)),
+                                                          _mm256_mul_ps(nz, lanes.PZ)), _mm256_set1_ps(r[3]));
+            ApplyContactAvx2(_mm256_sub_ps(vThickness, distance), nx, ny, nz, _mm256_set1_ps(r[4] * frictionScale), &lanes);
+        }
+
+        for (unsigned int sphere = 0; sphere < sphereCount; ++sphere)
+        {
+            const float *r = batch.Spheres.data() + sphere * SPHERE_STRIDE;
+            ApplyRoundContactAvx2(_mm256_sub_ps(lanes.PX, _mm256_set1_ps(r[0])), _mm256_sub_ps(lanes.PY, _mm256_set1_ps(r[1])),
+                                  _mm256_sub_ps(lanes.PZ, _mm256_set1_ps(r[2])), _mm256_set1_ps(r[3] + thickness),
+                                  _mm256_set1_ps(r[4] * frictionScale), &lanes);
+        }
+
+        for (unsigned int capsule = 0; capsule < capsuleCount; ++capsule)
+        {
+            const float *r = batch.Capsules.data() + capsule * CAPSULE_STRIDE;
+            __m256 axisX = _mm256_set1_ps(r[3]);
+            __m256 axisY = _mm256_set1_ps(r[4]);
+            __m256 axisZ = _mm256_set1_ps(r[5]);
+            __m256 ax = _mm256_sub_ps(lanes.PX, _mm256_set1_ps(r[0]));
+            __m256 ay = _mm256_sub_ps(lanes.PY, _mm256_set1_ps(r[1]));
+            __m256 az = _mm256_sub_ps(lanes.PZ, _mm256_set1_ps(r[2]));
+            __m256 along = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax, axisX), _mm256_mul_ps(ay, axisY)),
+                                                       _mm256_mul_ps(az, axisZ)), _mm256_set1_ps(r[6]));
+            along = _mm256_min_ps(_mm256_max_ps(along, zero), one);
+            ApplyRoundContactAvx2(_mm256_sub_ps(ax, _mm256_mul_ps(along, axisX)), _mm256_sub_ps(ay, _mm256_mul_ps(along, axisY)),
+                                  _mm256_sub_ps(az, _mm256_mul_ps(along, axisZ)), _mm256_set1_ps(r[7] + thickness),
+                                  _mm256_set1_ps(r[8] * frictionScale), &lanes);
+        }
+
+        for (unsigned int box = 0; box < boxCount; ++box)
+        {
+            const float *r = batch.Boxes.data() + box * BOX_STRIDE;
+            __m256 ux = _mm256_set1_ps(r[3]), uy = _mm256_set1_ps(r[4]), uz = _mm256_set1_ps(r[5]);
+            __m256 vx = _mm256_set1_ps(r[6]), vy = _mm256_set1_ps(r[7]), vz = _mm256_set1_ps(r[8]);
+            __m256 wx = _mm256_set1_ps(r[9]), wy = _mm256_set1_ps(r[10]), wz = _mm256_set1_ps(r[11]);
+            __m256 hx = _mm256_set1_ps(r[12]), hy = _mm256_set1_ps(r[13]), hz = _mm256_set1_ps(r[14]);
+            __m256 rx = _mm256_sub_ps(lanes.PX, _mm256_set1_ps(r[0]));
+            __m256 ry = _mm256_sub_ps(lanes.PY, _mm256_set1_ps(r[1]));
+            __m256 rz = _mm256_sub_ps(lanes.PZ, _mm256_set1_ps(r[2]));
+            __m256 qx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(rx, ux), _mm256_mul_ps(ry, uy)), _mm256_mul_ps(rz, uz));
+            __m256 qy = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(rx, vx), _mm256_mul_ps(ry, vy)), _mm256_mul_ps(rz, vz));
+            __m256 qz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(rx, wx), _mm256_mul_ps(ry, wy)), _mm256_mul_ps(rz, wz));
+            __m256 dx = _mm256_sub_ps(qx, _mm256_min_ps(_mm256_max_ps(qx, _mm256_xor_ps(hx, signBit)), hx));
+            __m256 dy = _mm256_sub_ps(qy, _mm256_min_ps(_mm256_max_ps(qy, _mm256_xor_ps(hy, signBit)), hy));
+            __m256 dz = _mm256_sub_ps(qz, _mm256_min_ps(_mm256_max_ps(qz, _mm256_xor_ps(hz, signBit)), hz));
+            __m256 distanceSquared = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+            __m256 distance = _mm256_sqrt_ps(distanceSquared);
+            __m256 outside = _mm256_cmp_ps(distanceSquared, zero, _CMP_GT_OQ);
+            __m256 inverse = _mm256_div_ps(one, _mm256_max_ps(distance, _mm256_set1_ps(COLLIDER_EPSILON)));
+
+            __m256 ex = _mm256_sub_ps(hx, _mm256_andnot_ps(signBit, qx));
+            __m256 ey = _mm256_sub_ps(hy, _mm256_andnot_ps(signBit, qy));
+            __m256 ez = _mm256_sub_ps(hz, _mm256_andnot_ps(signBit, qz));
+            __m256 useX = _mm256_and_ps(_mm256_cmp_ps(ex, ey, _CMP_LE_OQ), _mm256_cmp_ps(ex, ez, _CMP_LE_OQ));
+            __m256 useY = _mm256_andnot_ps(useX, _mm256_cmp_ps(ey, ez, _CMP_LE_OQ));
+            __m256 insideDepth = _mm256_add_ps(_mm256_min_ps(_mm256_min_ps(ex, ey), ez), vThickness);
+
+            __m256 lx = _mm256_blendv_ps(_mm256_and_ps(useX, _mm256_or_ps(_mm256_and_ps(qx, signBit), one)),
+                                         _mm256_mul_ps(dx, inverse), outside);
+            __m256 ly = _mm256_blendv_ps(_mm256_and_ps(useY, _mm256_or_ps(_mm256_and_ps(qy, signBit), one)),
+                                         _mm256_mul_ps(dy, inverse), outside);
+            __m256 lz = _mm256_blendv_ps(_mm256_andnot_ps(_mm256_or_ps(useX, useY), _mm256_or_ps(_mm256_and_ps(qz, signBit), one)),
+                                         _mm256_mul_ps(dz, inverse), outside);
+            __m256 depth = _mm256_blendv_ps(insideDepth, _mm256_sub_ps(vThickness, distance), outside);
+            ApplyContactAvx2(depth,
+                             _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(lx, ux), _mm256_mul_ps(ly, vx)), _mm256_mul_ps(lz, wx)),
+                             _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(lx, uy), _mm256_mul_ps(ly, vy)), _mm256_mul_ps(lz, wy)),
+                             _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(lx, uz), _mm256_mul_ps(ly, vz)), _mm256_mul_ps(lz, wz)),
+                             _mm256_set1_ps(r[15] * frictionScale), &lanes);
+        }
+
+        _mm256_storeu_ps(px + index, lanes.PX);
+        _mm256_storeu_ps(py + index, lanes.PY);
+        _mm256_storeu_ps(pz + index, lanes.PZ);
+        contacts = _mm256_add_ps(contacts, lanes.Contacts);
+    }
+
+    alignas(32) float counts[8];
+    _mm256_store_ps(counts, contacts);
+    float sum = 0.0f;
+    for (unsigned int lane = 0; lane < 8; ++lane)
+    {
+        sum += counts[lane];
+    }
+    return (unsigned int)sum + ApplyFieldContacts(batch, begin, index, thickness, frictionScale, particles)
+         + ResolveScalar(batch, index, end, thickness, frictionScale, particles);
+}
+
+#endif // CLOTH_SIMD_X86
+
+
+// FUNCTIONS
+// ---------
+
+Collider
+MakePlaneCollider(const glm::mat4 &transform, float friction)
+{
+    Collider collider;
+    collider.Type = COLLIDER_PLANE;
+    collider.Size = glm::vec3(0.0f);
+    collider.Transform = transform;
+    collider.Friction = friction;
+    collider.Field = nullptr;
+    return collider;
+}
+
+Collider
+MakeSphereCollider(const glm::mat4 &transform, float radius, float friction)
+{
+    Collider collider;
+    collider.Type = COLLIDER_SPHERE;
+    collider.Size = glm::vec3(radius, 0.0f, 0.0f);
+    collider.Transform = transform;
+    collider.Friction = friction;
+    collider.Field = nullptr;
+    return collider;
+}
+
+Collider
+MakeCapsuleCollider(const glm::mat4 &transform, float radius, float halfHeight, float friction)
+{
+    Collider collider;
+    collider.Type = COLLIDER_CAPSULE;
+    collider.Size = glm::vec3(radius, halfHeight, 0.0f);
+    collider.Transform = transform;
+    collider.Friction = friction;
+    collider.Field = nullptr;
+    return collider;
+}
+
+Collider
+MakeBoxCollider(const glm::mat4 &transform, const glm::vec3 &halfExtents, float friction)
+{
+    Collider collider;
+    collider.Type = COLLIDER_BOX;
+    collider.Size = halfExtents;
+    collider.Transform = transform;
+    collider.Friction = friction;
+    collider.Field = nullptr;
+    return collider;
+}
+
+Collider
+MakeFieldCollider(const glm::mat4 &transform, const SignedDistanceField *field, float friction)
+{
+    Collider collider;
+    collider.Type = COLLIDER_FIELD;
+    collider.Size = glm::vec3(0.0f);
+    collider.Transform = transform;
+    collider.Friction = friction;
+    collider.Field = field;
+    return collider;
+}
+
+unsigned int
+ResolveColliders(SimdLevel level,
+                 const ColliderBatch &batch,
+                 unsigned int begin,
+                 unsigned int end,
+                 float thickness,
+                 float frictionScale,
+                 ParticleStore *particles)
+{
+#if CLOTH_SIMD_X86
+    switch (level)
+    {
+        case SIMD_AVX512:
+        case SIMD_AVX2: return ResolveAvx2(batch, begin, end, thickness, frictionScale, particles);
+        case SIMD_SSE: return ResolveSse(batch, begin, end, thickness, frictionScale, particles);
+        default: break;
+    }
+#endif
+    return ResolveScalar(batch, begin, end, thickness, frictionScale, particles);
+}
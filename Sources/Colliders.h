@@ -0,0 +1,140 @@
+#ifndef _COLLIDERS_H_
+#define _COLLIDERS_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : Colliders.h
+ *
+ * Creation Date : 10/17/2026 - 22:10
+ * Last Modified : 10/18/2026 - 10:40
+ * ==========================================================================================
+ * Description   : Analytic colliders (planes, spheres, capsules and boxes) and signed distance
+ *                 fields of loaded meshes, that the cloth rests on or drapes over. Each one is
+ *                 a shape in its own space placed by a rigid transform, the same model matrix
+ *                 the scene object it stands for is drawn with, and can be moved from frame to
+ *                 frame.
+ *
+ *                 The colliders are packed by type into flat world-space records, and one pass
+ *                 over the particles tests every particle against every one of them: 4 (SSE) or
+ *                 8 (AVX2) particles are loaded at a time, the colliders broadcast one after
+ *                 the other, and the particles written back once, so the cost stays close to a
+ *                 single sweep of the positions whatever the collider count. There are no
+ *                 branches per particle: lanes out of contact move by 0. A distance field is
+ *                 a table lookup per particle rather than a formula, so fields are sampled one
+ *                 particle at a time after the other colliders.
+ *
+ *                 Colliders are taken to be at rest over a step: one moved by SetTransform()
+ *                 pushes the particles out of its way but does not drag them along.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+#include "glm/glm.hpp"
+
+#include "CpuFeatures.h"
+
+
+class ParticleStore;
+class SignedDistanceField;
+class ThreadPool;
+
+
+enum ColliderType : unsigned char
+{
+    // The half-space y <= 0, its surface facing +y.
+    COLLIDER_PLANE,
+    // Centered on the origin, Size.x is the radius.
+    COLLIDER_SPHERE,
+    // Segment from -Size.y to +Size.y along y, Size.x is the radius.
+    COLLIDER_CAPSULE,
+    // Centered on the origin, Size is the half extents.
+    COLLIDER_BOX,
+    // Inside of Field, in the space of the mesh it was built from.
+    COLLIDER_FIELD
+};
+
+
+struct Collider
+{
+    ColliderType Type;
+    glm::vec3 Size;
+    // Rotation and translation only: a scale would make the distances wrong, give the shape
+    // its size through Size instead.
+    glm::mat4 Transform;
+    // Coulomb friction coefficient: a particle in contact keeps still unless it slides more than
+    // Friction times its penetration, and is slowed by that much otherwise.
+    float Friction;
+    // COLLIDER_FIELD only, not owned: the field must outlive the collider. Particles only see
+    // it within its band, so the band must be wider than the collider thickness.
+    const SignedDistanceField *Field;
+};
+
+// World-space records, per type, in the order the colliders were added (see Colliders.cpp for
+// the layout of each).
+struct ColliderBatch
+{
+    std::vector<float> Planes;
+    std::vector<float> Spheres;
+    std::vector<float> Capsules;
+    std::vector<float> Boxes;
+    std::vector<float> Fields;
+    std::vector<const SignedDistanceField *> FieldGrids;
+};
+
+
+class ColliderSet
+{
+
+public:
+    ColliderSet();
+
+    // Returns the index of the new collider.
+    unsigned int Add(const Collider &collider);
+    void SetTransform(unsigned int index, const glm::mat4 &transform);
+    void Clear();
+
+    unsigned int GetCount() const;
+    const Collider &Get(unsigned int index) const;
+    const ColliderBatch &GetBatch() const;
+
+    // Moves the predicted position of every particle with a non-zero inverse mass out of every
+    // collider grown by thickness. With friction, the motion of each particle in contact over
+    // the step (from its position to its prediction) is also cut along the surface. Returns the
+    // number of particle-collider contacts.
+    unsigned int Resolve(ThreadPool *pool, SimdLevel level, float thickness, bool friction,
+                         ParticleStore *particles);
+
+
+private:
+    std::vector<Collider> colliders_;
+    ColliderBatch batch_;
+    // One count per thread-pool chunk.
+    std::vector<unsigned int> chunkContacts_;
+
+    void Pack();
+
+};
+
+
+// FUNCTIONS
+// ---------
+
+Collider MakePlaneCollider(const glm::mat4 &transform, float friction);
+Collider MakeSphereCollider(const glm::mat4 &transform, float radius, float friction);
+Collider MakeCapsuleCollider(const glm::mat4 &transform, float radius, float halfHeight, float friction);
+Collider MakeBoxCollider(const glm::mat4 &transform, const glm::vec3 &halfExtents, float friction);
+Collider MakeFieldCollider(const glm::mat4 &transform, const SignedDistanceField *field, float friction);
+
+// Resolve() over particles [begin, end) on the calling thread. frictionScale multiplies every
+// collider's Friction (0 turns friction off). Returns the number of contacts.
+unsigned int ResolveColliders(SimdLevel level,
+                              const ColliderBatch &batch,
+                              unsigned int begin,
+                              unsigned int end,
+                              float thickness,
+                              float frictionScale,
+                              ParticleStore *particles);
+
+
+#endif // _COLLIDERS_H_
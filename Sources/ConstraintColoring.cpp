@@ -0,0 +1,157 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : ConstraintColoring.cpp
+ *
+ * Creation Date : 10/17/2026 - 13:20
+ * Last Modified : 10/17/2026 - 20:30
+ * ==========================================================================================
+ * Description   : References:
+ *                 (1) Fratarcangeli et al., "Vivace: a Practical Gauss-Seidel Method for Stable
+ *                     Soft Body Dynamics"
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <algorithm>
+
+#include "ConstraintColoring.h"
+#include "DistanceConstraint.h"
+
+
+// STRUCTURES
+// ----------
+
+unsigned int
+ConstraintColoring::GetColorCount() const
+{
+    return Offsets.empty() ? 0 : (unsigned int)Offsets.size() - 1;
+}
+
+unsigned int
+ConstraintColoring::GetColorSize(unsigned int color) const
+{
+    return Offsets[color + 1] - Offsets[color];
+}
+
+float
+ConstraintColoring::GetImbalance() const
+{
+    unsigned int colorCount = GetColorCount();
+    if (colorCount == 0)
+    {
+        return 1.0f;
+    }
+
+    unsigned int largest = 0;
+    for (unsigned int color = 0; color < colorCount; ++color)
+    {
+        largest = std::max(largest, GetColorSize(color));
+    }
+
+    float mean = (float)Order.size() / (float)colorCount;
+    return (float)largest / mean;
+}
+
+void
+ConstraintColoring::PrintReport(std::ostream &stream) const
+{
+    stream << "Colors      : " << GetColorCount() << " (imbalance " << GetImbalance() << ")" << std::endl;
+    for (unsigned int color = 0; color < GetColorCount(); ++color)
+    {
+        stream << "  color " << color << " : " << GetColorSize(color) << " constraints" << std::endl;
+    }
+}
+
+
+// FUNCTIONS
+// ---------
+
+ConstraintColoring
+ColorConstraints(const std::vector<DistanceConstraint> &constraints, unsigned int vertexCount)
+{
+    std::vector<unsigned int> vertices;
+    vertices.reserve(constraints.size() * 2);
+    for (auto constraintIt = constraints.begin(); constraintIt != constraints.end(); ++constraintIt)
+    {
+        vertices.push_back(constraintIt->Vertex1Index);
+        vertices.push_back(constraintIt->Vertex2Index);
+    }
+
+    return ColorStencils(vertices, 2, vertexCount);
+}
+
+ConstraintColoring
+ColorStencils(const std::vector<unsigned int> &vertices, unsigned int stencilSize, unsigned int vertexCount)
+{
+    unsigned int stencilCount = (unsigned int)vertices.size() / stencilSize;
+
+    // Vertex -> stencils, in increasing order.
+    std::vector<unsigned int> offsets(vertexCount + 1, 0);
+    for (auto vertexIt = vertices.begin(); vertexIt != vertices.end(); ++vertexIt)
+    {
+        ++offsets[*vertexIt + 1];
+    }
+    for (unsigned int vertex = 0; vertex < vertexCount; ++vertex)
+    {
+        offsets[vertex + 1] += offsets[vertex];
+    }
+    std::vector<unsigned int> incident(offsets[vertexCount]);
+    std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+    for (unsigned int index = 0; index < vertices.size(); ++index)
+    {
+        incident[cursor[vertices[index]]++] = index / stencilSize;
+    }
+
+    // Greedy: each stencil takes the smallest color not used by a stencil it shares a vertex
+    // with. forbidden[color] == stencil + 1 marks a color taken for that stencil.
+    const unsigned int NO_COLOR = 0xFFFFFFFF;
+    std::vector<unsigned int> colors(stencilCount, NO_COLOR);
+    std::vector<unsigned int> forbidden;
+    std::vector<unsigned int> colorSizes;
+
+    for (unsigned int index = 0; index < stencilCount; ++index)
+    {
+        for (unsigned int corner = 0; corner < stencilSize; ++corner)
+        {
+            unsigned int vertex = vertices[index * stencilSize + corner];
+            for (unsigned int slot = offsets[vertex]; slot < offsets[vertex + 1]; ++slot)
+            {
+                unsigned int color = colors[incident[slot]];
+                if (color != NO_COLOR)
+                {
+                    forbidden[color] = index + 1;
+                }
+            }
+        }
+
+        unsigned int color = 0;
+        while ((color < forbidden.size()) && (forbidden[color] == index + 1))
+        {
+            ++color;
+        }
+        if (color == forbidden.size())
+        {
+            forbidden.push_back(0);
+            colorSizes.push_back(0);
+        }
+
+        colors[index] = color;
+        ++colorSizes[color];
+    }
+
+    ConstraintColoring coloring;
+    coloring.Offsets.assign(colorSizes.size() + 1, 0);
+    for (unsigned int color = 0; color < colorSizes.size(); ++color)
+    {
+        coloring.Offsets[color + 1] = coloring.Offsets[color] + colorSizes[color];
+    }
+
+    coloring.Order.resize(stencilCount);
+    std::vector<unsigned int> next(coloring.Offsets.begin(), coloring.Offsets.end() - 1);
+    for (unsigned int index = 0; index < stencilCount; ++index)
+    {
+        coloring.Order[next[colors[index]]++] = index;
+    }
+
+    return coloring;
+}
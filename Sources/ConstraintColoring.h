@@ -0,0 +1,46 @@
+#ifndef _CONSTRAINTCOLORING_H_
+#define _CONSTRAINTCOLORING_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : ConstraintColoring.h
+ *
+ * Creation Date : 10/17/2026 - 13:20
+ * Last Modified : 10/17/2026 - 20:30
+ * ==========================================================================================
+ * Description   : Greedy coloring of the distance-constraint graph: two constraints sharing a
+ *                 vertex never get the same color, so all constraints of one color can be
+ *                 projected in parallel without any synchronization.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+#include <ostream>
+
+
+class DistanceConstraint;
+
+
+struct ConstraintColoring
+{
+    // Constraint indices grouped by color; color c is Order[Offsets[c], Offsets[c + 1]).
+    std::vector<unsigned int> Order;
+    std::vector<unsigned int> Offsets;
+
+    unsigned int GetColorCount() const;
+    unsigned int GetColorSize(unsigned int color) const;
+    // Largest color size over the mean color size; 1 is perfectly balanced.
+    float GetImbalance() const;
+
+    void PrintReport(std::ostream &stream) const;
+};
+
+
+ConstraintColoring ColorConstraints(const std::vector<DistanceConstraint> &constraints, unsigned int vertexCount);
+// Same for constraints over stencilSize vertices each: stencil s is
+// vertices[s * stencilSize, (s + 1) * stencilSize).
+ConstraintColoring ColorStencils(const std::vector<unsigned int> &vertices, unsigned int stencilSize, unsigned int vertexCount);
+
+
+#endif // _CONSTRAINTCOLORING_H_
@@ -0,0 +1,690 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : ContinuousCollision.cpp
+ *
+ * Creation Date : 10/17/2026 - 21:45
+ * Last Modified : 10/17/2026 - 21:45
+ * ==========================================================================================
+ * Description   : References:
+ *                 (1) Bridson et al., "Robust Treatment of Collisions, Contact and Friction for
+ *                     Cloth Animation" (coplanarity cubic, section 6)
+ *
+ *                 (2) Curtis et al., "Fast Collision Detection for Deformable Models using
+ *                     Representative-Triangles" (feature ownership)
+ *
+ *                 (3) Ericson, "Real-Time Collision Detection" (closest points, 5.1.5 and 5.1.9)
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "ContinuousCollision.h"
+#include "Mesh.h"
+#include "ParticleStore.h"
+#include "ThreadPool.h"
+
+
+const unsigned int CONTINUOUS_MIN_CHUNK = 256;
+
+// Rebuild the tree once refitting has grown its node areas by half over the fresh tree.
+const float CONTINUOUS_REBUILD_QUALITY = 1.5f;
+
+// Gauss-Seidel passes over the contacts, and bisection steps per root of the cubic (1e-12 on
+// [0, 1]).
+const unsigned int CONTINUOUS_SOLVE_PASSES = 4;
+const unsigned int CONTINUOUS_BISECTIONS = 40;
+
+// Ends of e1, e2 and e3 in the coplanarity cubic: the triangle's two edges from its first
+// corner and the vertex from that corner, or the two edges and the start of the second edge
+// from the start of the first.
+const unsigned int VERTEX_TRIANGLE_VECTORS[3][2] = { { 1, 2 }, { 1, 3 }, { 1, 0 } };
+const unsigned int EDGE_EDGE_VECTORS[3][2] = { { 0, 1 }, { 2, 3 }, { 0, 2 } };
+
+// Closest points nearer than this fraction of the thickness count as crossing, their direction
+// is too noisy to push along.
+const double CONTINUOUS_CROSSING_DISTANCE = 0.01;
+
+typedef std::chrono::steady_clock Clock;
+
+
+// FUNCTIONS
+// ---------
+
+static inline double
+EvaluateCubic(const double *coefficients, double t)
+{
+    return ((coefficients[3] * t + coefficients[2]) * t + coefficients[1]) * t + coefficients[0];
+}
+
+// Roots in [0, 1], ascending. The cubic is monotonic between its critical points, so each of
+// those intervals holds at most one root, found by bisection.
+static unsigned int
+FindCubicRoots(const double *coefficients, double *roots)
+{
+    double splits[4];
+    unsigned int splitCount = 0;
+    splits[splitCount++] = 0.0;
+
+    double a = 3.0 * coefficients[3];
+    double b = 2.0 * coefficients[2];
+    double c = coefficients[1];
+    double critical[2];
+    unsigned int criticalCount = 0;
+    if (a != 0.0)
+    {
+        double discriminant = b*b - 4.0*a*c;
+        if (discriminant >= 0.0)
+        {
+            double root = sqrt(discriminant);
+            critical[criticalCount++] = (-b - root) / (2.0 * a);
+            critical[criticalCount++] = (-b + root) / (2.0 * a);
+        }
+    }
+    else if (b != 0.0)
+    {
+        critical[criticalCount++] = -c / b;
+    }
+    std::sort(critical, critical + criticalCount);
+    for (unsigned int index = 0; index < criticalCount; ++index)
+    {
+        if ((critical[index] > 0.0) && (critical[index] < 1.0))
+        {
+            splits[splitCount++] = critical[index];
+        }
+    }
+    splits[splitCount++] = 1.0;
+
+    unsigned int rootCount = 0;
+    for (unsigned int interval = 0; interval + 1 < splitCount; ++interval)
+    {
+        double low = splits[interval];
+        double high = splits[interval + 1];
+        double lowValue = EvaluateCubic(coefficients, low);
+        double highValue = EvaluateCubic(coefficients, high);
+        if (lowValue == 0.0)
+        {
+            if ((rootCount == 0) || (roots[rootCount - 1] != low))
+            {
+                roots[rootCount++] = low;
+            }
+            continue;
+        }
+        if ((lowValue < 0.0) == (highValue < 0.0))
+        {
+            continue;
+        }
+
+        for (unsigned int step = 0; step < CONTINUOUS_BISECTIONS; ++step)
+        {
+            double middle = 0.5 * (low + high);
+            double middleValue = EvaluateCubic(coefficients, middle);
+            if ((middleValue < 0.0) == (lowValue < 0.0))
+            {
+                low = middle;
+                lowValue = middleValue;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        roots[rootCount++] = 0.5 * (low + high);
+    }
+    return rootCount;
+}
+
+// Boxes are min x, y, z then max x, y, z.
+static inline void
+MergeBoxes(const float *first, const float *second, float *merged)
+{
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+        merged[axis] = std::min(first[axis], second[axis]);
+        merged[axis + 3] = std::max(first[axis + 3], second[axis + 3]);
+    }
+}
+
+static inline bool
+BoxesOverlap(const float *first, const float *second)
+{
+    return (first[0] <= second[3]) && (second[0] <= first[3])
+        && (first[1] <= second[4]) && (second[1] <= first[4])
+        && (first[2] <= second[5]) && (second[2] <= first[5]);
+}
+
+// Squared distance from p to triangle abc; weights gets the barycentric coordinates of the
+// closest point.
+static double
+ClosestPointOnTriangle(const glm::dvec3 &p, const glm::dvec3 &a, const glm::dvec3 &b, const glm::dvec3 &c,
+                       double *weights)
+{
+    glm::dvec3 ab = b - a;
+    glm::dvec3 ac = c - a;
+    glm::dvec3 ap = p - a;
+    glm::dvec3 bp = p - b;
+    glm::dvec3 cp = p - c;
+    double d1 = glm::dot(ab, ap);
+    double d2 = glm::dot(ac, ap);
+    double d3 = glm::dot(ab, bp);
+    double d4 = glm::dot(ac, bp);
+    double d5 = glm::dot(ab, cp);
+    double d6 = glm::dot(ac, cp);
+    double va = d3*d6 - d5*d4;
+    double vb = d5*d2 - d1*d6;
+    double vc = d1*d4 - d3*d2;
+
+    double v = 0.0;
+    double w = 0.0;
+    if ((d1 <= 0.0) && (d2 <= 0.0))
+    {
+        // Closest to a.
+    }
+    else if ((d3 >= 0.0) && (d4 <= d3))
+    {
+        v = 1.0;
+    }
+    else if ((vc <= 0.0) && (d1 >= 0.0) && (d3 <= 0.0))
+    {
+        v = d1 / (d1 - d3);
+    }
+    else if ((d6 >= 0.0) && (d5 <= d6))
+    {
+        w = 1.0;
+    }
+    else if ((vb <= 0.0) && (d2 >= 0.0) && (d6 <= 0.0))
+    {
+        w = d2 / (d2 - d6);
+    }
+    else if ((va <= 0.0) && (d4 - d3 >= 0.0) && (d5 - d6 >= 0.0))
+    {
+        w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        v = 1.0 - w;
+    }
+    else
+    {
+        double denominator = 1.0 / (va + vb + vc);
+        v = vb * denominator;
+        w = vc * denominator;
+    }
+
+    weights[0] = 1.0 - v - w;
+    weights[1] = v;
+    weights[2] = w;
+    glm::dvec3 closest = a + v*ab + w*ac;
+    return glm::dot(p - closest, p - closest);
+}
+
+// Squared distance between segments p1q1 and p2q2; s and t get the parameters of the closest
+// points along each.
+static double
+ClosestPointsOnSegments(const glm::dvec3 &p1, const glm::dvec3 &q1, const glm::dvec3 &p2, const glm::dvec3 &q2,
+                        double *s, double *t)
+{
+    const double epsilon = 1e-20;
+    glm::dvec3 d1 = q1 - p1;
+    glm::dvec3 d2 = q2 - p2;
+    glm::dvec3 r = p1 - p2;
+    double a = glm::dot(d1, d1);
+    double e = glm::dot(d2, d2);
+    double f = glm::dot(d2, r);
+
+    if ((a <= epsilon) && (e <= epsilon))
+    {
+        *s = 0.0;
+        *t = 0.0;
+    }
+    else if (a <= epsilon)
+    {
+        *s = 0.0;
+        *t = glm::clamp(f / e, 0.0, 1.0);
+    }
+    else
+    {
+        double c = glm::dot(d1, r);
+        if (e <= epsilon)
+        {
+            *t = 0.0;
+            *s = glm::clamp(-c / a, 0.0, 1.0);
+        }
+        else
+        {
+            double b = glm::dot(d1, d2);
+            double denominator = a*e - b*b;
+            *s = (denominator != 0.0) ? glm::clamp((b*f - c*e) / denominator, 0.0, 1.0) : 0.0;
+            *t = (b * *s + f) / e;
+            if (*t < 0.0)
+            {
+                *t = 0.0;
+                *s = glm::clamp(-c / a, 0.0, 1.0);
+            }
+            else if (*t > 1.0)
+            {
+                *t = 1.0;
+                *s = glm::clamp((b - c) / a, 0.0, 1.0);
+            }
+        }
+    }
+
+    glm::dvec3 difference = (p1 + *s * d1) - (p2 + *t * d2);
+    return glm::dot(difference, difference);
+}
+
+// Tests vertex Vertices[0] against triangle Vertices[1..3], or edge Vertices[0..1] against edge
+// Vertices[2..3], over the step. Fills contact if they come within thickness and end the step
+// closer, along the contact normal, than the contact allows.
+static bool
+FindContact(const ParticleStore &particles, const unsigned int *vertices, bool edgeEdge, float thickness,
+            ContinuousContact *contact)
+{
+    glm::dvec3 start[4];
+    glm::dvec3 end[4];
+    for (unsigned int point = 0; point < 4; ++point)
+    {
+        unsigned int vertex = vertices[point];
+        start[point] = glm::dvec3(particles.X[vertex], particles.Y[vertex], particles.Z[vertex]);
+        end[point] = glm::dvec3(particles.PredictedX[vertex], particles.PredictedY[vertex], particles.PredictedZ[vertex]);
+    }
+
+    // Two features move apart or together at most as fast as their fastest points, so if they
+    // start further apart than thickness plus those displacements, they cannot meet.
+    double thicknessSquared = (double)thickness * (double)thickness;
+    double weights[4];
+    unsigned int split = edgeEdge ? 2 : 1;
+    double displacement[2] = { 0.0, 0.0 };
+    for (unsigned int point = 0; point < 4; ++point)
+    {
+        glm::dvec3 move = end[point] - start[point];
+        unsigned int side = (point < split) ? 0 : 1;
+        displacement[side] = std::max(displacement[side], glm::dot(move, move));
+    }
+    double startDistanceSquared = edgeEdge ? ClosestPointsOnSegments(start[0], start[1], start[2], start[3], &weights[0], &weights[1])
+                                           : ClosestPointOnTriangle(start[0], start[1], start[2], start[3], weights);
+    double reach = (double)thickness + sqrt(displacement[0]) + sqrt(displacement[1]);
+    if (startDistanceSquared > reach * reach)
+    {
+        return false;
+    }
+
+    // The four points are coplanar when e3 . (e1 x e2) = 0, a cubic in t since every e moves
+    // linearly: e = e0 + t de.
+    const unsigned int (*ends)[2] = edgeEdge ? EDGE_EDGE_VECTORS : VERTEX_TRIANGLE_VECTORS;
+    glm::dvec3 e[3];
+    glm::dvec3 de[3];
+    for (unsigned int index = 0; index < 3; ++index)
+    {
+        e[index] = start[ends[index][1]] - start[ends[index][0]];
+        de[index] = (end[ends[index][1]] - end[ends[index][0]]) - e[index];
+    }
+    glm::dvec3 cross12 = glm::cross(e[0], e[1]);
+    glm::dvec3 crossMixed = glm::cross(e[0], de[1]) + glm::cross(de[0], e[1]);
+    glm::dvec3 crossMoving = glm::cross(de[0], de[1]);
+    double coefficients[4] =
+    {
+        glm::dot(e[2], cross12),
+        glm::dot(e[2], crossMixed) + glm::dot(de[2], cross12),
+        glm::dot(e[2], crossMoving) + glm::dot(de[2], crossMixed),
+        glm::dot(de[2], crossMoving)
+    };
+
+    // Every coplanar time, earliest first, then the end of the step for pairs that come within
+    // thickness without crossing.
+    double times[4];
+    unsigned int timeCount = FindCubicRoots(coefficients, times);
+    times[timeCount++] = 1.0;
+
+    glm::dvec3 at[4];
+    bool hit = false;
+    for (unsigned int index = 0; (index < timeCount) && !hit; ++index)
+    {
+        for (unsigned int point = 0; point < 4; ++point)
+        {
+            at[point] = start[point] + times[index] * (end[point] - start[point]);
+        }
+        if (edgeEdge)
+        {
+            double s;
+            double t;
+            hit = (ClosestPointsOnSegments(at[0], at[1], at[2], at[3], &s, &t) <= thicknessSquared);
+            weights[0] = 1.0 - s;
+            weights[1] = s;
+            weights[2] = -(1.0 - t);
+            weights[3] = -t;
+        }
+        else
+        {
+            double barycentric[3];
+            hit = (ClosestPointOnTriangle(at[0], at[1], at[2], at[3], barycentric) <= thicknessSquared);
+            weights[0] = 1.0;
+            weights[1] = -barycentric[0];
+            weights[2] = -barycentric[1];
+            weights[3] = -barycentric[2];
+        }
+    }
+    if (!hit)
+    {
+        return false;
+    }
+
+    // Direction between the closest points at the time of contact, unless they are on top of
+    // each other (the pair is crossing): then the triangle normal or the edges' common
+    // perpendicular. Either way pointing to the side the pair started on.
+    glm::dvec3 startSeparation(0.0);
+    glm::dvec3 endSeparation(0.0);
+    glm::dvec3 contactSeparation(0.0);
+    double inverseMassSum = 0.0;
+    for (unsigned int point = 0; point < 4; ++point)
+    {
+        startSeparation += weights[point] * start[point];
+        endSeparation += weights[point] * end[point];
+        contactSeparation += weights[point] * at[point];
+        inverseMassSum += weights[point] * weights[point] * (double)particles.InvMass[vertices[point]];
+    }
+    if (inverseMassSum <= 0.0)
+    {
+        return false;
+    }
+
+    glm::dvec3 normal = contactSeparation;
+    double crossingDistance = CONTINUOUS_CROSSING_DISTANCE * (double)thickness;
+    if (glm::dot(normal, normal) <= crossingDistance * crossingDistance)
+    {
+        glm::dvec3 first = edgeEdge ? at[1] - at[0] : at[2] - at[1];
+        glm::dvec3 second = edgeEdge ? at[3] - at[2] : at[3] - at[1];
+        normal = glm::cross(first, second);
+        if (glm::dot(normal, normal) <= 1e-12 * glm::dot(first, first) * glm::dot(second, second))
+        {
+            normal = startSeparation;
+        }
+        if (glm::dot(normal, normal) <= 0.0)
+        {
+            return false;
+        }
+    }
+    normal = glm::normalize(normal);
+    if (glm::dot(normal, startSeparation) < 0.0)
+    {
+        normal = -normal;
+    }
+    // Inelastic: a pair that started closer than thickness is only kept from getting closer.
+    // Pushing it out to thickness in one substep would turn into a velocity of the push over the
+    // substep, which is what makes layered folds blow up.
+    double distance = std::min((double)thickness, glm::dot(normal, startSeparation));
+    if (glm::dot(normal, endSeparation) >= distance)
+    {
+        return false;
+    }
+
+    for (unsigned int point = 0; point < 4; ++point)
+    {
+        contact->Vertices[point] = vertices[point];
+        contact->Weights[point] = (float)weights[point];
+    }
+    contact->Normal = glm::vec3(normal);
+    contact->Distance = (float)distance;
+    return true;
+}
+
+
+// PUBLIC METHODS
+// --------------
+
+ContinuousCollisionSystem::ContinuousCollisionSystem()
+{
+}
+
+void
+ContinuousCollisionSystem::Build(const std::vector<Face> &faces, unsigned int particleCount)
+{
+    bvh_.SetTriangles(faces);
+
+    unsigned int faceCount = (unsigned int)faces.size();
+    owned_.assign(faceCount, 0);
+    std::vector<unsigned char> seen(particleCount, 0);
+    std::vector<std::pair<unsigned long long, unsigned int>> edges;
+    edges.reserve(3 * faceCount);
+    for (unsigned int face = 0; face < faceCount; ++face)
+    {
+        for (unsigned int corner = 0; corner < 3; ++corner)
+        {
+            unsigned int vertex = faces[face].Indices[corner];
+            if (!seen[vertex])
+            {
+                seen[vertex] = 1;
+                owned_[face] |= (unsigned char)(1 << corner);
+            }
+
+            unsigned int next = faces[face].Indices[(corner + 1) % 3];
+            unsigned long long key = ((unsigned long long)std::min(vertex, next) << 32) | std::max(vertex, next);
+            edges.push_back(std::make_pair(key, 3 * face + corner));
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    for (unsigned int index = 0; index < edges.size(); ++index)
+    {
+        if ((index == 0) || (edges[index].first != edges[index - 1].first))
+        {
+            owned_[edges[index].second / 3] |= (unsigned char)(8 << (edges[index].second % 3));
+        }
+    }
+
+    vertexBoxes_.Resize(6 * particleCount);
+    contacts_.clear();
+    stats_ = ContinuousCollisionStats();
+}
+
+void
+ContinuousCollisionSystem::Step(ThreadPool *pool, float thickness, ParticleStore *particles)
+{
+    Clock::time_point stepStart = Clock::now();
+
+    // Boxes grown by half the thickness each overlap whenever their triangles come within it.
+    bool fresh = (bvh_.GetNodeCount() == 0);
+    bvh_.Refit(particles->X.Data(), particles->Y.Data(), particles->Z.Data(),
+               particles->PredictedX.Data(), particles->PredictedY.Data(), particles->PredictedZ.Data(), 0.5f * thickness);
+    ++stats_.Refits;
+    if (!fresh && (bvh_.GetQuality() > CONTINUOUS_REBUILD_QUALITY))
+    {
+        bvh_.Build();
+        ++stats_.Rebuilds;
+    }
+    stats_.Quality = bvh_.GetQuality();
+
+    // Most features of overlapping triangles are nowhere near each other; their swept boxes,
+    // made of these, tell without solving anything.
+    const float *startAxes[3] = { particles->X.Data(), particles->Y.Data(), particles->Z.Data() };
+    const float *endAxes[3] = { particles->PredictedX.Data(), particles->PredictedY.Data(), particles->PredictedZ.Data() };
+    pool->ParallelFor(0, particles->GetCount(), CONTINUOUS_MIN_CHUNK,
+        [&](unsigned int begin, unsigned int end, unsigned int)
+        {
+            for (unsigned int vertex = begin; vertex < end; ++vertex)
+            {
+                float *box = vertexBoxes_.Data() + 6 * vertex;
+                for (unsigned int axis = 0; axis < 3; ++axis)
+                {
+                    box[axis] = std::min(startAxes[axis][vertex], endAxes[axis][vertex]) - 0.5f * thickness;
+                    box[axis + 3] = std::max(startAxes[axis][vertex], endAxes[axis][vertex]) + 0.5f * thickness;
+                }
+            }
+        });
+
+    stats_.Query = BvhQueryStats();
+    bvh_.FindOverlappingPairs(&pairs_, &stats_.Query);
+    unsigned int pairCount = (unsigned int)pairs_.size();
+    double triangleCount = (double)bvh_.GetTriangleCount();
+    double allPairs = 0.5 * triangleCount * (triangleCount - 1.0);
+    stats_.TrianglePairs = pairCount;
+    stats_.CullingEfficiency = (allPairs > 0.0) ? (float)(1.0 - (double)pairCount / allPairs) : 0.0f;
+
+    unsigned int chunkCount = pool->GetThreadCount();
+    chunkContacts_.resize(chunkCount);
+    chunkTests_.assign(chunkCount, 0);
+    for (auto chunkIt = chunkContacts_.begin(); chunkIt != chunkContacts_.end(); ++chunkIt)
+    {
+        chunkIt->clear();
+    }
+    const ParticleStore &current = *particles;
+    pool->ParallelFor(0, pairCount, CONTINUOUS_MIN_CHUNK,
+        [&](unsigned int begin, unsigned int end, unsigned int chunk)
+        {
+            for (unsigned int pair = begin; pair < end; ++pair)
+            {
+                chunkTests_[chunk] += TestTrianglePair(current, pairs_[pair].first, pairs_[pair].second, thickness,
+                                                       &chunkContacts_[chunk]);
+            }
+        });
+
+    // Chunks cover the pairs in order, so this is the serial order whatever the thread count.
+    contacts_.clear();
+    stats_.FeatureTests = 0;
+    for (unsigned int chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        contacts_.insert(contacts_.end(), chunkContacts_[chunk].begin(), chunkContacts_[chunk].end());
+        stats_.FeatureTests += chunkTests_[chunk];
+    }
+    stats_.Contacts = (unsigned int)contacts_.size();
+
+    // Contacts share vertices all over a fold, so the response is a serial Gauss-Seidel sweep.
+    float *px = particles->PredictedX.Data();
+    float *py = particles->PredictedY.Data();
+    float *pz = particles->PredictedZ.Data();
+    const float *w = particles->InvMass.Data();
+    for (unsigned int pass = 0; pass < CONTINUOUS_SOLVE_PASSES; ++pass)
+    {
+        for (auto contactIt = contacts_.begin(); contactIt != contacts_.end(); ++contactIt)
+        {
+            const glm::vec3 &normal = contactIt->Normal;
+            float separation = -contactIt->Distance;
+            float inverseMassSum = 0.0f;
+            float leverage = 0.0f;
+            for (unsigned int point = 0; point < 4; ++point)
+            {
+                unsigned int vertex = contactIt->Vertices[point];
+                float weight = contactIt->Weights[point];
+                separation += weight * (normal.x * px[vertex] + normal.y * py[vertex] + normal.z * pz[vertex]);
+                inverseMassSum += weight * weight * w[vertex];
+                leverage = std::max(leverage, fabsf(weight) * w[vertex]);
+            }
+            if ((separation >= 0.0f) || (inverseMassSum <= 0.0f))
+            {
+                continue;
+            }
+
+            // No point moves further than the overlap. Only matters when the free points barely
+            // weigh in, e.g. a vertex against the pinned corner of a triangle, where the exact
+            // projection would fling the free ones.
+            float scale = -separation / std::max(inverseMassSum, leverage);
+            for (unsigned int point = 0; point < 4; ++point)
+            {
+                unsigned int vertex = contactIt->Vertices[point];
+                float move = scale * contactIt->Weights[point] * w[vertex];
+                px[vertex] += move * normal.x;
+                py[vertex] += move * normal.y;
+                pz[vertex] += move * normal.z;
+            }
+        }
+    }
+
+    stats_.Time = std::chrono::duration<float, std::milli>(Clock::now() - stepStart).count();
+}
+
+const ContinuousCollisionStats &
+ContinuousCollisionSystem::GetStats() const
+{
+    return stats_;
+}
+
+const std::vector<ContinuousContact> &
+ContinuousCollisionSystem::GetContacts() const
+{
+    return contacts_;
+}
+
+const TriangleBvh &
+ContinuousCollisionSystem::GetBvh() const
+{
+    return bvh_;
+}
+
+
+// PRIVATE METHODS
+// ---------------
+
+unsigned int
+ContinuousCollisionSystem::TestTrianglePair(const ParticleStore &particles, unsigned int first, unsigned int second,
+                                            float thickness, std::vector<ContinuousContact> *contacts) const
+{
+    unsigned int triangles[2] = { first, second };
+    unsigned int corners[2][3];
+    float triangleBoxes[2][6];
+    // Edge c runs from corner c to corner c + 1.
+    float edgeBoxes[2][3][6];
+    for (unsigned int side = 0; side < 2; ++side)
+    {
+        for (unsigned int corner = 0; corner < 3; ++corner)
+        {
+            corners[side][corner] = bvh_.GetVertex(triangles[side], corner);
+        }
+        for (unsigned int corner = 0; corner < 3; ++corner)
+        {
+            MergeBoxes(vertexBoxes_.Data() + 6 * corners[side][corner], vertexBoxes_.Data() + 6 * corners[side][(corner + 1) % 3],
+                       edgeBoxes[side][corner]);
+        }
+        MergeBoxes(edgeBoxes[side][0], edgeBoxes[side][1], triangleBoxes[side]);
+    }
+
+    unsigned int tests = 0;
+    ContinuousContact contact;
+    for (unsigned int side = 0; side < 2; ++side)
+    {
+        const unsigned int *other = corners[1 - side];
+        for (unsigned int corner = 0; corner < 3; ++corner)
+        {
+            unsigned int vertex = corners[side][corner];
+            if (!(owned_[triangles[side]] & (1 << corner)) || (std::find(other, other + 3, vertex) != other + 3)
+                || !BoxesOverlap(vertexBoxes_.Data() + 6 * vertex, triangleBoxes[1 - side]))
+            {
+                continue;
+            }
+
+            unsigned int vertices[4] = { vertex, other[0], other[1], other[2] };
+            ++tests;
+            if (FindContact(particles, vertices, false, thickness, &contact))
+            {
+                contacts->push_back(contact);
+            }
+        }
+    }
+
+    for (unsigned int edgeA = 0; edgeA < 3; ++edgeA)
+    {
+        if (!(owned_[first] & (8 << edgeA)))
+        {
+            continue;
+        }
+        for (unsigned int edgeB = 0; edgeB < 3; ++edgeB)
+        {
+            if (!(owned_[second] & (8 << edgeB)))
+            {
+                continue;
+            }
+
+            unsigned int vertices[4] = { corners[0][edgeA], corners[0][(edgeA + 1) % 3],
+                                         corners[1][edgeB], corners[1][(edgeB + 1) % 3] };
+            if ((vertices[0] == vertices[2]) || (vertices[0] == vertices[3])
+                || (vertices[1] == vertices[2]) || (vertices[1] == vertices[3])
+                || !BoxesOverlap(edgeBoxes[0][edgeA], edgeBoxes[1][edgeB]))
+            {
+                continue;
+            }
+            ++tests;
+            if (FindContact(particles, vertices, true, thickness, &contact))
+            {
+                contacts->push_back(contact);
+            }
+        }
+    }
+    return tests;
+}
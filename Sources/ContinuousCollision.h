@@ -0,0 +1,111 @@
+#ifndef _CONTINUOUSCOLLISION_H_
+#define _CONTINUOUSCOLLISION_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : ContinuousCollision.h
+ *
+ * Creation Date : 10/17/2026 - 21:45
+ * Last Modified : 10/17/2026 - 21:45
+ * ==========================================================================================
+ * Description   : Continuous self-collision between the triangles of the cloth. Once per
+ *                 substep, after the solver iterations, every vertex-triangle and edge-edge pair
+ *                 is tested along its straight path from the start positions to the predicted
+ *                 ones: a pair collides if it comes within thickness of each other at one of the
+ *                 times its four points are coplanar, or at the end of the step. Colliding pairs
+ *                 are then held back to thickness apart (or as far as they started, if closer)
+ *                 along a normal taken on the side they started from, so the cloth does not pass
+ *                 through itself however fast it moves.
+ *                 There is one detection and a few Gauss-Seidel passes per substep: crowded
+ *                 contacts can be left partly unresolved, and a pair already through stays
+ *                 through.
+ *
+ *                 Candidate pairs come from a TriangleBvh over the swept triangles, refitted every
+ *                 substep and rebuilt only once refitting has loosened it past a threshold.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+#include <utility>
+#include "glm/glm.hpp"
+
+#include "AlignedArray.h"
+#include "TriangleBvh.h"
+
+
+struct Face;
+class ParticleStore;
+class ThreadPool;
+
+
+// A vertex-triangle or edge-edge contact: the constraint keeps dot(Normal, sum of Weights[i]
+// times the position of Vertices[i]) above Distance, the thickness or the pair's separation at
+// the start of the step if that was less. Vertex-triangle weights are 1 and minus the
+// barycentric coordinates, edge-edge ones (1 - s, s) and minus (1 - t, t).
+struct ContinuousContact
+{
+    unsigned int Vertices[4];
+    float Weights[4];
+    glm::vec3 Normal;
+    float Distance;
+};
+
+struct ContinuousCollisionStats
+{
+    // Counted over the last Step().
+    BvhQueryStats Query;
+    // Triangle pairs out of the tree, and vertex-triangle or edge-edge pairs of theirs whose swept
+    // boxes still overlap, each tested exactly.
+    unsigned int TrianglePairs = 0;
+    unsigned int FeatureTests = 0;
+    unsigned int Contacts = 0;
+    // Share of all the triangle pairs the tree culled, and its quality (see TriangleBvh).
+    float CullingEfficiency = 0.0f;
+    float Quality = 1.0f;
+    // Milliseconds the last Step() took, detection and response.
+    float Time = 0.0f;
+    // Counted since Build().
+    unsigned int Refits = 0;
+    unsigned int Rebuilds = 0;
+};
+
+
+class ContinuousCollisionSystem
+{
+
+public:
+    ContinuousCollisionSystem();
+
+    void Build(const std::vector<Face> &faces, unsigned int particleCount);
+    // Finds the collisions between the current and predicted positions and moves the predicted
+    // positions out of them.
+    void Step(ThreadPool *pool, float thickness, ParticleStore *particles);
+
+    const ContinuousCollisionStats &GetStats() const;
+    const std::vector<ContinuousContact> &GetContacts() const;
+    const TriangleBvh &GetBvh() const;
+
+
+private:
+    TriangleBvh bvh_;
+    // Every vertex and edge is tested only from the first face that has it, so a feature pair
+    // comes up in exactly one triangle pair. Bits 0-2 flag the face's vertices it owns, bits 3-5
+    // its edges (corner c to corner c + 1).
+    std::vector<unsigned char> owned_;
+    // Swept box of every vertex over the step, grown by half the thickness.
+    AlignedArray<float> vertexBoxes_;
+    std::vector<std::pair<unsigned int, unsigned int>> pairs_;
+    // One list per thread-pool chunk, concatenated in chunk order.
+    std::vector<std::vector<ContinuousContact>> chunkContacts_;
+    std::vector<unsigned int> chunkTests_;
+    std::vector<ContinuousContact> contacts_;
+    ContinuousCollisionStats stats_;
+
+    unsigned int TestTrianglePair(const ParticleStore &particles, unsigned int first, unsigned int second,
+                                  float thickness, std::vector<ContinuousContact> *contacts) const;
+
+};
+
+
+#endif // _CONTINUOUSCOLLISION_H_
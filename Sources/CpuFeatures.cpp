@@ -0,0 +1,151 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : CpuFeatures.cpp
+ *
+ * Creation Date : 10/17/2026 - 11:40
+ * Last Modified : 10/17/2026 - 11:40
+ * ==========================================================================================
+ * Description   : References:
+ *                 (1) Intel 64 and IA-32 Architectures Software Developer's Manual, Vol. 2A,
+ *                     CPUID and XGETBV.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <cstring>
+
+#include "CpuFeatures.h"
+
+#if CLOTH_SIMD_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+
+#if CLOTH_SIMD_X86
+
+static void
+Cpuid(unsigned int leaf, unsigned int subLeaf, unsigned int registers[4])
+{
+#if defined(_MSC_VER)
+    int values[4];
+    __cpuidex(values, (int)leaf, (int)subLeaf);
+    for (unsigned int index = 0; index < 4; ++index)
+    {
+        registers[index] = (unsigned int)values[index];
+    }
+#else
+    __cpuid_count(leaf, subLeaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+}
+
+static unsigned long long
+ReadXcr0()
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned int eax;
+    unsigned int edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((unsigned long long)edx << 32) | eax;
+#endif
+}
+
+static SimdLevel
+DetectSimdLevel()
+{
+    unsigned int registers[4];
+
+    Cpuid(0, 0, registers);
+    unsigned int maxLeaf = registers[0];
+    if (maxLeaf < 1)
+    {
+        return SIMD_SCALAR;
+    }
+
+    Cpuid(1, 0, registers);
+    bool hasSse41 = (registers[2] >> 19) & 1;
+    bool hasOsxsave = (registers[2] >> 27) & 1;
+    bool hasAvx = (registers[2] >> 28) & 1;
+    bool hasFma = (registers[2] >> 12) & 1;
+    if (!hasSse41)
+    {
+        return SIMD_SCALAR;
+    }
+    if (!hasOsxsave || !hasAvx || (maxLeaf < 7))
+    {
+        return SIMD_SSE;
+    }
+
+    // The OS has to save the YMM (bits 1-2) and ZMM/opmask (bits 5-7) state on context switch.
+    unsigned long long xcr0 = ReadXcr0();
+    bool osSavesYmm = (xcr0 & 0x6) == 0x6;
+    bool osSavesZmm = (xcr0 & 0xE6) == 0xE6;
+
+    Cpuid(7, 0, registers);
+    bool hasAvx2 = (registers[1] >> 5) & 1;
+    bool hasAvx512f = (registers[1] >> 16) & 1;
+
+    if (!osSavesYmm || !hasAvx2 || !hasFma)
+    {
+        return SIMD_SSE;
+    }
+    if (!osSavesZmm || !hasAvx512f)
+    {
+        return SIMD_AVX2;
+    }
+
+    return SIMD_AVX512;
+}
+
+#else
+
+static SimdLevel
+DetectSimdLevel()
+{
+    return SIMD_SCALAR;
+}
+
+#endif
+
+
+// FUNCTIONS
+// ---------
+
+SimdLevel
+GetSupportedSimdLevel()
+{
+    static const SimdLevel level = DetectSimdLevel();
+    return level;
+}
+
+const char *
+GetSimdLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+        case SIMD_SSE: return "sse";
+        case SIMD_AVX2: return "avx2";
+        case SIMD_AVX512: return "avx512";
+        default: return "scalar";
+    }
+}
+
+bool
+ParseSimdLevel(const char *name, SimdLevel *level)
+{
+    const SimdLevel levels[] = { SIMD_SCALAR, SIMD_SSE, SIMD_AVX2, SIMD_AVX512 };
+    for (unsigned int index = 0; index < 4; ++index)
+    {
+        if (!strcmp(name, GetSimdLevelName(levels[index])))
+        {
+            *level = levels[index];
+            return true;
+        }
+    }
+    return false;
+}
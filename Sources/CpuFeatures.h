@@ -0,0 +1,51 @@
+#ifndef _CPUFEATURES_H_
+#define _CPUFEATURES_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : CpuFeatures.h
+ *
+ * Creation Date : 10/17/2026 - 11:40
+ * Last Modified : 10/17/2026 - 11:40
+ * ==========================================================================================
+ * Description   : Runtime detection of the SIMD instruction sets the solver kernels can use.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CLOTH_SIMD_X86 1
+#else
+#define CLOTH_SIMD_X86 0
+#endif
+
+// MSVC lets any function use any intrinsic; GCC and Clang need the target spelled out on
+// each function that is compiled for a wider ISA than the rest of the file.
+#if CLOTH_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define CLOTH_TARGET_SSE __attribute__((target("sse4.1")))
+#define CLOTH_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define CLOTH_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define CLOTH_TARGET_SSE
+#define CLOTH_TARGET_AVX2
+#define CLOTH_TARGET_AVX512
+#endif
+
+
+enum SimdLevel : unsigned char
+{
+    SIMD_SCALAR,
+    SIMD_SSE,
+    SIMD_AVX2,
+    SIMD_AVX512
+};
+
+
+// Widest level supported by both the CPU and the OS (saved register state). Cached.
+SimdLevel GetSupportedSimdLevel();
+
+const char *GetSimdLevelName(SimdLevel level);
+bool ParseSimdLevel(const char *name, SimdLevel *level);
+
+
+#endif // _CPUFEATURES_H_
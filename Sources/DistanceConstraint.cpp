@@ -3,16 +3,16 @@
  * File Name     : DistanceConstraint.cpp
  *
  * Creation Date : 10/12/2017 - 16:40
- * Last Modified : 12/12/2017 - 20:39
+ * Last Modified : 10/17/2026 - 18:40
  * ==========================================================================================
  * Description   :
  *
  * Author        : Mehdi Rouijel
  * ========================================================================================== */
 
-#include <limits>
 #include "DistanceConstraint.h"
 #include "Mesh.h"
+#include "ParticleStore.h"
 
 
 DistanceConstraint::DistanceConstraint(Mesh *mesh, unsigned int index1, unsigned int index2, std::vector<unsigned int> *constraintCount)
@@ -28,50 +28,43 @@ DistanceConstraint::DistanceConstraint(Mesh *mesh, unsigned int index1, unsigned
     ++(*constraintCount)[index2];
 }
 
+DistanceConstraint::DistanceConstraint(unsigned int index1, unsigned int index2, float restLength)
+{
+    Vertex1Index = index1;
+    Vertex2Index = index2;
+    RestLength = restLength;
+}
+
 void
-DistanceConstraint::Solve(Mesh *mesh, std::vector<glm::vec3> *deltaPositions)
+DistanceConstraint::Solve(const ParticleStore &particles, float *deltaX, float *deltaY, float *deltaZ) const
 {
-    glm::vec3 p1 = mesh->Vertices[Vertex1Index].Position;
-    glm::vec3 p2 = mesh->Vertices[Vertex2Index].Position;
-    float w1 = mesh->InvMasses[Vertex2Index];
-    float w2 = mesh->InvMasses[Vertex2Index];
+    glm::vec3 p1 = particles.GetPredicted(Vertex1Index);
+    glm::vec3 p2 = particles.GetPredicted(Vertex2Index);
+    float w1 = particles.InvMass[Vertex1Index];
+    float w2 = particles.InvMass[Vertex2Index];
 
-    // "Hack to avoid division by 0"
-    if (w1 == std::numeric_limits<float>::infinity())
-    {
-        w1 = 0.0f;
-    }
-    if (w2 == std::numeric_limits<float>::infinity())
-    {
-        w2 = 0.0;
-    }
+    // Pinned particles have a zero inverse mass; only a constraint between two of them has
+    // nothing to correct.
     float sum = ((w1 + w2 == 0.0f) ? 0.000001f : (w1 + w2));
 
     float distance = glm::distance(p1, p2);
-    glm::vec3 delta;
-    float stiffness;
 
-    // This should damp the elasticity and vertices jumping around.
-    if (distance >= RestLength)
-    {
-        stiffness = 0.05f;
-    }
-    else
+    // Only stretched constraints are corrected (c.f. DISTANCE_STIFFNESS). Checking this before
+    // normalizing also keeps coincident particles from producing NaNs.
+    if (distance <= RestLength)
     {
-        stiffness = 0.0f;
+        return;
     }
 
-    delta = stiffness * 1.0f / sum * (distance - RestLength) * glm::normalize(p1 - p2);
-
-    glm::vec3 deltaP1 = glm::vec3(0.0f, 0.0f, 0.0f);
-    glm::vec3 deltaP2 = glm::vec3(0.0f, 0.0f, 0.0f);
-    if (delta != glm::vec3(0.0f, 0.0f, 0.0f))
-    {
-        deltaP1 = -delta;
-        deltaP2 = delta;
-    }
+    glm::vec3 delta = DISTANCE_STIFFNESS * 1.0f / sum * (distance - RestLength) * glm::normalize(p1 - p2);
+    glm::vec3 deltaP1 = -delta;
+    glm::vec3 deltaP2 = delta;
 
-    (*deltaPositions)[Vertex1Index] += w1 * deltaP1;
-    (*deltaPositions)[Vertex2Index] += w2 * deltaP2;
+    deltaX[Vertex1Index] += w1 * deltaP1.x;
+    deltaY[Vertex1Index] += w1 * deltaP1.y;
+    deltaZ[Vertex1Index] += w1 * deltaP1.z;
+    deltaX[Vertex2Index] += w2 * deltaP2.x;
+    deltaY[Vertex2Index] += w2 * deltaP2.y;
+    deltaZ[Vertex2Index] += w2 * deltaP2.z;
 }
 
@@ -6,7 +6,7 @@
  * File Name     : DistanceConstraint.h
  *
  * Creation Date : 10/12/2017 - 16:38
- * Last Modified : 11/12/2017 - 17:37
+ * Last Modified : 10/17/2026 - 18:40
  * ==========================================================================================
  * Description   :
  *
@@ -14,10 +14,18 @@
  * ========================================================================================== */
 
 #include <vector>
-#include "glm/fwd.hpp"
+#include "glm/glm.hpp"
 
 
 class Mesh;
+class ParticleStore;
+
+
+// Applied to stretched constraints only; compressed ones are left alone, which should damp the
+// elasticity and vertices jumping around.
+const float DISTANCE_STIFFNESS = 0.05f;
+// XPBD equivalent (inverse stiffness), used by SOLVER_XPBD instead of the stiffness above.
+const float DISTANCE_COMPLIANCE = 1e-7f;
 
 
 class DistanceConstraint
@@ -29,8 +37,12 @@ public:
     float RestLength;
 
     DistanceConstraint(Mesh *mesh, unsigned int index1, unsigned int index2, std::vector<unsigned int> *constraintCount);
+    // For constraints that are not mesh edges, e.g. between the particles of a coarse level.
+    DistanceConstraint(unsigned int index1, unsigned int index2, float restLength);
 
-    void Solve(Mesh *mesh, std::vector<glm::vec3> *deltaPositions);
+    // Scalar reference implementation. The solver itself goes through the batched kernels in
+    // DistanceKernels.h, which are checked against this.
+    void Solve(const ParticleStore &particles, float *deltaX, float *deltaY, float *deltaZ) const;
 
 };
 
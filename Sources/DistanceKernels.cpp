@@ -0,0 +1,485 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : DistanceKernels.cpp
+ *
+ * Creation Date : 10/17/2026 - 11:52
+ * Last Modified : 10/17/2026 - 17:20
+ * ==========================================================================================
+ * Description   : The math is the one of DistanceConstraint::Solve():
+ *                     correction = stiffness / (w1 + w2) * (|p1 - p2| - L) * (p1 - p2) / |p1 - p2|
+ *                 only applied when the constraint is stretched (|p1 - p2| > L).
+ *
+ *                 The XPBD variant replaces the stiffness with a compliance a (inverse
+ *                 stiffness) and a Lagrange multiplier per constraint:
+ *                     dLambda = (-C - a~ lambda) / (w1 + w2 + a~),  a~ = a / dt^2
+ *                 so the result no longer depends on the iteration count or time step. It
+ *                 projects in place and has no SIMD version yet.
+ *
+ *                 SSE has no gather, so it loads lanes one by one; AVX2 and AVX-512 use
+ *                 hardware gathers. AVX-512 also handles the tail with a lane mask and writes
+ *                 its output with compress-stores instead of walking the active lanes.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <cmath>
+
+#include "DistanceKernels.h"
+#include "DistanceConstraint.h"
+#include "ParticleStore.h"
+
+#if CLOTH_SIMD_X86
+#include <immintrin.h>
+#endif
+
+
+// STRUCTURES
+// ----------
+
+void
+DistanceConstraintBatch::Build(const std::vector<DistanceConstraint> &constraints, const ParticleStore &particles)
+{
+    Count = (unsigned int)constraints.size();
+
+    Index1.Resize(Count);
+    Index2.Resize(Count);
+    RestLength.Resize(Count);
+    InvWeightSum.Resize(Count);
+
+    for (unsigned int index = 0; index < Count; ++index)
+    {
+        Index1[index] = constraints[index].Vertex1Index;
+        Index2[index] = constraints[index].Vertex2Index;
+        RestLength[index] = constraints[index].RestLength;
+    }
+
+    UpdateWeights(particles);
+}
+
+void
+DistanceConstraintBatch::UpdateWeights(const ParticleStore &particles)
+{
+    for (unsigned int index = 0; index < Count; ++index)
+    {
+        float sum = particles.InvMass[Index1[index]] + particles.InvMass[Index2[index]];
+        InvWeightSum[index] = (sum > 0.0f) ? 1.0f / sum : 0.0f;
+    }
+}
+
+void
+DistanceCorrections::Resize(unsigned int constraintCount)
+{
+    Constraint.Resize(constraintCount);
+    X.Resize(constraintCount);
+    Y.Resize(constraintCount);
+    Z.Resize(constraintCount);
+}
+
+void
+DistanceResidual::Reset()
+{
+    Max = 0.0f;
+    SumSquares = 0.0;
+}
+
+void
+DistanceResidual::Merge(const DistanceResidual &other)
+{
+    Max = (other.Max > Max) ? other.Max : Max;
+    SumSquares += other.SumSquares;
+}
+
+
+// KERNELS
+// -------
+
+static inline bool
+SolveOne(const DistanceConstraintBatch &batch, unsigned int constraint, const ParticleStore &particles,
+         float stiffness, float *correctionX, float *correctionY, float *correctionZ)
+{
+    unsigned int i1 = batch.Index1[constraint];
+    unsigned int i2 = batch.Index2[constraint];
+    float dx = particles.PredictedX[i1] - particles.PredictedX[i2];
+    float dy = particles.PredictedY[i1] - particles.PredictedY[i2];
+    float dz = particles.PredictedZ[i1] - particles.PredictedZ[i2];
+    float distance = sqrtf(dx*dx + dy*dy + dz*dz);
+    float restLength = batch.RestLength[constraint];
+    float invWeightSum = batch.InvWeightSum[constraint];
+
+    if ((distance <= restLength) || (invWeightSum <= 0.0f))
+    {
+        return false;
+    }
+
+    float scale = stiffness * invWeightSum * (distance - restLength) / distance;
+    *correctionX = scale * dx;
+    *correctionY = scale * dy;
+    *correctionZ = scale * dz;
+
+    return true;
+}
+
+// Solves [begin, end) and appends the active constraints at out[written]. Returns the new end
+// of the output. Also used for the tails of the SSE and AVX2 kernels.
+static unsigned int
+SolveScalar(const DistanceConstraintBatch &batch, unsigned int begin, unsigned int end,
+            const ParticleStore &particles, float stiffness, DistanceCorrections *out, unsigned int written)
+{
+    for (unsigned int constraint = begin; constraint < end; ++constraint)
+    {
+        if (SolveOne(batch, constraint, particles, stiffness, &out->X[written], &out->Y[written], &out->Z[written]))
+        {
+            out->Constraint[written++] = constraint;
+        }
+    }
+    return written;
+}
+
+
+#if CLOTH_SIMD_X86
+
+static inline unsigned int
+LowestSetBit(unsigned int mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (unsigned int)index;
+#else
+    return (unsigned int)__builtin_ctz(mask);
+#endif
+}
+
+static inline unsigned int
+CountSetBits(unsigned int mask)
+{
+    unsigned int count = 0;
+    for (; mask; mask &= mask - 1)
+    {
+        ++count;
+    }
+    return count;
+}
+
+CLOTH_TARGET_SSE static unsigned int
+SolveSse(const DistanceConstraintBatch &batch, unsigned int begin, unsigned int end,
+         const ParticleStore &particles, float stiffness, DistanceCorrections *out)
+{
+    const unsigned int *index1 = batch.Index1.Data();
+    const unsigned int *index2 = batch.Index2.Data();
+    const float *px = particles.PredictedX.Data();
+    const float *py = particles.PredictedY.Data();
+    const float *pz = particles.PredictedZ.Data();
+    __m128 vStiffness = _mm_set1_ps(stiffness);
+    __m128 zero = _mm_setzero_ps();
+    __m128 one = _mm_set1_ps(1.0f);
+    alignas(16) float lanes[3][4];
+
+    unsigned int written = begin;
+    unsigned int constraint = begin;
+    for (; constraint + 4 <= end; constraint += 4)
+    {
+        const unsigned int *a = index1 + constraint;
+        const unsigned int *b = index2 + constraint;
+        __m128 dx = _mm_sub_ps(_mm_set_ps(px[a[3]], px[a[2]], px[a[1]], px[a[0]]),
+                               _mm_set_ps(px[b[3]], px[b[2]], px[b[1]], px[b[0]]));
+        __m128 dy = _mm_sub_ps(_mm_set_ps(py[a[3]], py[a[2]], py[a[1]], py[a[0]]),
+                               _mm_set_ps(py[b[3]], py[b[2]], py[b[1]], py[b[0]]));
+        __m128 dz = _mm_sub_ps(_mm_set_ps(pz[a[3]], pz[a[2]], pz[a[1]], pz[a[0]]),
+                               _mm_set_ps(pz[b[3]], pz[b[2]], pz[b[1]], pz[b[0]]));
+
+        __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+        __m128 restLength = _mm_loadu_ps(batch.RestLength.Data() + constraint);
+        __m128 invWeightSum = _mm_loadu_ps(batch.InvWeightSum.Data() + constraint);
+
+        __m128 active = _mm_and_ps(_mm_cmpgt_ps(distance, restLength), _mm_cmpgt_ps(invWeightSum, zero));
+        unsigned int mask = (unsigned int)_mm_movemask_ps(active);
+        if (!mask)
+        {
+            continue;
+        }
+
+        // Inactive lanes may have a zero distance: divide by 1 there instead.
+        __m128 safeDistance = _mm_blendv_ps(one, distance, active);
+        __m128 scale = _mm_div_ps(_mm_mul_ps(_mm_mul_ps(vStiffness, invWeightSum), _mm_sub_ps(distance, restLength)), safeDistance);
+        _mm_store_ps(lanes[0], _mm_mul_ps(scale, dx));
+        _mm_store_ps(lanes[1], _mm_mul_ps(scale, dy));
+        _mm_store_ps(lanes[2], _mm_mul_ps(scale, dz));
+
+        for (; mask; mask &= mask - 1)
+        {
+            unsigned int lane = LowestSetBit(mask);
+            out->Constraint[written] = constraint + lane;
+            out->X[written] = lanes[0][lane];
+            out->Y[written] = lanes[1][lane];
+            out->Z[written] = lanes[2][lane];
+            ++written;
+        }
+    }
+
+    written = SolveScalar(batch, constraint, end, particles, stiffness, out, written);
+    return written - begin;
+}
+
+CLOTH_TARGET_AVX2 static unsigned int
+SolveAvx2(const DistanceConstraintBatch &batch, unsigned int begin, unsigned int end,
+          const ParticleStore &particles, float stiffness, DistanceCorrections *out)
+{
+    const float *px = particles.PredictedX.Data();
+    const float *py = particles.PredictedY.Data();
+    const float *pz = particles.PredictedZ.Data();
+    __m256 vStiffness = _mm256_set1_ps(stiffness);
+    __m256 zero = _mm256_setzero_ps();
+    __m256 one = _mm256_set1_ps(1.0f);
+    alignas(32) float lanes[3][8];
+
+    unsigned int written = begin;
+    unsigned int constraint = begin;
+    for (; constraint + 8 <= end; constraint += 8)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(batch.Index1.Data() + constraint));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(batch.Index2.Data() + constraint));
+        __m256 dx = _mm256_sub_ps(_mm256_i32gather_ps(px, a, 4), _mm256_i32gather_ps(px, b, 4));
+        __m256 dy = _mm256_sub_ps(_mm256_i32gather_ps(py, a, 4), _mm256_i32gather_ps(py, b, 4));
+        __m256 dz = _mm256_sub_ps(_mm256_i32gather_ps(pz, a, 4), _mm256_i32gather_ps(pz, b, 4));
+
+        __m256 distance = _mm256_sqrt_ps(_mm256_fmadd_ps(dz, dz, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dx, dx))));
+        __m256 restLength = _mm256_loadu_ps(batch.RestLength.Data() + constraint);
+        __m256 invWeightSum = _mm256_loadu_ps(batch.InvWeightSum.Data() + constraint);
+
+        __m256 active = _mm256_and_ps(_mm256_cmp_ps(distance, restLength, _CMP_GT_OQ),
+                                      _mm256_cmp_ps(invWeightSum, zero, _CMP_GT_OQ));
+        unsigned int mask = (unsigned int)_mm256_movemask_ps(active);
+        if (!mask)
+        {
+            continue;
+        }
+
+        __m256 safeDistance = _mm256_blendv_ps(one, distance, active);
+        __m256 scale = _mm256_div_ps(_mm256_mul_ps(_mm256_mul_ps(vStiffness, invWeightSum), _mm256_sub_ps(distance, restLength)), safeDistance);
+        _mm256_store_ps(lanes[0], _mm256_mul_ps(scale, dx));
+        _mm256_store_ps(lanes[1], _mm256_mul_ps(scale, dy));
+        _mm256_store_ps(lanes[2], _mm256_mul_ps(scale, dz));
+
+        for (; mask; mask &= mask - 1)
+        {
+            unsigned int lane = LowestSetBit(mask);
+            out->Constraint[written] = constraint + lane;
+            out->X[written] = lanes[0][lane];
+            out->Y[written] = lanes[1][lane];
+            out->Z[written] = lanes[2][lane];
+            ++written;
+        }
+    }
+
+    written = SolveScalar(batch, constraint, end, particles, stiffness, out, written);
+    return written - begin;
+}
+
+CLOTH_TARGET_AVX512 static unsigned int
+SolveAvx512(const DistanceConstraintBatch &batch, unsigned int begin, unsigned int end,
+            const ParticleStore &particles, float stiffness, DistanceCorrections *out)
+{
+    const float *px = particles.PredictedX.Data();
+    const float *py = particles.PredictedY.Data();
+    const float *pz = particles.PredictedZ.Data();
+    __m512 vStiffness = _mm512_set1_ps(stiffness);
+    __m512 zero = _mm512_setzero_ps();
+    __m512 one = _mm512_set1_ps(1.0f);
+    __m512i laneOffsets = _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+
+    unsigned int written = begin;
+    for (unsigned int constraint = begin; constraint < end; constraint += 16)
+    {
+        // Last iteration: only the lanes below end are loaded, gathered and considered.
+        __mmask16 lanes = (end - constraint >= 16) ? (__mmask16)0xFFFF : (__mmask16)((1u << (end - constraint)) - 1);
+
+        __m512i a = _mm512_maskz_loadu_epi32(lanes, batch.Index1.Data() + constraint);
+        __m512i b = _mm512_maskz_loadu_epi32(lanes, batch.Index2.Data() + constraint);
+        __m512 dx = _mm512_sub_ps(_mm512_mask_i32gather_ps(zero, lanes, a, px, 4), _mm512_mask_i32gather_ps(zero, lanes, b, px, 4));
+        __m512 dy = _mm512_sub_ps(_mm512_mask_i32gather_ps(zero, lanes, a, py, 4), _mm512_mask_i32gather_ps(zero, lanes, b, py, 4));
+        __m512 dz = _mm512_sub_ps(_mm512_mask_i32gather_ps(zero, lanes, a, pz, 4), _mm512_mask_i32gather_ps(zero, lanes, b, pz, 4));
+
+        __m512 distance = _mm512_maskz_sqrt_ps(lanes, _mm512_fmadd_ps(dz, dz, _mm512_fmadd_ps(dy, dy, _mm512_mul_ps(dx, dx))));
+        __m512 restLength = _mm512_maskz_loadu_ps(lanes, batch.RestLength.Data() + constraint);
+        __m512 invWeightSum = _mm512_maskz_loadu_ps(lanes, batch.InvWeightSum.Data() + constraint);
+
+        __mmask16 active = lanes &
+                           _mm512_cmp_ps_mask(distance, restLength, _CMP_GT_OQ) &
+                           _mm512_cmp_ps_mask(invWeightSum, zero, _CMP_GT_OQ);
+        if (!active)
+        {
+            continue;
+        }
+
+        __m512 safeDistance = _mm512_mask_blend_ps(active, one, distance);
+        __m512 scale = _mm512_div_ps(_mm512_mul_ps(_mm512_mul_ps(vStiffness, invWeightSum), _mm512_sub_ps(distance, restLength)), safeDistance);
+
+        __m512i ids = _mm512_add_epi32(_mm512_set1_epi32((int)constraint), laneOffsets);
+        _mm512_mask_compressstoreu_epi32(out->Constraint.Data() + written, active, ids);
+        _mm512_mask_compressstoreu_ps(out->X.Data() + written, active, _mm512_mul_ps(scale, dx));
+        _mm512_mask_compressstoreu_ps(out->Y.Data() + written, active, _mm512_mul_ps(scale, dy));
+        _mm512_mask_compressstoreu_ps(out->Z.Data() + written, active, _mm512_mul_ps(scale, dz));
+        written += CountSetBits(active);
+    }
+
+    return written - begin;
+}
+
+#endif
+
+
+// FUNCTIONS
+// ---------
+
+unsigned int
+SolveDistanceConstraints(SimdLevel level,
+                         const DistanceConstraintBatch &batch,
+                         unsigned int begin,
+                         unsigned int end,
+                         const ParticleStore &particles,
+                         float stiffness,
+                         DistanceCorrections *corrections)
+{
+#if CLOTH_SIMD_X86
+    switch (level)
+    {
+        case SIMD_AVX512: return SolveAvx512(batch, begin, end, particles, stiffness, corrections);
+        case SIMD_AVX2: return SolveAvx2(batch, begin, end, particles, stiffness, corrections);
+        case SIMD_SSE: return SolveSse(batch, begin, end, particles, stiffness, corrections);
+        default: break;
+    }
+#endif
+    return SolveScalar(batch, begin, end, particles, stiffness, corrections, begin) - begin;
+}
+
+float
+CompareDistanceKernel(SimdLevel level,
+                      const std::vector<DistanceConstraint> &constraints,
+                      const DistanceConstraintBatch &batch,
+                      const ParticleStore &particles)
+{
+    unsigned int particleCount = particles.GetCount();
+    AlignedArray<float> reference[3] = { AlignedArray<float>(particleCount), AlignedArray<float>(particleCount), AlignedArray<float>(particleCount) };
+    AlignedArray<float> tested[3] = { AlignedArray<float>(particleCount), AlignedArray<float>(particleCount), AlignedArray<float>(particleCount) };
+
+    for (auto constraintIt = constraints.begin(); constraintIt != constraints.end(); ++constraintIt)
+    {
+        constraintIt->Solve(particles, reference[0].Data(), reference[1].Data(), reference[2].Data());
+    }
+
+    DistanceCorrections corrections;
+    corrections.Resize(batch.Count);
+    unsigned int count = SolveDistanceConstraints(level, batch, 0, batch.Count, particles, DISTANCE_STIFFNESS, &corrections);
+    ScatterDistanceCorrections(batch, corrections, 0, count, particles, tested[0].Data(), tested[1].Data(), tested[2].Data());
+
+    float maxDifference = 0.0f;
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+        for (unsigned int index = 0; index < particleCount; ++index)
+        {
+            float difference = fabsf(reference[axis][index] - tested[axis][index]);
+            maxDifference = (difference > maxDifference) ? difference : maxDifference;
+        }
+    }
+
+    return maxDifference;
+}
+
+void
+ScatterDistanceCorrections(const DistanceConstraintBatch &batch,
+                           const DistanceCorrections &corrections,
+                           unsigned int begin,
+                           unsigned int count,
+                           const ParticleStore &particles,
+                           float *deltaX,
+                           float *deltaY,
+                           float *deltaZ)
+{
+    for (unsigned int entry = begin; entry < begin + count; ++entry)
+    {
+        unsigned int constraint = corrections.Constraint[entry];
+        unsigned int i1 = batch.Index1[constraint];
+        unsigned int i2 = batch.Index2[constraint];
+        float w1 = particles.InvMass[i1];
+        float w2 = particles.InvMass[i2];
+
+        deltaX[i1] -= w1 * corrections.X[entry];
+        deltaY[i1] -= w1 * corrections.Y[entry];
+        deltaZ[i1] -= w1 * corrections.Z[entry];
+        deltaX[i2] += w2 * corrections.X[entry];
+        deltaY[i2] += w2 * corrections.Y[entry];
+        deltaZ[i2] += w2 * corrections.Z[entry];
+    }
+}
+
+void
+MeasureDistanceResidual(const DistanceConstraintBatch &batch,
+                        const DistanceCorrections &corrections,
+                        unsigned int begin,
+                        unsigned int count,
+                        float stiffness,
+                        DistanceResidual *residual)
+{
+    // |correction| = stiffness / (w1 + w2) * (|p1 - p2| - L)
+    for (unsigned int entry = begin; entry < begin + count; ++entry)
+    {
+        unsigned int constraint = corrections.Constraint[entry];
+        float length = sqrtf(corrections.X[entry]*corrections.X[entry] +
+                             corrections.Y[entry]*corrections.Y[entry] +
+                             corrections.Z[entry]*corrections.Z[entry]);
+        float stretch = length / (stiffness * batch.InvWeightSum[constraint] * fmaxf(batch.RestLength[constraint], 1e-6f));
+
+        residual->Max = fmaxf(residual->Max, stretch);
+        residual->SumSquares += (double)(stretch * stretch);
+    }
+}
+
+void
+SolveDistanceConstraintsXpbd(const DistanceConstraintBatch &batch,
+                             unsigned int begin,
+                             unsigned int end,
+                             const float *compliance,
+                             float timeStep,
+                             ParticleStore *particles,
+                             float *lambda,
+                             DistanceResidual *residual)
+{
+    float *px = particles->PredictedX.Data();
+    float *py = particles->PredictedY.Data();
+    float *pz = particles->PredictedZ.Data();
+    const float *w = particles->InvMass.Data();
+    float inverseTimeStepSquared = 1.0f / (timeStep * timeStep);
+
+    for (unsigned int constraint = begin; constraint < end; ++constraint)
+    {
+        unsigned int i1 = batch.Index1[constraint];
+        unsigned int i2 = batch.Index2[constraint];
+        float dx = px[i1] - px[i2];
+        float dy = py[i1] - py[i2];
+        float dz = pz[i1] - pz[i2];
+        float distance = sqrtf(dx*dx + dy*dy + dz*dz);
+        float weightSum = w[i1] + w[i2];
+        float alpha = compliance[constraint] * inverseTimeStepSquared;
+
+        if ((distance <= batch.RestLength[constraint]) || (weightSum + alpha <= 0.0f))
+        {
+            continue;
+        }
+
+        float stretch = (distance - batch.RestLength[constraint]) / fmaxf(batch.RestLength[constraint], 1e-6f);
+        residual->Max = fmaxf(residual->Max, stretch);
+        residual->SumSquares += (double)(stretch * stretch);
+
+        float deltaLambda = (batch.RestLength[constraint] - distance - alpha * lambda[constraint]) / (weightSum + alpha);
+        lambda[constraint] += deltaLambda;
+
+        float scale = deltaLambda / distance;
+        px[i1] += w[i1] * scale * dx;
+        py[i1] += w[i1] * scale * dy;
+        pz[i1] += w[i1] * scale * dz;
+        px[i2] -= w[i2] * scale * dx;
+        py[i2] -= w[i2] * scale * dy;
+        pz[i2] -= w[i2] * scale * dz;
+    }
+}
@@ -0,0 +1,120 @@
+#ifndef _DISTANCEKERNELS_H_
+#define _DISTANCEKERNELS_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : DistanceKernels.h
+ *
+ * Creation Date : 10/17/2026 - 11:52
+ * Last Modified : 10/17/2026 - 17:20
+ * ==========================================================================================
+ * Description   : Batched distance-constraint projection.
+ *                 Constraints are packed into index / rest-length / weight arrays and solved
+ *                 4 (SSE), 8 (AVX2) or 16 (AVX-512) at a time. Each kernel writes the
+ *                 correction of every active constraint (stretched, not fully pinned) into a
+ *                 compacted list, which is then scattered onto the particles.
+ *
+ *                 DistanceConstraint::Solve() stays the scalar reference implementation.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+
+#include "AlignedArray.h"
+#include "CpuFeatures.h"
+
+
+class DistanceConstraint;
+class ParticleStore;
+
+
+struct DistanceConstraintBatch
+{
+    AlignedArray<unsigned int> Index1;
+    AlignedArray<unsigned int> Index2;
+    AlignedArray<float> RestLength;
+    // 1 / (w1 + w2), or 0 when both ends are pinned.
+    AlignedArray<float> InvWeightSum;
+    unsigned int Count = 0;
+
+    void Build(const std::vector<DistanceConstraint> &constraints, const ParticleStore &particles);
+    void UpdateWeights(const ParticleStore &particles);
+};
+
+// Compacted output of a kernel call over [begin, end): entries [begin, begin + returned count)
+// hold the active constraints and their correction (before the per-particle inverse mass).
+struct DistanceCorrections
+{
+    AlignedArray<unsigned int> Constraint;
+    AlignedArray<float> X;
+    AlignedArray<float> Y;
+    AlignedArray<float> Z;
+
+    void Resize(unsigned int constraintCount);
+};
+
+// Constraint error in relative stretch, (|p1 - p2| - L) / L. Compressed constraints are
+// satisfied (the constraints only resist stretching) and count as 0.
+struct DistanceResidual
+{
+    float Max = 0.0f;
+    double SumSquares = 0.0;
+
+    void Reset();
+    void Merge(const DistanceResidual &other);
+};
+
+
+// Returns the number of active constraints written at corrections[begin].
+unsigned int SolveDistanceConstraints(SimdLevel level,
+                                      const DistanceConstraintBatch &batch,
+                                      unsigned int begin,
+                                      unsigned int end,
+                                      const ParticleStore &particles,
+                                      float stiffness,
+                                      DistanceCorrections *corrections);
+
+// Adds -w1 * correction to the first particle and +w2 * correction to the second.
+void ScatterDistanceCorrections(const DistanceConstraintBatch &batch,
+                                const DistanceCorrections &corrections,
+                                unsigned int begin,
+                                unsigned int count,
+                                const ParticleStore &particles,
+                                float *deltaX,
+                                float *deltaY,
+                                float *deltaZ);
+
+// Adds the error of the active constraints in corrections[begin, begin + count) (as returned by
+// SolveDistanceConstraints() with the same stiffness) to residual. Recovered from the corrections
+// so the kernels do not need a second output.
+void MeasureDistanceResidual(const DistanceConstraintBatch &batch,
+                             const DistanceCorrections &corrections,
+                             unsigned int begin,
+                             unsigned int count,
+                             float stiffness,
+                             DistanceResidual *residual);
+
+// XPBD projection of [begin, end), written straight into the predicted positions, so the range
+// must not contain two constraints sharing a vertex (one color). compliance and lambda are
+// indexed like the batch; lambda accumulates across the iterations of one (sub)step.
+// Like the PBD path, only stretched constraints are projected. The error of each constraint,
+// before its projection, is added to residual.
+void SolveDistanceConstraintsXpbd(const DistanceConstraintBatch &batch,
+                                  unsigned int begin,
+                                  unsigned int end,
+                                  const float *compliance,
+                                  float timeStep,
+                                  ParticleStore *particles,
+                                  float *lambda,
+                                  DistanceResidual *residual);
+
+// Differential check of one kernel against DistanceConstraint::Solve() on the current predicted
+// positions. Returns the largest absolute difference in the accumulated per-particle corrections.
+float CompareDistanceKernel(SimdLevel level,
+                            const std::vector<DistanceConstraint> &constraints,
+                            const DistanceConstraintBatch &batch,
+                            const ParticleStore &particles);
+
+
+#endif // _DISTANCEKERNELS_H_
@@ -0,0 +1,1063 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : ClothHeadless.cpp
+ *
+ * Creation Date : 10/17/2026 - 09:40
+ * Last Modified : 10/18/2026 - 11:40
+ * ==========================================================================================
+ * Description   : Headless driver for ClothSolver. No window, no GL context: the solver is
+ *                 stepped at full CPU throughput and timings are printed to stdout.
+ *
+ *                 Usage: ClothHeadless [-obj path] [-grid n] [-frames n] [-dt seconds]
+ *                                      [-iterations n] [-simd scalar|sse|avx2|avx512]
+ *                                      [-solver jacobi|gauss-seidel|xpbd|pd|implicit|vbd]
+ *                                      [-threads n] [-substeps n] [-compliance c]
+ *                                      [-pd-stiffness k] [-spring-stiffness k]
+ *                                      [-spring-damping d] [-vbd-stiffness k]
+ *                                      [-quadratic-bending] [-bending-stiffness s]
+ *                                      [-bending-compliance c] [-strain] [-strain-only]
+ *                                      [-strain-stiffness warp,weft,shear]
+ *                                      [-strain-compliance warp,weft,shear]
+ *                                      [-self-collision] [-thickness t]
+ *                                      [-cache-interval n] [-cache-skin s]
+ *                                      [-ccd] [-ccd-thickness t] [-fold]
+ *                                      [-ground] [-props] [-drop] [-friction f]
+ *                                      [-collider-thickness t] [-sdf path] [-bake-sdf path]
+ *                                      [-sdf-resolution n]
+ *                                      [-adaptive tolerance] [-min-iterations n] [-budget ms]
+ *                                      [-tethers] [-tether-slack s] [-stretch-sweep]
+ *                                      [-levels n] [-coarse-iterations n]
+ *                                      [-chebyshev rho] [-shear] [-bend] [-verify]
+ *                                      [-reorder none|morton|rcm] [-shuffle] [-realtime seconds]
+ *                                      [-interpolate none|linear|hermite]
+ *
+ *                 -reorder runs the frames twice, on the original vertex order and then on the
+ *                 reordered one, and prints the step time and cache misses of both. -shuffle
+ *                 randomly renumbers the vertices first, like a badly ordered import.
+ *                 -realtime runs the solver on a SimulationThread at 1/dt steps per second for
+ *                 the given wall-clock time, polled by a 144 Hz fake render loop, instead of
+ *                 stepping as fast as possible. The render loop blends the published states
+ *                 with -interpolate (linear by default).
+ *                 -adaptive stops iterating once the max relative stretch is below the
+ *                 tolerance; -iterations is then the maximum. -budget gives every step a
+ *                 wall-clock budget and lets the solver plan its iterations to fit it.
+ *
+ *                 -tethers adds long-range attachments to the pins. -stretch-sweep runs the
+ *                 frames for 1 to 32 iterations, without and with tethers, and prints the
+ *                 stretch of the mesh edges at the end of each run. -levels adds up to n
+ *                 coarse levels (hierarchical PBD).
+ *
+ *                 -solver pd is Projective Dynamics; the size of its factorization is printed
+ *                 after the run. -solver implicit is backward Euler on springs, whose stiffness
+ *                 and damping are set with -spring-stiffness and -spring-damping; its
+ *                 iterations are conjugate gradient iterations. -solver vbd is Vertex Block
+ *                 Descent; -chebyshev accelerates it too, but diverges above a rho of about
+ *                 0.5 there.
+ *
+ *                 -quadratic-bending adds isometric bending to the position-based solvers
+ *                 (unlike -bend, which adds distance constraints across every straight pair of
+ *                 edges).
+ *
+ *                 -strain adds stretch and shear on the triangles (FEM strain, with warp and
+ *                 weft along the UVs) to the position-based solvers. -strain-only also drops the
+ *                 distance constraints, whatever the edge options, so the triangles are the only
+ *                 stretch constraints; the residuals then measure their warp and weft stretch.
+ *
+ *                 -self-collision keeps the particles -thickness apart (half the mean edge
+ *                 length by default); the pairs found in the last step and the time spent
+ *                 finding them are printed after the run. Its hash search can be cached for
+ *                 -cache-interval substeps (1 by default, searching every substep) with a skin
+ *                 of -cache-skin (a quarter of the mean edge length by default); the share of
+ *                 the substeps that reused it and the time that saved against searching every
+ *                 substep without the skin are printed too.
+ *
+ *                 -ccd adds continuous triangle self-collision, keeping the faces and edges
+ *                 -ccd-thickness apart (a tenth of the mean edge length by default); the BVH
+ *                 refits and rebuilds, the share of triangle pairs it culled and the contacts of
+ *                 the last step are printed after the run. -fold gathers the pins to a fifth of
+ *                 their width over the first two seconds, which folds the cloth onto itself.
+ *
+ *                 -ground adds the ground plane of the interactive scene (y = -4) as a collider,
+ *                 and -props a sphere, a capsule and a box on it; -drop unpins the cloth so it
+ *                 falls onto them. -friction sets the colliders' friction coefficient (0.5 by
+ *                 default) and -collider-thickness the distance the cloth keeps from them (a
+ *                 tenth of the mean edge length by default). The contacts and the time spent
+ *                 resolving them in the last step are printed after the run.
+ *
+ *                 -sdf loads a model and stands it on the ground (or where the ground would be)
+ *                 as a signed distance field collider, -sdf-resolution nodes along its longest
+ *                 side. The field is read from path.sdf if it was baked from the same model and
+ *                 settings, and voxelized and written there otherwise. -bake-sdf only writes
+ *                 path.sdf and exits, for fields baked offline.
+ *
+ *                 -verify checks every supported SIMD kernel against the scalar reference
+ *                 on the final state.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+#include <algorithm>
+#include <random>
+#include <thread>
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "../Model.h"
+#include "../ClothSolver.h"
+#include "../MeshOptimizer.h"
+#include "../SignedDistanceField.h"
+#include "../SimulationThread.h"
+#include "../StateInterpolator.h"
+#include "PerfCounter.h"
+
+
+struct HeadlessOptions
+{
+    std::string ModelPath = "../Assets/cloth.obj";
+    unsigned int GridSize = 0;
+    unsigned int Frames = 600;
+    unsigned int Iterations = 5;
+    float DeltaTime = 1.0f / 60.0f;
+    SimdLevel Simd = SIMD_AVX512;
+    SolverMode Mode = SOLVER_JACOBI;
+    unsigned int Substeps = 1;
+    float Compliance = DISTANCE_COMPLIANCE;
+    // 0 (-1 for damping and compliance) keeps the solver's default.
+    float ProjectiveStiffness = 0.0f;
+    float SpringStiffness = 0.0f;
+    float SpringDamping = -1.0f;
+    float BlockDescentStiffness = 0.0f;
+    bool Bending = false;
+    float BendingStiffness = 0.0f;
+    float BendingCompliance = -1.0f;
+    bool Strain = false;
+    bool StrainOnly = false;
+    // Negative keeps the solver's default.
+    glm::vec3 StrainStiffness = glm::vec3(-1.0f);
+    glm::vec3 StrainCompliance = glm::vec3(-1.0f);
+    bool SelfCollision = false;
+    // 0 (-1 for the cache skin) keeps the solver's default.
+    float Thickness = 0.0f;
+    unsigned int CacheInterval = 0;
+    float CacheSkin = -1.0f;
+    bool ContinuousCollision = false;
+    float ContinuousThickness = 0.0f;
+    bool Fold = false;
+    bool Ground = false;
+    bool Props = false;
+    bool Drop = false;
+    float Friction = 0.5f;
+    float ColliderThickness = 0.0f;
+    std::string FieldPath;
+    bool BakeField = false;
+    unsigned int FieldResolution = SDF_RESOLUTION;
+    // Loaded from FieldPath by main(), before any solver is configured.
+    const SignedDistanceField *Field = nullptr;
+    float Tolerance = 0.0f;
+    unsigned int MinIterations = 1;
+    float TimeBudget = 0.0f;
+    bool Tethers = false;
+    float TetherSlack = 1.0f;
+    bool StretchSweep = false;
+    unsigned int HierarchyLevels = 0;
+    unsigned int CoarseIterations = 2;
+    unsigned int Threads = 0;
+    float ChebyshevRho = 0.0f;
+    unsigned int EdgeFlags = EDGES_STRUCTURAL;
+    bool Verify = false;
+    VertexOrdering Reorder = VERTEX_ORDER_NONE;
+    bool Shuffle = false;
+    float RealTime = 0.0f;
+    InterpolationMode Interpolation = INTERPOLATION_LINEAR;
+};
+
+struct RunResult
+{
+    double TotalMs = 0.0;
+    uint64_t CacheMisses = 0;
+    uint64_t Iterations = 0;
+    unsigned int OverBudgetCount = 0;
+    float MaxStepTime = 0.0f;
+    SolverStats LastStats;
+};
+
+// Seconds of simulated time -fold takes to gather the pins.
+const float FOLD_TIME = 2.0f;
+
+// Height of the ground plane in the interactive scene.
+const float GROUND_HEIGHT = -4.0f;
+
+// Where -sdf stands the model, on the ground under the cloth.
+const glm::vec3 FIELD_POSITION = glm::vec3(0.0f, GROUND_HEIGHT, 0.5f);
+
+
+// PROTOTYPES
+// ----------
+
+bool ParseOptions(int argc, char **argv, HeadlessOptions *options);
+Mesh BuildGridMesh(unsigned int gridSize, std::vector<unsigned int> *topRow);
+void ApplyOrder(Mesh *mesh, const std::vector<unsigned int> &order, std::vector<unsigned int> *pinned);
+void ConfigureSolver(ClothSolver *solver, const HeadlessOptions &options);
+bool LoadField(const HeadlessOptions &options, SignedDistanceField *field);
+RunResult RunFrames(ClothSolver *solver, const HeadlessOptions &options, CacheMissCounter *counter);
+void RunStretchSweep(const Mesh &mesh, const std::vector<unsigned int> &pinned, HeadlessOptions options);
+void MeasureStretch(const ClothSolver &solver, const Mesh &mesh, float *maxStretch, float *meanStretch);
+void RunRealTime(ClothSolver *solver, Mesh *mesh, const HeadlessOptions &options);
+void PrintLayout(const char *name, const Mesh &mesh, const RunResult &result, unsigned int frames, bool countersAvailable);
+
+
+// ENTRY POINT
+// -----------
+
+int
+main(int argc, char **argv)
+{
+    HeadlessOptions options;
+    if (!ParseOptions(argc, argv, &options))
+    {
+        std::cout << "Usage: ClothHeadless [-obj path] [-grid n] [-frames n] [-dt seconds] [-iterations n]"
+                  << " [-simd scalar|sse|avx2|avx512] [-solver jacobi|gauss-seidel|xpbd|pd|implicit|vbd]"
+                  << " [-threads n] [-substeps n] [-compliance c] [-pd-stiffness k] [-spring-stiffness k]"
+                  << " [-spring-damping d] [-vbd-stiffness k] [-quadratic-bending] [-bending-stiffness s]"
+                  << " [-bending-compliance c] [-strain] [-strain-only] [-strain-stiffness warp,weft,shear]"
+                  << " [-strain-compliance warp,weft,shear] [-self-collision] [-thickness t]"
+                  << " [-cache-interval n] [-cache-skin s]"
+                  << " [-ccd] [-ccd-thickness t] [-fold]"
+                  << " [-ground] [-props] [-drop] [-friction f] [-collider-thickness t]"
+                  << " [-sdf path] [-bake-sdf path] [-sdf-resolution n]"
+                  << " [-adaptive tolerance] [-min-iterations n]"
+                  << " [-budget ms] [-tethers] [-tether-slack s] [-stretch-sweep]"
+                  << " [-levels n] [-coarse-iterations n]"
+                  << " [-chebyshev rho] [-shear] [-bend] [-verify] [-reorder none|morton|rcm] [-shuffle]"
+                  << " [-realtime seconds] [-interpolate none|linear|hermite]"
+                  << std::endl;
+        return -1;
+    }
+
+    SignedDistanceField field;
+    if (!options.FieldPath.empty())
+    {
+        if (!LoadField(options, &field))
+        {
+            return -1;
+        }
+        if (options.BakeField)
+        {
+            return 0;
+        }
+        options.Field = &field;
+    }
+
+    // Created before any solver so it also counts the pool's worker threads.
+    CacheMissCounter cacheMisses;
+    std::vector<Mesh> meshes;
+    std::vector<unsigned int> pinned;
+
+    if (options.GridSize > 0)
+    {
+        meshes.push_back(BuildGridMesh(options.GridSize, &pinned));
+    }
+    else
+    {
+        Model cloth(options.ModelPath);
+        if (cloth.Meshes.empty())
+        {
+            std::cout << "Failed to load " << options.ModelPath << std::endl;
+            return -1;
+        }
+        meshes.push_back(cloth.Meshes[0]);
+        pinned = cloth.TopRow;
+    }
+
+    Mesh *mesh = &meshes[0];
+    mesh->BuildConstraints(options.StrainOnly ? 0 : options.EdgeFlags);
+
+    if (options.Shuffle)
+    {
+        std::vector<unsigned int> order(mesh->Vertices.size());
+        for (unsigned int index = 0; index < order.size(); ++index)
+        {
+            order[index] = index;
+        }
+        std::shuffle(order.begin(), order.end(), std::mt19937(1234));
+        ApplyOrder(mesh, order, &pinned);
+    }
+
+    if (options.StretchSweep)
+    {
+        RunStretchSweep(*mesh, pinned, options);
+        return 0;
+    }
+
+    if (options.Reorder != VERTEX_ORDER_NONE)
+    {
+        ClothSolver baseline(*mesh, pinned, options.Iterations, options.Threads);
+        ConfigureSolver(&baseline, options);
+        PrintLayout("original", *mesh, RunFrames(&baseline, options, &cacheMisses), options.Frames,
+                    cacheMisses.IsAvailable());
+
+        auto reorderStart = std::chrono::steady_clock::now();
+        ApplyOrder(mesh, ComputeVertexOrder(*mesh, options.Reorder), &pinned);
+        auto reorderEnd = std::chrono::steady_clock::now();
+        std::cout << "Reorder     : "
+                  << std::chrono::duration<double, std::milli>(reorderEnd - reorderStart).count() << " ms" << std::endl;
+    }
+
+    auto setupStart = std::chrono::steady_clock::now();
+    ClothSolver solver(*mesh, pinned, options.Iterations, options.Threads);
+    ConfigureSolver(&solver, options);
+    auto setupEnd = std::chrono::steady_clock::now();
+
+    std::cout << "SIMD        : " << GetSimdLevelName(solver.GetSimdLevel()) << std::endl;
+    std::cout << "Threads     : " << solver.GetThreadCount() << std::endl;
+    std::cout << "Particles   : " << solver.GetVertexCount() << std::endl;
+    std::cout << "Constraints : " << mesh->DistConstraints.size() << std::endl;
+    std::cout << "Setup       : "
+              << std::chrono::duration<double, std::milli>(setupEnd - setupStart).count() << " ms" << std::endl;
+    solver.GetColoring().PrintReport(std::cout);
+    if (options.Mode == SOLVER_BLOCK_DESCENT)
+    {
+        std::cout << "Vertex colors: " << solver.GetVertexColoring().GetColorCount()
+                  << " (imbalance " << solver.GetVertexColoring().GetImbalance() << ")" << std::endl;
+    }
+    if (options.Strain)
+    {
+        std::cout << "Triangles   : " << solver.GetTriangleColoring().Order.size() << " ("
+                  << solver.GetTriangleColoring().GetColorCount() << " colors)" << std::endl;
+    }
+    const ParticleHierarchy &hierarchy = solver.GetHierarchy();
+    for (auto levelIt = hierarchy.Levels.begin(); levelIt != hierarchy.Levels.end(); ++levelIt)
+    {
+        std::cout << "Coarse level: " << levelIt->Particles.size() << " particles, " << levelIt->Batch.Count
+                  << " constraints, " << levelIt->Coloring.GetColorCount() << " colors" << std::endl;
+    }
+
+    if (options.RealTime > 0.0f)
+    {
+        RunRealTime(&solver, mesh, options);
+        return 0;
+    }
+
+    RunResult result = RunFrames(&solver, options, &cacheMisses);
+    double totalMs = result.TotalMs;
+    solver.WriteTo(mesh);
+
+    PrintLayout(GetVertexOrderingName(options.Reorder), *mesh, result, options.Frames, cacheMisses.IsAvailable());
+    if (options.Tethers)
+    {
+        std::cout << "Tethers     : " << solver.GetTetherCount() << std::endl;
+    }
+    if (options.SelfCollision)
+    {
+        std::cout << "Contacts    : " << result.LastStats.Contacts << " pairs, "
+                  << result.LastStats.CollisionTime << " ms to find (last step)" << std::endl;
+        const ContactCacheStats &cache = solver.GetSelfCollision().GetCacheStats();
+        std::cout << "Contact cache: " << 100.0f * cache.HitRate << "% hits (" << cache.Hits << " of "
+                  << cache.Detections << " substeps), " << cache.TimeSaved << " ms saved (searches "
+                  << cache.SearchTime << " ms, hits " << cache.HitTime << " ms, "
+                  << cache.PlainSearchTime << " ms per search without the skin)" << std::endl;
+    }
+    if (options.ContinuousCollision)
+    {
+        const ContinuousCollisionStats &ccd = solver.GetContinuousCollision().GetStats();
+        std::cout << "BVH         : " << solver.GetContinuousCollision().GetBvh().GetNodeCount() << " nodes, "
+                  << ccd.Refits << " refits, " << ccd.Rebuilds << " rebuilds, quality " << ccd.Quality << std::endl;
+        std::cout << "CCD pairs   : " << ccd.TrianglePairs << " triangle pairs (" << 100.0f * ccd.CullingEfficiency
+                  << "% culled), " << ccd.Query.NodeTests << " node tests, " << ccd.FeatureTests << " feature tests"
+                  << std::endl;
+        std::cout << "CCD contacts: " << ccd.Contacts << ", " << ccd.Time << " ms (last step)" << std::endl;
+    }
+    if (solver.GetColliders().GetCount() > 0)
+    {
+        std::cout << "Colliders   : " << solver.GetColliders().GetCount() << ", "
+                  << result.LastStats.ColliderContacts << " contacts, " << result.LastStats.ColliderTime
+                  << " ms (last step)" << std::endl;
+    }
+    if (options.Mode == SOLVER_PROJECTIVE_DYNAMICS)
+    {
+        const SparseLDLT &factorization = solver.GetProjectiveDynamics().GetFactorization();
+        std::cout << "Factor      : " << factorization.GetSize() << " unknowns, "
+                  << factorization.GetFactorNonZeros() << " non-zeros in L" << std::endl;
+    }
+    std::cout << "Frames      : " << options.Frames << std::endl;
+    std::cout << "Total       : " << totalMs << " ms" << std::endl;
+    std::cout << "Steps / s   : " << 1000.0 * (double)options.Frames / totalMs << std::endl;
+
+    if (options.Verify)
+    {
+        for (unsigned int level = SIMD_SSE; level <= (unsigned int)GetSupportedSimdLevel(); ++level)
+        {
+            std::cout << "Verify " << GetSimdLevelName((SimdLevel)level) << " : max difference "
+                      << solver.VerifyKernel((SimdLevel)level) << std::endl;
+        }
+    }
+
+    return 0;
+}
+
+
+// FUNCTIONS
+// ---------
+
+bool
+ParseOptions(int argc, char **argv, HeadlessOptions *options)
+{
+    for (int index = 1; index < argc; ++index)
+    {
+        bool hasValue = (index + 1 < argc);
+
+        if (!strcmp(argv[index], "-obj") && hasValue)
+        {
+            options->ModelPath = argv[++index];
+        }
+        else if (!strcmp(argv[index], "-grid") && hasValue)
+        {
+            options->GridSize = (unsigned int)atoi(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-frames") && hasValue)
+        {
+            options->Frames = (unsigned int)atoi(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-dt") && hasValue)
+        {
+            options->DeltaTime = (float)atof(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-iterations") && hasValue)
+        {
+            options->Iterations = (unsigned int)atoi(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-simd") && hasValue)
+        {
+            if (!ParseSimdLevel(argv[++index], &options->Simd))
+            {
+                return false;
+            }
+        }
+        else if (!strcmp(argv[index], "-solver") && hasValue)
+        {
+            ++index;
+            if (!strcmp(argv[index], "jacobi"))
+            {
+                options->Mode = SOLVER_JACOBI;
+            }
+            else if (!strcmp(argv[index], "gauss-seidel"))
+            {
+                options->Mode = SOLVER_GAUSS_SEIDEL;
+            }
+            else if (!strcmp(argv[index], "xpbd"))
+            {
+                options->Mode = SOLVER_XPBD;
+            }
+            else if (!strcmp(argv[index], "pd"))
+            {
+                options->Mode = SOLVER_PROJECTIVE_DYNAMICS;
+            }
+            else if (!strcmp(argv[index], "implicit"))
+            {
+                options->Mode = SOLVER_IMPLICIT_EULER;
+            }
+            else if (!strcmp(argv[index], "vbd"))
+            {
+                options->Mode = SOLVER_BLOCK_DESCENT;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else if (!strcmp(argv[index], "-threads") && hasValue)
+        {
+            options->Threads = (unsigned int)atoi(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-substeps") && hasValue)
+        {
+            options->Substeps = (unsigned int)atoi(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-compliance") && hasValue)
+        {
+            options->Compliance = (float)atof(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-pd-stiffness") && hasValue)
+        {
+            options->ProjectiveStiffness = (float)atof(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-spring-stiffness") && hasValue)
+        {
+            options->SpringStiffness = (float)atof(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-spring-damping") && hasValue)
+        {
+            options->SpringDamping = (float)atof(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-vbd-stiffness") && hasValue)
+        {
+            options->BlockDescentStiffness = (float)atof(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-quadratic-bending"))
+        {
+            options->Bending = true;
+        }
+        else if (!strcmp(argv[index], "-bending-stiffness") && hasValue)
+        {
+            options->BendingStiffness = (float)atof(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-bending-compliance") && hasValue)
+        {
+            options->BendingCompliance = (float)atof(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-strain"))
+        {
+            options->Strain = true;
+        }
+        else if (!strcmp(argv[index], "-strain-only"))
+        {
+            options->Strain = true;
+            options->StrainOnly = true;
+        }
+        else if (!strcmp(argv[index], "-strain-stiffness") && hasValue)
+        {
+            glm::vec3 &stiffness = options->StrainStiffness;
+            if (sscanf(argv[++index], "%f,%f,%f", &stiffness.x, &stiffness.y, &stiffness.z) != 3)
+            {
+                return false;
+            }
+        }
+        else if (!strcmp(argv[index], "-strain-compliance") && hasValue)
+        {
+            glm::vec3 &compliance = options->StrainCompliance;
+            if (sscanf(argv[++index], "%f,%f,%f", &compliance.x, &compliance.y, &compliance.z) != 3)
+            {
+                return false;
+            }
+        }
+        else if (!strcmp(argv[index], "-self-collision"))
+        {
+            options->SelfCollision = true;
+        }
+        else if (!strcmp(argv[index], "-thickness") && hasValue)
+        {
+            options->Thickness = (float)atof(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-cache-interval") && hasValue)
+        {
+            options->CacheInterval = (unsigned int)atoi(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-cache-skin") && hasValue)
+        {
+            options->CacheSkin = (float)atof(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-ccd"))
+        {
+            options->ContinuousCollision = true;
+        }
+        else if (!strcmp(argv[index], "-ccd-thickness") && hasValue)
+        {
+            options->ContinuousThickness = (float)atof(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-fold"))
+        {
+            options->Fold = true;
+        }
+        else if (!strcmp(argv[index], "-ground"))
+        {
+            options->Ground = true;
+        }
+        else if (!strcmp(argv[index], "-props"))
+        {
+            options->Props = true;
+        }
+        else if (!strcmp(argv[index], "-drop"))
+        {
+            options->Drop = true;
+        }
+        else if (!strcmp(argv[index], "-friction") && hasValue)
+        {
+            options->Friction = (float)atof(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-collider-thickness") && hasValue)
+        {
+            options->ColliderThickness = (float)atof(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-sdf") && hasValue)
+        {
+            options->FieldPath = argv[++index];
+        }
+        else if (!strcmp(argv[index], "-bake-sdf") && hasValue)
+        {
+            options->FieldPath = argv[++index];
+            options->BakeField = true;
+        }
+        else if (!strcmp(argv[index], "-sdf-resolution") && hasValue)
+        {
+            options->FieldResolution = (unsigned int)atoi(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-adaptive") && hasValue)
+        {
+            options->Tolerance = (float)atof(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-min-iterations") && hasValue)
+        {
+            options->MinIterations = (unsigned int)atoi(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-budget") && hasValue)
+        {
+            options->TimeBudget = (float)atof(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-tethers"))
+        {
+            options->Tethers = true;
+        }
+        else if (!strcmp(argv[index], "-tether-slack") && hasValue)
+        {
+            options->TetherSlack = (float)atof(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-stretch-sweep"))
+        {
+            options->StretchSweep = true;
+        }
+        else if (!strcmp(argv[index], "-levels") && hasValue)
+        {
+            options->HierarchyLevels = (unsigned int)atoi(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-coarse-iterations") && hasValue)
+        {
+            options->CoarseIterations = (unsigned int)atoi(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-chebyshev") && hasValue)
+        {
+            options->ChebyshevRho = (float)atof(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-shear"))
+        {
+            options->EdgeFlags |= EDGES_SHEAR;
+        }
+        else if (!strcmp(argv[index], "-bend"))
+        {
+            options->EdgeFlags |= EDGES_BEND;
+        }
+        else if (!strcmp(argv[index], "-verify"))
+        {
+            options->Verify = true;
+        }
+        else if (!strcmp(argv[index], "-reorder") && hasValue)
+        {
+            if (!ParseVertexOrdering(argv[++index], &options->Reorder))
+            {
+                return false;
+            }
+        }
+        else if (!strcmp(argv[index], "-shuffle"))
+        {
+            options->Shuffle = true;
+        }
+        else if (!strcmp(argv[index], "-realtime") && hasValue)
+        {
+            options->RealTime = (float)atof(argv[++index]);
+        }
+        else if (!strcmp(argv[index], "-interpolate") && hasValue)
+        {
+            if (!ParseInterpolationMode(argv[++index], &options->Interpolation))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return (options->Frames > 0) && (options->DeltaTime > 0.0f);
+}
+
+void
+ApplyOrder(Mesh *mesh, const std::vector<unsigned int> &order, std::vector<unsigned int> *pinned)
+{
+    std::vector<unsigned int> remap = mesh->Reorder(order);
+    for (auto it = pinned->begin(); it != pinned->end(); ++it)
+    {
+        *it = remap[*it];
+    }
+}
+
+void
+ConfigureSolver(ClothSolver *solver, const HeadlessOptions &options)
+{
+    solver->SetSimdLevel(options.Simd);
+    solver->SetSolverMode(options.Mode);
+    solver->Substeps = options.Substeps;
+    solver->SetCompliance(options.Compliance);
+    if (options.ProjectiveStiffness > 0.0f)
+    {
+        solver->ProjectiveStiffness = options.ProjectiveStiffness;
+    }
+    if (options.SpringStiffness > 0.0f)
+    {
+        solver->ImplicitStiffness = options.SpringStiffness;
+    }
+    if (options.SpringDamping >= 0.0f)
+    {
+        solver->ImplicitDamping = options.SpringDamping;
+    }
+    if (options.BlockDescentStiffness > 0.0f)
+    {
+        solver->BlockDescentStiffness = options.BlockDescentStiffness;
+    }
+    solver->Bending = options.Bending;
+    if (options.BendingStiffness > 0.0f)
+    {
+        solver->BendingStiffness = options.BendingStiffness;
+    }
+    if (options.BendingCompliance >= 0.0f)
+    {
+        solver->BendingCompliance = options.BendingCompliance;
+    }
+    solver->Strain = options.Strain;
+    if (options.StrainStiffness.x >= 0.0f)
+    {
+        solver->StrainStiffness = options.StrainStiffness;
+    }
+    if (options.StrainCompliance.x >= 0.0f)
+    {
+        solver->StrainCompliance = options.StrainCompliance;
+    }
+    solver->SelfCollision = options.SelfCollision;
+    if (options.Thickness > 0.0f)
+    {
+        solver->SelfCollisionThickness = options.Thickness;
+    }
+    if (options.CacheInterval > 0)
+    {
+        solver->ContactCacheInterval = options.CacheInterval;
+    }
+    if (options.CacheSkin >= 0.0f)
+    {
+        solver->ContactCacheSkin = options.CacheSkin;
+    }
+    solver->ContinuousCollision = options.ContinuousCollision;
+    if (options.ContinuousThickness > 0.0f)
+    {
+        solver->ContinuousThickness = options.ContinuousThickness;
+    }
+    if (options.ColliderThickness > 0.0f)
+    {
+        solver->ColliderThickness = options.ColliderThickness;
+    }
+    if (options.Drop)
+    {
+        // Unpinned rather than never pinned, so the masses stay graded from the top row.
+        std::vector<unsigned int> pins = solver->GetPins().GetIndices();
+        for (auto pinIt = pins.begin(); pinIt != pins.end(); ++pinIt)
+        {
+            solver->Unpin(*pinIt);
+        }
+    }
+    ColliderSet &colliders = solver->GetColliders();
+    colliders.Clear();
+    if (options.Ground)
+    {
+        colliders.Add(MakePlaneCollider(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, GROUND_HEIGHT, 0.0f)),
+                                        options.Friction));
+    }
+    if (options.Props)
+    {
+        // Under the cloth, left to right: a box turned a quarter of the way round, a sphere, and a
+        // capsule lying along the cloth's width.
+        glm::mat4 box = glm::translate(glm::mat4(1.0f), glm::vec3(-1.6f, GROUND_HEIGHT + 0.5f, 0.5f));
+        box = glm::rotate(box, glm::radians(22.5f), glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::mat4 capsule = glm::translate(glm::mat4(1.0f), glm::vec3(1.6f, GROUND_HEIGHT + 0.4f, 0.5f));
+        capsule = glm::rotate(capsule, glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+        colliders.Add(MakeBoxCollider(box, glm::vec3(0.5f), options.Friction));
+        colliders.Add(MakeSphereCollider(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, GROUND_HEIGHT + 0.8f, 0.5f)),
+                                         0.8f, options.Friction));
+        colliders.Add(MakeCapsuleCollider(capsule, 0.4f, 0.6f, options.Friction));
+    }
+    if (options.Field)
+    {
+        // Bottom center of the model's bounds on FIELD_POSITION.
+        glm::vec3 boundsMin = options.Field->GetBoundsMin();
+        glm::vec3 boundsMax = options.Field->GetBoundsMax();
+        glm::vec3 base(0.5f * (boundsMin.x + boundsMax.x), boundsMin.y, 0.5f * (boundsMin.z + boundsMax.z));
+        colliders.Add(MakeFieldCollider(glm::translate(glm::mat4(1.0f), FIELD_POSITION - base), options.Field,
+                                        options.Friction));
+    }
+    solver->AdaptiveIterations = (options.Tolerance > 0.0f);
+    solver->Tolerance = options.Tolerance;
+    solver->MinIterations = options.MinIterations;
+    solver->TimeBudget = options.TimeBudget;
+    solver->Tethers = options.Tethers;
+    solver->TetherSlack = options.TetherSlack;
+    solver->CoarseIterations = options.CoarseIterations;
+    solver->SetHierarchyLevels(options.HierarchyLevels);
+    solver->ChebyshevAcceleration = (options.ChebyshevRho > 0.0f);
+    if (options.Mode == SOLVER_BLOCK_DESCENT)
+    {
+        solver->BlockDescentChebyshevRho = options.ChebyshevRho;
+    }
+    else
+    {
+        solver->ChebyshevRho = options.ChebyshevRho;
+    }
+}
+
+// -sdf and -bake-sdf: the field of the model at FieldPath, from its cache file if it is up to
+// date. Prints where it came from and how long it took.
+bool
+LoadField(const HeadlessOptions &options, SignedDistanceField *field)
+{
+    Model model(options.FieldPath);
+    if (model.Meshes.empty())
+    {
+        std::cout << "Failed to load " << options.FieldPath << std::endl;
+        return false;
+    }
+
+    std::string cachePath = options.FieldPath + ".sdf";
+    auto start = std::chrono::steady_clock::now();
+    bool cached = false;
+    if (options.BakeField)
+    {
+        field->Build(model.Meshes, options.FieldResolution, SDF_BAND_CELLS);
+        if (!field->Save(cachePath))
+        {
+            std::cout << "Failed to write " << cachePath << std::endl;
+            return false;
+        }
+    }
+    else
+    {
+        cached = LoadOrBuildSignedDistanceField(model.Meshes, options.FieldResolution, SDF_BAND_CELLS, cachePath, field);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    if (field->IsEmpty())
+    {
+        std::cout << "No closed surface in " << options.FieldPath << std::endl;
+        return false;
+    }
+
+    unsigned int triangles = 0;
+    for (auto meshIt = model.Meshes.begin(); meshIt != model.Meshes.end(); ++meshIt)
+    {
+        triangles += (unsigned int)meshIt->Faces.size();
+    }
+    std::cout << "SDF         : " << triangles << " triangles, " << field->GetNodeCount() << " nodes, cell "
+              << field->GetCellSize() << ", " << (cached ? "loaded from " : "voxelized to ") << cachePath << " in "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+    return true;
+}
+
+RunResult
+RunFrames(ClothSolver *solver, const HeadlessOptions &options, CacheMissCounter *counter)
+{
+    RunResult result;
+
+    // -fold: pins slide toward their middle along x, to a fifth of their width.
+    const std::vector<unsigned int> &pins = solver->GetPins().GetIndices();
+    std::vector<glm::vec3> pinStart;
+    float pinCenter = 0.0f;
+    for (auto pinIt = pins.begin(); pinIt != pins.end(); ++pinIt)
+    {
+        pinStart.push_back(solver->GetParticles().GetPosition(*pinIt));
+        pinCenter += pinStart.back().x / (float)pins.size();
+    }
+
+    auto stepStart = std::chrono::steady_clock::now();
+    counter->Start();
+    for (unsigned int frame = 0; frame < options.Frames; ++frame)
+    {
+        if (options.Fold)
+        {
+            float gather = 0.8f * std::min(1.0f, (float)frame * options.DeltaTime / FOLD_TIME);
+            for (unsigned int pin = 0; pin < pinStart.size(); ++pin)
+            {
+                glm::vec3 position = pinStart[pin];
+                position.x += gather * (pinCenter - position.x);
+                solver->MovePin(pins[pin], position);
+            }
+        }
+        solver->Step(options.DeltaTime);
+        const SolverStats &stats = solver->GetLastStepStats();
+        result.Iterations += stats.Iterations;
+        result.OverBudgetCount += stats.OverBudget ? 1 : 0;
+        result.MaxStepTime = std::max(result.MaxStepTime, stats.StepTime);
+    }
+    result.CacheMisses = counter->Stop();
+    result.LastStats = solver->GetLastStepStats();
+    auto stepEnd = std::chrono::steady_clock::now();
+
+    result.TotalMs = std::chrono::duration<double, std::milli>(stepEnd - stepStart).count();
+    return result;
+}
+
+void
+RunStretchSweep(const Mesh &mesh, const std::vector<unsigned int> &pinned, HeadlessOptions options)
+{
+    std::cout << "Iterations   Max stretch  Mean stretch   Max (tethers) Mean (tethers)" << std::endl;
+
+    for (unsigned int iterations = 1; iterations <= 32; iterations *= 2)
+    {
+        float stretch[2][2];
+        for (unsigned int tethers = 0; tethers < 2; ++tethers)
+        {
+            options.Iterations = iterations;
+            options.Tethers = (tethers == 1);
+
+            ClothSolver solver(mesh, pinned, options.Iterations, options.Threads);
+            ConfigureSolver(&solver, options);
+            for (unsigned int frame = 0; frame < options.Frames; ++frame)
+            {
+                solver.Step(options.DeltaTime);
+            }
+            MeasureStretch(solver, mesh, &stretch[tethers][0], &stretch[tethers][1]);
+        }
+
+        printf("%10u %12.5f %13.5f %15.5f %14.5f\n", iterations, stretch[0][0], stretch[0][1], stretch[1][0], stretch[1][1]);
+    }
+}
+
+// Relative stretch (|p1 - p2| - L) / L of the mesh constraints, compressed ones counting as 0.
+void
+MeasureStretch(const ClothSolver &solver, const Mesh &mesh, float *maxStretch, float *meanStretch)
+{
+    const ParticleStore &particles = solver.GetParticles();
+    double sum = 0.0;
+    *maxStretch = 0.0f;
+
+    for (auto constraintIt = mesh.DistConstraints.begin(); constraintIt != mesh.DistConstraints.end(); ++constraintIt)
+    {
+        float length = glm::distance(particles.GetPosition(constraintIt->Vertex1Index),
+                                     particles.GetPosition(constraintIt->Vertex2Index));
+        float stretch = std::max(0.0f, (length - constraintIt->RestLength) / constraintIt->RestLength);
+        *maxStretch = std::max(*maxStretch, stretch);
+        sum += stretch;
+    }
+
+    *meanStretch = mesh.DistConstraints.empty() ? 0.0f : (float)(sum / (double)mesh.DistConstraints.size());
+}
+
+void
+RunRealTime(ClothSolver *solver, Mesh *mesh, const HeadlessOptions &options)
+{
+    const auto framePeriod = std::chrono::microseconds(1000000 / 144);
+
+    SimulationThread simulation(solver, 1.0 / (double)options.DeltaTime);
+    StateInterpolator interpolator(&simulation, options.Interpolation);
+    unsigned int frameCount = 0;
+    unsigned int movedCount = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    auto end = start + std::chrono::microseconds((long long)(options.RealTime * 1e6f));
+    simulation.Start();
+    for (auto frameTime = start; frameTime < end; frameTime += framePeriod)
+    {
+        std::this_thread::sleep_until(frameTime);
+        movedCount += interpolator.Update(mesh) ? 1 : 0;
+        ++frameCount;
+    }
+    simulation.Stop();
+
+    const SimulationState &state = simulation.GetLatest();
+    std::cout << "Real time   : " << options.RealTime << " s at " << 1.0 / simulation.GetStepSize() << " steps/s" << std::endl;
+    std::cout << "Steps       : " << state.Step << " (sim time " << state.Time << " s)" << std::endl;
+    std::cout << "Dropped     : " << simulation.GetDroppedStepCount() << " steps" << std::endl;
+    std::cout << "Frames      : " << frameCount << ", " << movedCount << " updated the mesh ("
+              << GetInterpolationModeName(options.Interpolation) << ")" << std::endl;
+}
+
+void
+PrintLayout(const char *name, const Mesh &mesh, const RunResult &result, unsigned int frames, bool countersAvailable)
+{
+    std::cout << "Layout      : " << name << ", mean constraint span " << ComputeMeanConstraintSpan(mesh) << std::endl;
+    std::cout << "Per step    : " << result.TotalMs / (double)frames << " ms, "
+              << (double)result.Iterations / (double)frames << " iterations" << std::endl;
+    std::cout << "Residual    : max " << result.LastStats.MaxResidual << ", rms " << result.LastStats.RmsResidual
+              << " (last step)" << std::endl;
+    std::cout << "Slowest step: " << result.MaxStepTime << " ms, " << result.OverBudgetCount << " over budget, "
+              << result.LastStats.PlannedIterations << " iterations planned (last step)" << std::endl;
+    if (countersAvailable)
+    {
+        std::cout << "Cache misses: " << result.CacheMisses << " ("
+                  << (double)result.CacheMisses / (double)frames << " per step)" << std::endl;
+    }
+    else
+    {
+        std::cout << "Cache misses: unavailable (perf_event_open not permitted)" << std::endl;
+    }
+}
+
+// Square cloth of gridSize x gridSize vertices in the XY plane, hanging from its top row,
+// with the same vertex/face/neighbor layout Model::ProcessMesh() produces.
+Mesh
+BuildGridMesh(unsigned int gridSize, std::vector<unsigned int> *topRow)
+{
+    std::vector<Vertex> vertices(gridSize * gridSize);
+    std::vector<unsigned int> indices;
+    std::vector<Face> faces;
+    std::map<unsigned int, std::vector<unsigned int>> neighbors;
+    float spacing = 4.0f / (float)(gridSize - 1);
+
+    for (unsigned int row = 0; row < gridSize; ++row)
+    {
+        for (unsigned int column = 0; column < gridSize; ++column)
+        {
+            Vertex &vertex = vertices[row * gridSize + column];
+            vertex.Position = glm::vec3((float)column * spacing - 2.0f, 2.0f - (float)row * spacing, 0.0f);
+            vertex.Normal = glm::vec3(0.0f, 0.0f, 1.0f);
+            vertex.TexCoords = glm::vec2((float)column / (float)(gridSize - 1), (float)row / (float)(gridSize - 1));
+            vertex.Color = glm::vec3(0.5f, 0.5f, 0.5f);
+            vertex.Tangent = glm::vec3(1.0f, 0.0f, 0.0f);
+            vertex.Bitangent = glm::vec3(0.0f, -1.0f, 0.0f);
+        }
+    }
+
+    for (unsigned int column = 0; column < gridSize; ++column)
+    {
+        topRow->push_back(column);
+    }
+
+    for (unsigned int row = 0; row + 1 < gridSize; ++row)
+    {
+        for (unsigned int column = 0; column + 1 < gridSize; ++column)
+        {
+            unsigned int v0 = row * gridSize + column;
+            unsigned int v1 = v0 + 1;
+            unsigned int v2 = v0 + gridSize;
+            unsigned int v3 = v2 + 1;
+            unsigned int quad[2][3] = { { v0, v2, v1 }, { v1, v2, v3 } };
+
+            for (unsigned int triangle = 0; triangle < 2; ++triangle)
+            {
+                Face face;
+                for (unsigned int corner = 0; corner < 3; ++corner)
+                {
+                    face.Indices[corner] = quad[triangle][corner];
+                    indices.push_back(quad[triangle][corner]);
+
+                    std::vector<unsigned int> &adjacent = neighbors[quad[triangle][corner]];
+                    for (unsigned int other = 0; other < 3; ++other)
+                    {
+                        unsigned int neighbor = quad[triangle][other];
+                        if ((other != corner) &&
+                            (std::find(adjacent.begin(), adjacent.end(), neighbor) == adjacent.end()))
+                        {
+                            adjacent.push_back(neighbor);
+                        }
+                    }
+                }
+                faces.push_back(face);
+            }
+        }
+    }
+
+    return Mesh(vertices, indices, faces, neighbors);
+}
@@ -0,0 +1,93 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : PerfCounter.cpp
+ *
+ * Creation Date : 10/17/2026 - 15:40
+ * Last Modified : 10/17/2026 - 15:40
+ * ==========================================================================================
+ * Description   :
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include "PerfCounter.h"
+
+#if defined(__linux__)
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+
+// PUBLIC METHODS
+// --------------
+
+CacheMissCounter::CacheMissCounter()
+{
+    fileDescriptor_ = -1;
+
+#if defined(__linux__)
+    perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.size = sizeof(attributes);
+    attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+    attributes.disabled = 1;
+    // User space only, so it works with the default perf_event_paranoid setting.
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    // Counts the worker threads too, as long as they are spawned after this.
+    attributes.inherit = 1;
+
+    fileDescriptor_ = (int)syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0);
+#endif
+}
+
+CacheMissCounter::~CacheMissCounter()
+{
+#if defined(__linux__)
+    if (fileDescriptor_ >= 0)
+    {
+        close(fileDescriptor_);
+    }
+#endif
+}
+
+bool
+CacheMissCounter::IsAvailable() const
+{
+    return (fileDescriptor_ >= 0);
+}
+
+void
+CacheMissCounter::Start()
+{
+#if defined(__linux__)
+    if (fileDescriptor_ >= 0)
+    {
+        ioctl(fileDescriptor_, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fileDescriptor_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+uint64_t
+CacheMissCounter::Stop()
+{
+    uint64_t count = 0;
+
+#if defined(__linux__)
+    if (fileDescriptor_ >= 0)
+    {
+        ioctl(fileDescriptor_, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fileDescriptor_, &count, sizeof(count)) != (ssize_t)sizeof(count))
+        {
+            count = 0;
+        }
+    }
+#endif
+
+    return count;
+}
@@ -0,0 +1,44 @@
+#ifndef _PERFCOUNTER_H_
+#define _PERFCOUNTER_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : PerfCounter.h
+ *
+ * Creation Date : 10/17/2026 - 15:40
+ * Last Modified : 10/17/2026 - 15:40
+ * ==========================================================================================
+ * Description   : Hardware cache-miss counter for the headless benchmarks.
+ *                 Uses perf_event_open() on Linux. Elsewhere, or when the kernel does not
+ *                 allow it (perf_event_paranoid, containers), IsAvailable() is false and the
+ *                 caller should fall back to a software metric.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <cstdint>
+
+
+class CacheMissCounter
+{
+
+public:
+    CacheMissCounter();
+    ~CacheMissCounter();
+
+    CacheMissCounter(const CacheMissCounter &) = delete;
+    CacheMissCounter &operator=(const CacheMissCounter &) = delete;
+
+    bool IsAvailable() const;
+    void Start();
+    // Misses since the last Start(), 0 if unavailable.
+    uint64_t Stop();
+
+
+private:
+    int fileDescriptor_;
+
+};
+
+
+#endif // _PERFCOUNTER_H_
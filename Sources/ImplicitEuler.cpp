@@ -0,0 +1,369 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : ImplicitEuler.cpp
+ *
+ * Creation Date : 10/17/2026 - 19:40
+ * Last Modified : 10/17/2026 - 19:40
+ * ==========================================================================================
+ * Description   : References:
+ *                 (1) Baraff, Witkin, "Large Steps in Cloth Simulation"
+ *
+ *                 (2) Choi, Ko, "Stable but Responsive Cloth" (dropping the compressive part
+ *                     of the spring Jacobian to keep the system positive definite)
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <algorithm>
+#include <cmath>
+
+#include "ImplicitEuler.h"
+#include "DistanceKernels.h"
+#include "ParticleStore.h"
+#include "VertexIncidence.h"
+#include "ThreadPool.h"
+
+
+// Rows per partial sum of the CG dot products, and blocks of rows per thread-pool chunk.
+const unsigned int SUM_BLOCK_ROWS = 256;
+const unsigned int MIN_SUM_BLOCKS = 8;
+
+
+// PUBLIC METHODS
+// --------------
+
+ImplicitEulerSystem::ImplicitEulerSystem()
+{
+    lastRelativeResidual_ = 0.0f;
+}
+
+void
+ImplicitEulerSystem::Build(const DistanceConstraintBatch &constraints, const VertexIncidence &incidence, unsigned int particleCount)
+{
+    matrix_.BuildPattern(particleCount, constraints.Index1.Data(), constraints.Index2.Data(), constraints.Count);
+
+    slotBlock_.resize(incidence.Constraints.size());
+    for (unsigned int particle = 0; particle < particleCount; ++particle)
+    {
+        for (unsigned int slot = incidence.Offsets[particle]; slot < incidence.Offsets[particle + 1]; ++slot)
+        {
+            unsigned int constraint = incidence.Constraints[slot];
+            unsigned int other = (constraints.Index1[constraint] == particle) ? constraints.Index2[constraint]
+                                                                              : constraints.Index1[constraint];
+            slotBlock_[slot] = matrix_.FindBlock(particle, other);
+        }
+    }
+
+    unsigned int vectorSize = VECTOR_STRIDE * particleCount;
+    inverseDiagonal_.Resize(BLOCK_FLOATS * particleCount);
+    rightHandSide_.Resize(vectorSize);
+    solution_.Resize(vectorSize);
+    residual_.Resize(vectorSize);
+    preconditioned_.Resize(vectorSize);
+    direction_.Resize(vectorSize);
+    product_.Resize(vectorSize);
+    partials_.resize(2 * ((particleCount + SUM_BLOCK_ROWS - 1) / SUM_BLOCK_ROWS));
+}
+
+bool
+ImplicitEulerSystem::IsBuilt() const
+{
+    return matrix_.GetRowCount() > 0;
+}
+
+unsigned int
+ImplicitEulerSystem::Step(ThreadPool *threadPool,
+                          SimdLevel level,
+                          const DistanceConstraintBatch &constraints,
+                          const VertexIncidence &incidence,
+                          const ImplicitEulerSettings &settings,
+                          float timeStep,
+                          ParticleStore *particles,
+                          std::vector<DistanceResidual> *residuals)
+{
+    unsigned int count = matrix_.GetRowCount();
+
+    threadPool->ParallelFor(0, count, SUM_BLOCK_ROWS * MIN_SUM_BLOCKS,
+        [&](unsigned int begin, unsigned int end, unsigned int chunk)
+        {
+            Assemble(begin, end, constraints, incidence, settings, timeStep, *particles, &(*residuals)[chunk]);
+        });
+
+    unsigned int iterations = SolveConjugateGradient(threadPool, level, settings.MaxIterations, settings.Tolerance);
+
+    // v += dv, x += h v. Pinned particles have dv = 0 and no velocity.
+    threadPool->ParallelFor(0, count, SUM_BLOCK_ROWS * MIN_SUM_BLOCKS,
+        [&](unsigned int begin, unsigned int end, unsigned int)
+        {
+            for (unsigned int particle = begin; particle < end; ++particle)
+            {
+                const float *dv = solution_.Data() + VECTOR_STRIDE * particle;
+                particles->VelocityX[particle] += dv[0];
+                particles->VelocityY[particle] += dv[1];
+                particles->VelocityZ[particle] += dv[2];
+                particles->X[particle] += timeStep * particles->VelocityX[particle];
+                particles->Y[particle] += timeStep * particles->VelocityY[particle];
+                particles->Z[particle] += timeStep * particles->VelocityZ[particle];
+                particles->PredictedX[particle] = particles->X[particle];
+                particles->PredictedY[particle] = particles->Y[particle];
+                particles->PredictedZ[particle] = particles->Z[particle];
+            }
+        });
+
+    return iterations;
+}
+
+float
+ImplicitEulerSystem::GetLastRelativeResidual() const
+{
+    return lastRelativeResidual_;
+}
+
+
+// PRIVATE METHODS
+// ---------------
+
+void
+ImplicitEulerSystem::Assemble(unsigned int begin,
+                              unsigned int end,
+                              const DistanceConstraintBatch &constraints,
+                              const VertexIncidence &incidence,
+                              const ImplicitEulerSettings &settings,
+                              float timeStep,
+                              const ParticleStore &particles,
+                              DistanceResidual *residual)
+{
+    float h = timeStep;
+    float *blocks = matrix_.Blocks.Data();
+
+    for (unsigned int particle = begin; particle < end; ++particle)
+    {
+        float *rowBlocks = blocks + BLOCK_FLOATS * matrix_.RowOffsets[particle];
+        std::fill(rowBlocks, blocks + BLOCK_FLOATS * matrix_.RowOffsets[particle + 1], 0.0f);
+
+        float *diagonal = blocks + BLOCK_FLOATS * matrix_.Diagonal[particle];
+        float *b = rightHandSide_.Data() + VECTOR_STRIDE * particle;
+        float invMass = particles.InvMass[particle];
+
+        if (invMass <= 0.0f)
+        {
+            // Identity row and no right-hand side: dv = 0.
+            diagonal[0] = 1.0f;
+            diagonal[5] = 1.0f;
+            diagonal[10] = 1.0f;
+            b[0] = b[1] = b[2] = b[3] = 0.0f;
+            std::copy(diagonal, diagonal + BLOCK_FLOATS, inverseDiagonal_.Data() + BLOCK_FLOATS * particle);
+            continue;
+        }
+
+        // Same external acceleration as ClothSolver::Predict(), InvMass * Gravity.
+        float mass = 1.0f / invMass;
+        glm::vec3 position = particles.GetPosition(particle);
+        glm::vec3 velocity(particles.VelocityX[particle], particles.VelocityY[particle], particles.VelocityZ[particle]);
+        glm::vec3 force = mass * invMass * settings.Gravity;
+        glm::vec3 stiffnessTerm(0.0f);
+        glm::mat3 diagonalSum(mass);
+
+        for (unsigned int slot = incidence.Offsets[particle]; slot < incidence.Offsets[particle + 1]; ++slot)
+        {
+            unsigned int constraint = incidence.Constraints[slot];
+            unsigned int other = (constraints.Index1[constraint] == particle) ? constraints.Index2[constraint]
+                                                                              : constraints.Index1[constraint];
+            glm::vec3 delta = position - particles.GetPosition(other);
+            float length = glm::length(delta);
+            float restLength = constraints.RestLength[constraint];
+            if ((length <= restLength) || (length < 1e-6f))
+            {
+                continue;
+            }
+
+            if ((constraints.Index1[constraint] == particle) && (constraints.InvWeightSum[constraint] > 0.0f) && (restLength > 0.0f))
+            {
+                float stretch = (length - restLength) / restLength;
+                residual->Max = std::max(residual->Max, stretch);
+                residual->SumSquares += (double)stretch * (double)stretch;
+            }
+
+            // df/dx = -K, K = k (n n^T + (1 - L / l) (I - n n^T)); df/dv = -D, D = kd n n^T.
+            glm::vec3 direction = delta / length;
+            glm::mat3 outer = glm::outerProduct(direction, direction);
+            glm::mat3 stiffness = settings.Stiffness * (outer + (1.0f - restLength / length) * (glm::mat3(1.0f) - outer));
+            glm::mat3 damping = settings.Damping * outer;
+
+            glm::vec3 otherVelocity(particles.VelocityX[other], particles.VelocityY[other], particles.VelocityZ[other]);
+            glm::vec3 relativeVelocity = velocity - otherVelocity;
+            force -= settings.Stiffness * (length - restLength) * direction;
+            force -= settings.Damping * glm::dot(relativeVelocity, direction) * direction;
+            stiffnessTerm += stiffness * relativeVelocity;
+
+            glm::mat3 block = h * damping + h * h * stiffness;
+            diagonalSum += block;
+            if (particles.InvMass[other] > 0.0f)
+            {
+                float *offDiagonal = blocks + BLOCK_FLOATS * slotBlock_[slot];
+                for (unsigned int column = 0; column < 3; ++column)
+                {
+                    for (unsigned int row = 0; row < 3; ++row)
+                    {
+                        offDiagonal[4*column + row] -= block[column][row];
+                    }
+                }
+            }
+        }
+
+        // b = h (f - h K (v_i - v_j)) summed over the springs.
+        glm::vec3 rhs = h * (force - h * stiffnessTerm);
+        b[0] = rhs.x;
+        b[1] = rhs.y;
+        b[2] = rhs.z;
+        b[3] = 0.0f;
+
+        glm::mat3 inverse = glm::inverse(diagonalSum);
+        float *inverseBlock = inverseDiagonal_.Data() + BLOCK_FLOATS * particle;
+        for (unsigned int column = 0; column < 3; ++column)
+        {
+            for (unsigned int row = 0; row < 3; ++row)
+            {
+                diagonal[4*column + row] = diagonalSum[column][row];
+                inverseBlock[4*column + row] = inverse[column][row];
+            }
+        }
+    }
+}
+
+// Preconditioned CG from dv = 0, three parallel passes per iteration: the product with the
+// search direction, the solution / residual update, and the new direction.
+unsigned int
+ImplicitEulerSystem::SolveConjugateGradient(ThreadPool *threadPool, SimdLevel level, unsigned int maxIterations, float tolerance)
+{
+    unsigned int count = matrix_.GetRowCount();
+    float *x = solution_.Data();
+    float *r = residual_.Data();
+    float *z = preconditioned_.Data();
+    float *p = direction_.Data();
+    float *q = product_.Data();
+    const float *b = rightHandSide_.Data();
+    const float *inverseDiagonal = inverseDiagonal_.Data();
+
+    double sums[2];
+    SumOverRows(threadPool,
+        [&](unsigned int begin, unsigned int end, double *partial)
+        {
+            for (unsigned int row = begin; row < end; ++row)
+            {
+                unsigned int offset = VECTOR_STRIDE * row;
+                for (unsigned int component = 0; component < VECTOR_STRIDE; ++component)
+                {
+                    x[offset + component] = 0.0f;
+                    r[offset + component] = b[offset + component];
+                }
+                MultiplyBlock(inverseDiagonal + BLOCK_FLOATS * row, r + offset, z + offset);
+                for (unsigned int component = 0; component < 3; ++component)
+                {
+                    p[offset + component] = z[offset + component];
+                    partial[0] += (double)r[offset + component] * (double)z[offset + component];
+                    partial[1] += (double)r[offset + component] * (double)r[offset + component];
+                }
+                p[offset + 3] = 0.0f;
+            }
+        }, sums);
+
+    double rz = sums[0];
+    double threshold = (double)tolerance * (double)tolerance * sums[1];
+    double bNorm = sqrt(sums[1]);
+    lastRelativeResidual_ = 0.0f;
+    if (sums[1] <= 0.0)
+    {
+        return 0;
+    }
+
+    unsigned int iteration = 0;
+    while (iteration < maxIterations)
+    {
+        ++iteration;
+
+        SumOverRows(threadPool,
+            [&](unsigned int begin, unsigned int end, double *partial)
+            {
+                MultiplyBlockRows(level, matrix_, begin, end, p, q);
+                for (unsigned int index = VECTOR_STRIDE * begin; index < VECTOR_STRIDE * end; ++index)
+                {
+                    partial[0] += (double)p[index] * (double)q[index];
+                }
+            }, sums);
+
+        if (sums[0] <= 0.0)
+        {
+            break;
+        }
+        float alpha = (float)(rz / sums[0]);
+
+        SumOverRows(threadPool,
+            [&](unsigned int begin, unsigned int end, double *partial)
+            {
+                for (unsigned int index = VECTOR_STRIDE * begin; index < VECTOR_STRIDE * end; ++index)
+                {
+                    x[index] += alpha * p[index];
+                    r[index] -= alpha * q[index];
+                }
+                for (unsigned int row = begin; row < end; ++row)
+                {
+                    unsigned int offset = VECTOR_STRIDE * row;
+                    MultiplyBlock(inverseDiagonal + BLOCK_FLOATS * row, r + offset, z + offset);
+                    for (unsigned int component = 0; component < 3; ++component)
+                    {
+                        partial[0] += (double)r[offset + component] * (double)z[offset + component];
+                        partial[1] += (double)r[offset + component] * (double)r[offset + component];
+                    }
+                }
+            }, sums);
+
+        lastRelativeResidual_ = (float)(sqrt(sums[1]) / bNorm);
+        if (sums[1] <= threshold)
+        {
+            break;
+        }
+
+        float beta = (float)(sums[0] / rz);
+        rz = sums[0];
+        threadPool->ParallelFor(0, VECTOR_STRIDE * count, VECTOR_STRIDE * SUM_BLOCK_ROWS * MIN_SUM_BLOCKS,
+            [&](unsigned int begin, unsigned int end, unsigned int)
+            {
+                for (unsigned int index = begin; index < end; ++index)
+                {
+                    p[index] = z[index] + beta * p[index];
+                }
+            });
+    }
+
+    return iteration;
+}
+
+void
+ImplicitEulerSystem::SumOverRows(ThreadPool *threadPool,
+                                 const std::function<void(unsigned int, unsigned int, double *)> &task,
+                                 double *sums)
+{
+    unsigned int count = matrix_.GetRowCount();
+    unsigned int blockCount = (unsigned int)partials_.size() / 2;
+
+    threadPool->ParallelFor(0, blockCount, MIN_SUM_BLOCKS,
+        [&](unsigned int begin, unsigned int end, unsigned int)
+        {
+            for (unsigned int block = begin; block < end; ++block)
+            {
+                double *partial = &partials_[2 * block];
+                partial[0] = 0.0;
+                partial[1] = 0.0;
+                task(block * SUM_BLOCK_ROWS, std::min((block + 1) * SUM_BLOCK_ROWS, count), partial);
+            }
+        });
+
+    sums[0] = 0.0;
+    sums[1] = 0.0;
+    for (unsigned int block = 0; block < blockCount; ++block)
+    {
+        sums[0] += partials_[2 * block];
+        sums[1] += partials_[2 * block + 1];
+    }
+}
@@ -3,13 +3,15 @@
  * File Name     : Mesh.cpp
  *
  * Creation Date : 09/12/2017 - 07:06
- * Last Modified : 12/12/2017 - 19:48
+ * Last Modified : 10/17/2026 - 15:40
  * ==========================================================================================
  * Description   : Largely based on the tutorials found here : https://learnopengl.com/
  *
  * Author        : Mehdi Rouijel
  * ========================================================================================== */
 
+#include <algorithm>
+
 #include "glm/glm.hpp"
 #include "glad/glad.h"
 
@@ -30,18 +32,97 @@ Mesh::Mesh(std::vector<Vertex> vertices,
     Neighbors = neighbors;
     Faces = faces;
 
-    std::vector<unsigned int> constraintCount(vertices.size());
-    for (auto it = Neighbors.begin(); it != Neighbors.end(); ++it)
+    VAO = 0;
+    VBO = 0;
+    EBO = 0;
+
+    BuildConstraints(EDGES_STRUCTURAL);
+}
+
+void
+Mesh::BuildConstraints(unsigned int edgeFlags)
+{
+    std::vector<glm::vec3> positions(Vertices.size());
+    for (unsigned int index = 0; index < Vertices.size(); ++index)
+    {
+        positions[index] = Vertices[index].Position;
+    }
+
+    std::vector<Edge> edges = BuildEdges(Faces, positions, edgeFlags);
+    std::vector<unsigned int> constraintCount(Vertices.size());
+
+    DistConstraints.clear();
+    DistConstraints.reserve(edges.size());
+    for (auto edgeIt = edges.begin(); edgeIt != edges.end(); ++edgeIt)
+    {
+        DistConstraints.push_back(DistanceConstraint(this, edgeIt->Vertex1, edgeIt->Vertex2, &constraintCount));
+    }
+
+    ConstraintCount = constraintCount;
+    edgeFlags_ = edgeFlags;
+}
+
+std::vector<unsigned int>
+Mesh::Reorder(const std::vector<unsigned int> &order)
+{
+    std::vector<unsigned int> remap(Vertices.size());
+    std::vector<Vertex> vertices(Vertices.size());
+    for (unsigned int newIndex = 0; newIndex < order.size(); ++newIndex)
+    {
+        remap[order[newIndex]] = newIndex;
+        vertices[newIndex] = Vertices[order[newIndex]];
+    }
+    Vertices.swap(vertices);
+
+    for (auto faceIt = Faces.begin(); faceIt != Faces.end(); ++faceIt)
     {
-        for (auto neighborIt = it->second.begin(); neighborIt != it->second.end(); ++neighborIt)
+        for (unsigned int corner = 0; corner < 3; ++corner)
         {
-            DistConstraints.push_back(DistanceConstraint(this, it->first, (*neighborIt), &constraintCount));
+            faceIt->Indices[corner] = remap[faceIt->Indices[corner]];
         }
     }
 
-    ConstraintCount = constraintCount;
+    // Faces sorted by their lowest vertex so the index buffer (and anything that walks the faces)
+    // goes through the vertex arrays roughly front to back.
+    auto lowestIndex = [](const Face &face)
+    {
+        return std::min(face.Indices[0], std::min(face.Indices[1], face.Indices[2]));
+    };
+    std::stable_sort(Faces.begin(), Faces.end(),
+                     [&lowestIndex](const Face &left, const Face &right) { return lowestIndex(left) < lowestIndex(right); });
+
+    Indices.clear();
+    Indices.reserve(Faces.size()*3);
+    for (auto faceIt = Faces.begin(); faceIt != Faces.end(); ++faceIt)
+    {
+        Indices.insert(Indices.end(), faceIt->Indices, faceIt->Indices + 3);
+    }
+
+    std::map<unsigned int, std::vector<unsigned int>> neighbors;
+    for (auto neighborIt = Neighbors.begin(); neighborIt != Neighbors.end(); ++neighborIt)
+    {
+        std::vector<unsigned int> &list = neighbors[remap[neighborIt->first]];
+        for (auto it = neighborIt->second.begin(); it != neighborIt->second.end(); ++it)
+        {
+            list.push_back(remap[*it]);
+        }
+    }
+    Neighbors.swap(neighbors);
+
+    // The edges come out sorted by their first vertex, so the constraints follow the new order.
+    BuildConstraints(edgeFlags_);
 
-    Initialize();
+    if (VAO != 0)
+    {
+        glBindVertexArray(VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        glBufferData(GL_ARRAY_BUFFER, Vertices.size()*sizeof(Vertex), &Vertices[0], GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, Indices.size()*sizeof(unsigned int), &Indices[0], GL_STATIC_DRAW);
+        glBindVertexArray(0);
+    }
+
+    return remap;
 }
 
 void
@@ -103,6 +184,11 @@ Mesh::Update(bool updateNormals)
         RecalculateNormals();
     }
 
+    if (VAO == 0)
+    {
+        Initialize();
+    }
+
     glBindVertexArray(VAO);
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, Vertices.size()*sizeof(Vertex), &Vertices[0], GL_STATIC_DRAW);
@@ -112,6 +198,11 @@ Mesh::Update(bool updateNormals)
 void
 Mesh::Draw(Shader shader)
 {
+    if (VAO == 0)
+    {
+        Initialize();
+    }
+
     glBindVertexArray(VAO);
     glDrawElements(GL_TRIANGLES, Indices.size(), GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
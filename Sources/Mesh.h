@@ -6,7 +6,7 @@
  * File Name     : Mesh.h
  *
  * Creation Date : 09/12/2017 - 06:58
- * Last Modified : 12/12/2017 - 19:36
+ * Last Modified : 10/17/2026 - 15:40
  * ==========================================================================================
  * Description   : Largely based on the tutorials found here : https://learnopengl.com/
  *
@@ -18,6 +18,7 @@
 #include "glm/glm.hpp"
 
 #include "DistanceConstraint.h"
+#include "MeshTopology.h"
 
 
 // IMPORTANT(): Careful changing this struct!
@@ -49,12 +50,11 @@ public:
     std::vector<unsigned int> Indices;
     std::vector<Face> Faces;
     std::map<unsigned int, std::vector<unsigned int>> Neighbors;
-    std::vector<glm::vec3> Velocities;
-    std::vector<float> Masses;
-    std::vector<float> InvMasses;
     std::vector<DistanceConstraint> DistConstraints;
     std::vector<unsigned int> ConstraintCount;
 
+    // NOTE(): GL objects are created lazily on the first Update() or Draw(), so a Mesh can be
+    // built (and simulated through ClothSolver) without an OpenGL context.
     unsigned int VAO;
 
     Mesh(std::vector<Vertex> vertices,
@@ -62,6 +62,13 @@ public:
          std::vector<Face> faces,
          std::map<unsigned int, std::vector<unsigned int>> neighbors);
 
+    // Rebuilds DistConstraints and ConstraintCount from the faces: one constraint per undirected
+    // edge of the requested kinds (EdgeFlags), in sorted order. The constructor uses
+    // EDGES_STRUCTURAL.
+    void BuildConstraints(unsigned int edgeFlags);
+    // Renumbers the vertices, order[newIndex] = oldIndex (see MeshOptimizer.h). Faces, indices,
+    // neighbors and constraints follow. Returns the inverse mapping, oldIndex -> newIndex.
+    std::vector<unsigned int> Reorder(const std::vector<unsigned int> &order);
     void RecalculateNormals();
     void Update(bool updateNormals);
     void Draw(Shader shader);
@@ -70,6 +77,7 @@ public:
 private:
     unsigned int VBO;
     unsigned int EBO;
+    unsigned int edgeFlags_;
 
     void Initialize();
 
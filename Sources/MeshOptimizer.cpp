@@ -0,0 +1,204 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : MeshOptimizer.cpp
+ *
+ * Creation Date : 10/17/2026 - 15:40
+ * Last Modified : 10/17/2026 - 15:40
+ * ==========================================================================================
+ * Description   : References:
+ *                 (1) Cuthill, McKee, "Reducing the bandwidth of sparse symmetric matrices"
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+#include "MeshOptimizer.h"
+#include "Mesh.h"
+
+
+// Spreads the low 10 bits of value so there are two zero bits between each of them.
+static inline uint32_t
+SpreadBits(uint32_t value)
+{
+    value &= 0x3FF;
+    value = (value | (value << 16)) & 0x030000FF;
+    value = (value | (value << 8)) & 0x0300F00F;
+    value = (value | (value << 4)) & 0x030C30C3;
+    value = (value | (value << 2)) & 0x09249249;
+    return value;
+}
+
+static std::vector<unsigned int>
+ComputeMortonOrder(const Mesh &mesh)
+{
+    unsigned int vertexCount = (unsigned int)mesh.Vertices.size();
+    glm::vec3 minimum(1e30f);
+    glm::vec3 maximum(-1e30f);
+    for (unsigned int index = 0; index < vertexCount; ++index)
+    {
+        minimum = glm::min(minimum, mesh.Vertices[index].Position);
+        maximum = glm::max(maximum, mesh.Vertices[index].Position);
+    }
+
+    glm::vec3 extent = glm::max(maximum - minimum, glm::vec3(1e-6f));
+    std::vector<uint32_t> codes(vertexCount);
+    for (unsigned int index = 0; index < vertexCount; ++index)
+    {
+        glm::vec3 cell = (mesh.Vertices[index].Position - minimum) / extent * 1023.0f;
+        codes[index] = (SpreadBits((uint32_t)cell.x) << 2) | (SpreadBits((uint32_t)cell.y) << 1) | SpreadBits((uint32_t)cell.z);
+    }
+
+    std::vector<unsigned int> order(vertexCount);
+    for (unsigned int index = 0; index < vertexCount; ++index)
+    {
+        order[index] = index;
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&codes](unsigned int left, unsigned int right) { return codes[left] < codes[right]; });
+
+    return order;
+}
+
+static std::vector<unsigned int>
+ComputeRcmOrder(const Mesh &mesh)
+{
+    unsigned int vertexCount = (unsigned int)mesh.Vertices.size();
+
+    // Vertex -> neighbors over the constraint graph, CSR.
+    std::vector<unsigned int> offsets(vertexCount + 1, 0);
+    for (auto constraintIt = mesh.DistConstraints.begin(); constraintIt != mesh.DistConstraints.end(); ++constraintIt)
+    {
+        ++offsets[constraintIt->Vertex1Index + 1];
+        ++offsets[constraintIt->Vertex2Index + 1];
+    }
+    for (unsigned int vertex = 0; vertex < vertexCount; ++vertex)
+    {
+        offsets[vertex + 1] += offsets[vertex];
+    }
+    std::vector<unsigned int> neighbors(offsets[vertexCount]);
+    std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+    for (auto constraintIt = mesh.DistConstraints.begin(); constraintIt != mesh.DistConstraints.end(); ++constraintIt)
+    {
+        neighbors[cursor[constraintIt->Vertex1Index]++] = constraintIt->Vertex2Index;
+        neighbors[cursor[constraintIt->Vertex2Index]++] = constraintIt->Vertex1Index;
+    }
+
+    auto degree = [&offsets](unsigned int vertex) { return offsets[vertex + 1] - offsets[vertex]; };
+    auto byDegree = [&degree](unsigned int left, unsigned int right)
+    {
+        return (degree(left) < degree(right)) || ((degree(left) == degree(right)) && (left < right));
+    };
+
+    // Seeds: lowest degree first, which tends to pick a boundary (peripheral) vertex.
+    std::vector<unsigned int> seeds(vertexCount);
+    for (unsigned int index = 0; index < vertexCount; ++index)
+    {
+        seeds[index] = index;
+    }
+    std::sort(seeds.begin(), seeds.end(), byDegree);
+
+    std::vector<unsigned int> order;
+    order.reserve(vertexCount);
+    std::vector<bool> visited(vertexCount, false);
+
+    for (auto seedIt = seeds.begin(); seedIt != seeds.end(); ++seedIt)
+    {
+        if (visited[*seedIt])
+        {
+            continue;
+        }
+
+        // Breadth-first, children in increasing degree. One pass per connected component.
+        unsigned int head = (unsigned int)order.size();
+        order.push_back(*seedIt);
+        visited[*seedIt] = true;
+
+        for (; head < order.size(); ++head)
+        {
+            unsigned int vertex = order[head];
+            unsigned int firstChild = (unsigned int)order.size();
+
+            for (unsigned int slot = offsets[vertex]; slot < offsets[vertex + 1]; ++slot)
+            {
+                if (!visited[neighbors[slot]])
+                {
+                    visited[neighbors[slot]] = true;
+                    order.push_back(neighbors[slot]);
+                }
+            }
+            std::sort(order.begin() + firstChild, order.end(), byDegree);
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+
+// FUNCTIONS
+// ---------
+
+std::vector<unsigned int>
+ComputeVertexOrder(const Mesh &mesh, VertexOrdering ordering)
+{
+    switch (ordering)
+    {
+        case VERTEX_ORDER_MORTON: return ComputeMortonOrder(mesh);
+        case VERTEX_ORDER_RCM: return ComputeRcmOrder(mesh);
+        default: break;
+    }
+
+    std::vector<unsigned int> order(mesh.Vertices.size());
+    for (unsigned int index = 0; index < order.size(); ++index)
+    {
+        order[index] = index;
+    }
+    return order;
+}
+
+float
+ComputeMeanConstraintSpan(const Mesh &mesh)
+{
+    if (mesh.DistConstraints.empty())
+    {
+        return 0.0f;
+    }
+
+    double sum = 0.0;
+    for (auto constraintIt = mesh.DistConstraints.begin(); constraintIt != mesh.DistConstraints.end(); ++constraintIt)
+    {
+        unsigned int i1 = constraintIt->Vertex1Index;
+        unsigned int i2 = constraintIt->Vertex2Index;
+        sum += (i1 > i2) ? (i1 - i2) : (i2 - i1);
+    }
+    return (float)(sum / (double)mesh.DistConstraints.size());
+}
+
+const char *
+GetVertexOrderingName(VertexOrdering ordering)
+{
+    switch (ordering)
+    {
+        case VERTEX_ORDER_MORTON: return "morton";
+        case VERTEX_ORDER_RCM: return "rcm";
+        default: return "none";
+    }
+}
+
+bool
+ParseVertexOrdering(const char *name, VertexOrdering *ordering)
+{
+    const VertexOrdering orderings[] = { VERTEX_ORDER_NONE, VERTEX_ORDER_MORTON, VERTEX_ORDER_RCM };
+    for (unsigned int index = 0; index < 3; ++index)
+    {
+        if (!strcmp(name, GetVertexOrderingName(orderings[index])))
+        {
+            *ordering = orderings[index];
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,188 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : MeshTopology.cpp
+ *
+ * Creation Date : 10/17/2026 - 15:00
+ * Last Modified : 10/17/2026 - 20:30
+ * ==========================================================================================
+ * Description   :
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <algorithm>
+
+#include "MeshTopology.h"
+#include "Mesh.h"
+
+
+// cos(155 degrees): how straight v-u-w has to be to get a bend edge.
+const float BEND_EDGE_MAX_COSINE = -0.906f;
+
+
+static inline Edge
+MakeEdge(unsigned int a, unsigned int b)
+{
+    Edge edge;
+    edge.Vertex1 = (a < b) ? a : b;
+    edge.Vertex2 = (a < b) ? b : a;
+    return edge;
+}
+
+static inline bool
+EdgeLess(const Edge &left, const Edge &right)
+{
+    return (left.Vertex1 < right.Vertex1) ||
+           ((left.Vertex1 == right.Vertex1) && (left.Vertex2 < right.Vertex2));
+}
+
+static inline bool
+EdgeEqual(const Edge &left, const Edge &right)
+{
+    return (left.Vertex1 == right.Vertex1) && (left.Vertex2 == right.Vertex2);
+}
+
+static void
+SortUnique(std::vector<Edge> *edges)
+{
+    std::sort(edges->begin(), edges->end(), EdgeLess);
+    edges->erase(std::unique(edges->begin(), edges->end(), EdgeEqual), edges->end());
+}
+
+
+// Triangle edge, tagged with the vertex opposite to it in that triangle.
+struct HalfEdge
+{
+    Edge Key;
+    unsigned int Opposite;
+};
+
+// Sorted, so the two triangles sharing an edge end up next to each other.
+static std::vector<HalfEdge>
+BuildHalfEdges(const std::vector<Face> &faces)
+{
+    std::vector<HalfEdge> halfEdges;
+    halfEdges.reserve(faces.size() * 3);
+    for (auto faceIt = faces.begin(); faceIt != faces.end(); ++faceIt)
+    {
+        for (unsigned int corner = 0; corner < 3; ++corner)
+        {
+            HalfEdge halfEdge;
+            halfEdge.Key = MakeEdge(faceIt->Indices[corner], faceIt->Indices[(corner + 1) % 3]);
+            halfEdge.Opposite = faceIt->Indices[(corner + 2) % 3];
+            halfEdges.push_back(halfEdge);
+        }
+    }
+    std::sort(halfEdges.begin(), halfEdges.end(),
+              [](const HalfEdge &left, const HalfEdge &right) { return EdgeLess(left.Key, right.Key); });
+
+    return halfEdges;
+}
+
+
+std::vector<Edge>
+BuildEdges(const std::vector<Face> &faces,
+           const std::vector<glm::vec3> &positions,
+           unsigned int edgeFlags)
+{
+    std::vector<HalfEdge> halfEdges = BuildHalfEdges(faces);
+
+    std::vector<Edge> structural;
+    std::vector<Edge> edges;
+    for (unsigned int index = 0; index < halfEdges.size(); ++index)
+    {
+        bool first = (index == 0) || !EdgeEqual(halfEdges[index].Key, halfEdges[index - 1].Key);
+        if (first)
+        {
+            structural.push_back(halfEdges[index].Key);
+        }
+        else if ((edgeFlags & EDGES_SHEAR) && (halfEdges[index].Opposite != halfEdges[index - 1].Opposite))
+        {
+            edges.push_back(MakeEdge(halfEdges[index].Opposite, halfEdges[index - 1].Opposite));
+        }
+    }
+
+    if (edgeFlags & EDGES_BEND)
+    {
+        // Vertex -> neighbors over the structural edges.
+        unsigned int vertexCount = (unsigned int)positions.size();
+        std::vector<unsigned int> offsets(vertexCount + 1, 0);
+        for (auto edgeIt = structural.begin(); edgeIt != structural.end(); ++edgeIt)
+        {
+            ++offsets[edgeIt->Vertex1 + 1];
+            ++offsets[edgeIt->Vertex2 + 1];
+        }
+        for (unsigned int vertex = 0; vertex < vertexCount; ++vertex)
+        {
+            offsets[vertex + 1] += offsets[vertex];
+        }
+        std::vector<unsigned int> neighbors(offsets[vertexCount]);
+        std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+        for (auto edgeIt = structural.begin(); edgeIt != structural.end(); ++edgeIt)
+        {
+            neighbors[cursor[edgeIt->Vertex1]++] = edgeIt->Vertex2;
+            neighbors[cursor[edgeIt->Vertex2]++] = edgeIt->Vertex1;
+        }
+
+        // For every path v - u - w, keep the straightest continuation w of each v through u.
+        for (unsigned int u = 0; u < vertexCount; ++u)
+        {
+            for (unsigned int i = offsets[u]; i < offsets[u + 1]; ++i)
+            {
+                unsigned int v = neighbors[i];
+                glm::vec3 toV = glm::normalize(positions[v] - positions[u]);
+                float bestCosine = BEND_EDGE_MAX_COSINE;
+                unsigned int best = v;
+
+                for (unsigned int j = offsets[u]; j < offsets[u + 1]; ++j)
+                {
+                    unsigned int w = neighbors[j];
+                    float cosine = glm::dot(toV, glm::normalize(positions[w] - positions[u]));
+                    if ((w != v) && (cosine < bestCosine))
+                    {
+                        bestCosine = cosine;
+                        best = w;
+                    }
+                }
+
+                if (best != v)
+                {
+                    edges.push_back(MakeEdge(v, best));
+                }
+            }
+        }
+    }
+
+    if (edgeFlags & EDGES_STRUCTURAL)
+    {
+        edges.insert(edges.end(), structural.begin(), structural.end());
+    }
+    SortUnique(&edges);
+
+    return edges;
+}
+
+std::vector<EdgeStencil>
+BuildEdgeStencils(const std::vector<Face> &faces)
+{
+    std::vector<HalfEdge> halfEdges = BuildHalfEdges(faces);
+
+    // Only the first two triangles of a non-manifold edge make a stencil.
+    std::vector<EdgeStencil> stencils;
+    for (unsigned int index = 1; index < halfEdges.size(); ++index)
+    {
+        bool second = EdgeEqual(halfEdges[index].Key, halfEdges[index - 1].Key) &&
+                      ((index < 2) || !EdgeEqual(halfEdges[index].Key, halfEdges[index - 2].Key));
+        if (second && (halfEdges[index].Opposite != halfEdges[index - 1].Opposite))
+        {
+            EdgeStencil stencil;
+            stencil.Vertex1 = halfEdges[index].Key.Vertex1;
+            stencil.Vertex2 = halfEdges[index].Key.Vertex2;
+            stencil.Opposite1 = halfEdges[index - 1].Opposite;
+            stencil.Opposite2 = halfEdges[index].Opposite;
+            stencils.push_back(stencil);
+        }
+    }
+
+    return stencils;
+}
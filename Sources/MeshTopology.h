@@ -0,0 +1,61 @@
+#ifndef _MESHTOPOLOGY_H_
+#define _MESHTOPOLOGY_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : MeshTopology.h
+ *
+ * Creation Date : 10/17/2026 - 15:00
+ * Last Modified : 10/17/2026 - 20:30
+ * ==========================================================================================
+ * Description   : Builds the undirected edge list the distance constraints are made from.
+ *                 Every edge appears once, as (min, max), and the list is sorted, so the
+ *                 constraint order only depends on the mesh.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+#include "glm/glm.hpp"
+
+
+struct Face;
+
+
+enum EdgeFlags : unsigned int
+{
+    // Triangle edges.
+    EDGES_STRUCTURAL = 1 << 0,
+    // Between the two vertices opposite an edge shared by two triangles (the other diagonal
+    // of a triangulated quad).
+    EDGES_SHEAR = 1 << 1,
+    // Between v and w when v-u-w is a nearly straight path along two edges; resists folding.
+    EDGES_BEND = 1 << 2
+};
+
+
+struct Edge
+{
+    unsigned int Vertex1;
+    unsigned int Vertex2;
+};
+
+// An edge shared by two triangles, and the vertex opposite to it in each.
+struct EdgeStencil
+{
+    unsigned int Vertex1;
+    unsigned int Vertex2;
+    unsigned int Opposite1;
+    unsigned int Opposite2;
+};
+
+
+std::vector<Edge> BuildEdges(const std::vector<Face> &faces,
+                             const std::vector<glm::vec3> &positions,
+                             unsigned int edgeFlags);
+
+// Every interior edge, sorted like BuildEdges().
+std::vector<EdgeStencil> BuildEdgeStencils(const std::vector<Face> &faces);
+
+
+#endif // _MESHTOPOLOGY_H_
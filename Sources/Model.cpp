@@ -3,7 +3,7 @@
  * File Name     : Model.cpp
  *
  * Creation Date : 09/12/2017 - 08:09
- * Last Modified : 12/12/2017 - 19:36
+ * Last Modified : 10/17/2026 - 15:40
  * ==========================================================================================
  * Description   : Largely based on the tutorials found here : https://learnopengl.com/
  *
@@ -26,6 +26,31 @@ Model::Model(const std::string &path, const glm::vec3 &color)
     LoadModel(path);
 }
 
+void
+Model::OptimizeLayout(VertexOrdering ordering)
+{
+    // NOTE(): TopRow and the corner indices only refer to the first mesh.
+    if (Meshes.empty() || (ordering == VERTEX_ORDER_NONE))
+    {
+        return;
+    }
+
+    std::vector<unsigned int> remap = Meshes[0].Reorder(ComputeVertexOrder(Meshes[0], ordering));
+
+    for (auto it = TopRow.begin(); it != TopRow.end(); ++it)
+    {
+        *it = remap[*it];
+    }
+    if (TopLeftIndex < remap.size())
+    {
+        TopLeftIndex = remap[TopLeftIndex];
+    }
+    if (TopRightIndex < remap.size())
+    {
+        TopRightIndex = remap[TopRightIndex];
+    }
+}
+
 void
 Model::Update(bool updateNormals)
 {
@@ -6,7 +6,7 @@
  * File Name     : Model.h
  *
  * Creation Date : 09/12/2017 - 08:08
- * Last Modified : 12/12/2017 - 19:36
+ * Last Modified : 10/17/2026 - 15:40
  * ==========================================================================================
  * Description   : Largely based on the tutorials found here : https://learnopengl.com/
  *
@@ -22,6 +22,7 @@
 
 #include "Shader.h"
 #include "Mesh.h"
+#include "MeshOptimizer.h"
 
 
 class Model
@@ -37,6 +38,9 @@ public:
 
     Model(const std::string &path, const glm::vec3 &color = glm::vec3(0.5f, 0.5f, 0.5f));
 
+    // Renumbers the cloth's vertices for cache locality and remaps the pin indices to match.
+    // Call before handing the mesh to a ClothSolver.
+    void OptimizeLayout(VertexOrdering ordering);
     void Update(bool updateNormals);
     void Draw(Shader shader);
 
@@ -0,0 +1,201 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : ParticleHierarchy.cpp
+ *
+ * Creation Date : 10/17/2026 - 18:40
+ * Last Modified : 10/17/2026 - 18:40
+ * ==========================================================================================
+ * Description   : References:
+ *                 (1) Mueller, "Hierarchical Position Based Dynamics"
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <algorithm>
+
+#include "ParticleHierarchy.h"
+#include "ParticleStore.h"
+
+
+// PUBLIC METHODS
+// --------------
+
+void
+ParticleHierarchy::Build(const std::vector<DistanceConstraint> &constraints,
+                         const ParticleStore &particles,
+                         unsigned int levelCount,
+                         unsigned int minParticles)
+{
+    unsigned int vertexCount = particles.GetCount();
+
+    // Graph of the current level, indexed by particle.
+    std::vector<unsigned int> levelParticles(vertexCount);
+    std::vector<std::vector<unsigned int>> adjacency(vertexCount);
+    for (unsigned int index = 0; index < vertexCount; ++index)
+    {
+        levelParticles[index] = index;
+    }
+    for (auto constraintIt = constraints.begin(); constraintIt != constraints.end(); ++constraintIt)
+    {
+        adjacency[constraintIt->Vertex1Index].push_back(constraintIt->Vertex2Index);
+        adjacency[constraintIt->Vertex2Index].push_back(constraintIt->Vertex1Index);
+    }
+
+    // Built fine to coarse, stored coarse to fine.
+    std::vector<HierarchyLevel> levels;
+    std::vector<unsigned char> state(vertexCount);
+    const unsigned char UNDECIDED = 0;
+    const unsigned char COARSE = 1;
+    const unsigned char FINE = 2;
+
+    while ((levels.size() < levelCount) && (levelParticles.size() > minParticles))
+    {
+        // Greedy independent set in index order: every particle either stays or has a
+        // neighbor that does.
+        for (auto it = levelParticles.begin(); it != levelParticles.end(); ++it)
+        {
+            state[*it] = UNDECIDED;
+        }
+        for (auto it = levelParticles.begin(); it != levelParticles.end(); ++it)
+        {
+            if (state[*it] != UNDECIDED)
+            {
+                continue;
+            }
+            state[*it] = COARSE;
+            for (auto neighborIt = adjacency[*it].begin(); neighborIt != adjacency[*it].end(); ++neighborIt)
+            {
+                state[*neighborIt] = (state[*neighborIt] == UNDECIDED) ? FINE : state[*neighborIt];
+            }
+        }
+
+        HierarchyLevel level;
+        for (auto it = levelParticles.begin(); it != levelParticles.end(); ++it)
+        {
+            if (state[*it] == COARSE)
+            {
+                level.Particles.push_back(*it);
+            }
+        }
+        if (level.Particles.size() == levelParticles.size())
+        {
+            break;
+        }
+
+        // Dropped particles follow their kept neighbors, weighted by inverse rest distance.
+        level.ParentOffsets.push_back(0);
+        for (auto it = levelParticles.begin(); it != levelParticles.end(); ++it)
+        {
+            if (state[*it] != FINE)
+            {
+                continue;
+            }
+
+            unsigned int first = (unsigned int)level.Parents.size();
+            float weightSum = 0.0f;
+            for (auto neighborIt = adjacency[*it].begin(); neighborIt != adjacency[*it].end(); ++neighborIt)
+            {
+                if (state[*neighborIt] == COARSE)
+                {
+                    float weight = 1.0f / std::max(glm::distance(particles.GetPosition(*it), particles.GetPosition(*neighborIt)), 1e-6f);
+                    level.Parents.push_back(*neighborIt);
+                    level.ParentWeights.push_back(weight);
+                    weightSum += weight;
+                }
+            }
+            for (unsigned int parent = first; parent < level.Parents.size(); ++parent)
+            {
+                level.ParentWeights[parent] /= weightSum;
+            }
+
+            level.FineParticles.push_back(*it);
+            level.ParentOffsets.push_back((unsigned int)level.Parents.size());
+        }
+
+        // Kept particles are linked when they shared a dropped neighbor, or when two adjacent
+        // dropped particles link them. Kept particles are never adjacent themselves.
+        std::vector<std::pair<unsigned int, unsigned int>> edges;
+        for (unsigned int fine = 0; fine < level.FineParticles.size(); ++fine)
+        {
+            unsigned int particle = level.FineParticles[fine];
+            for (unsigned int a = level.ParentOffsets[fine]; a < level.ParentOffsets[fine + 1]; ++a)
+            {
+                for (unsigned int b = a + 1; b < level.ParentOffsets[fine + 1]; ++b)
+                {
+                    edges.push_back(std::make_pair(std::min(level.Parents[a], level.Parents[b]),
+                                                   std::max(level.Parents[a], level.Parents[b])));
+                }
+            }
+
+            for (auto neighborIt = adjacency[particle].begin(); neighborIt != adjacency[particle].end(); ++neighborIt)
+            {
+                if ((state[*neighborIt] != FINE) || (*neighborIt < particle))
+                {
+                    continue;
+                }
+                unsigned int other = (unsigned int)(std::lower_bound(level.FineParticles.begin(), level.FineParticles.end(), *neighborIt) -
+                                                    level.FineParticles.begin());
+                for (unsigned int a = level.ParentOffsets[fine]; a < level.ParentOffsets[fine + 1]; ++a)
+                {
+                    for (unsigned int b = level.ParentOffsets[other]; b < level.ParentOffsets[other + 1]; ++b)
+                    {
+                        if (level.Parents[a] != level.Parents[b])
+                        {
+                            edges.push_back(std::make_pair(std::min(level.Parents[a], level.Parents[b]),
+                                                           std::max(level.Parents[a], level.Parents[b])));
+                        }
+                    }
+                }
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        std::vector<DistanceConstraint> levelConstraints;
+        levelConstraints.reserve(edges.size());
+        for (auto edgeIt = edges.begin(); edgeIt != edges.end(); ++edgeIt)
+        {
+            float restLength = glm::distance(particles.GetPosition(edgeIt->first), particles.GetPosition(edgeIt->second));
+            levelConstraints.push_back(DistanceConstraint(edgeIt->first, edgeIt->second, restLength));
+        }
+
+        level.Coloring = ColorConstraints(levelConstraints, vertexCount);
+        level.Constraints.reserve(levelConstraints.size());
+        for (auto orderIt = level.Coloring.Order.begin(); orderIt != level.Coloring.Order.end(); ++orderIt)
+        {
+            level.Constraints.push_back(levelConstraints[*orderIt]);
+        }
+        level.Batch.Build(level.Constraints, particles);
+
+        // The new level's graph.
+        for (auto it = levelParticles.begin(); it != levelParticles.end(); ++it)
+        {
+            adjacency[*it].clear();
+        }
+        for (auto edgeIt = edges.begin(); edgeIt != edges.end(); ++edgeIt)
+        {
+            adjacency[edgeIt->first].push_back(edgeIt->second);
+            adjacency[edgeIt->second].push_back(edgeIt->first);
+        }
+        levelParticles = level.Particles;
+
+        levels.push_back(level);
+    }
+
+    Levels.assign(levels.rbegin(), levels.rend());
+}
+
+void
+ParticleHierarchy::UpdateWeights(const ParticleStore &particles)
+{
+    for (auto levelIt = Levels.begin(); levelIt != Levels.end(); ++levelIt)
+    {
+        levelIt->Batch.UpdateWeights(particles);
+    }
+}
+
+unsigned int
+ParticleHierarchy::GetLevelCount() const
+{
+    return (unsigned int)Levels.size();
+}
@@ -0,0 +1,71 @@
+#ifndef _PARTICLEHIERARCHY_H_
+#define _PARTICLEHIERARCHY_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : ParticleHierarchy.h
+ *
+ * Creation Date : 10/17/2026 - 18:40
+ * Last Modified : 10/17/2026 - 18:40
+ * ==========================================================================================
+ * Description   : Coarse particle levels for hierarchical position-based dynamics.
+ *                 Each level keeps a subset of the particles of the level below (every dropped
+ *                 particle has a kept neighbor), linked by distance constraints between kept
+ *                 particles that shared a neighbor. Coarse particles are ordinary particles, so
+ *                 a level is solved by the same kernels, on the same ParticleStore, as the mesh.
+ *                 A stretch at the scale of the whole cloth is a few constraints away on the
+ *                 coarsest level instead of hundreds on the mesh.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+
+#include "DistanceConstraint.h"
+#include "DistanceKernels.h"
+#include "ConstraintColoring.h"
+
+
+class ParticleStore;
+
+
+struct HierarchyLevel
+{
+    // Particle indices of this level, increasing.
+    std::vector<unsigned int> Particles;
+    // Stored in color order, like ClothSolver's own constraints.
+    std::vector<DistanceConstraint> Constraints;
+    ConstraintColoring Coloring;
+    DistanceConstraintBatch Batch;
+
+    // Prolongation onto the particles of the next finer level that are not on this one:
+    // FineParticles[i] follows the weighted motion of
+    // Parents[ParentOffsets[i], ParentOffsets[i + 1]).
+    std::vector<unsigned int> FineParticles;
+    std::vector<unsigned int> ParentOffsets;
+    std::vector<unsigned int> Parents;
+    std::vector<float> ParentWeights;
+};
+
+
+class ParticleHierarchy
+{
+
+public:
+    // Levels[0] is the coarsest.
+    std::vector<HierarchyLevel> Levels;
+
+    // Decimates the constraint graph until a level has minParticles or fewer, or levelCount
+    // levels were built. Uses the current positions as rest positions.
+    void Build(const std::vector<DistanceConstraint> &constraints,
+               const ParticleStore &particles,
+               unsigned int levelCount,
+               unsigned int minParticles);
+    void UpdateWeights(const ParticleStore &particles);
+
+    unsigned int GetLevelCount() const;
+
+};
+
+
+#endif // _PARTICLEHIERARCHY_H_
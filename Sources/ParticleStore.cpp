@@ -0,0 +1,65 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : ParticleStore.cpp
+ *
+ * Creation Date : 10/17/2026 - 10:24
+ * Last Modified : 10/17/2026 - 10:24
+ * ==========================================================================================
+ * Description   :
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include "ParticleStore.h"
+
+
+// PUBLIC METHODS
+// --------------
+
+ParticleStore::ParticleStore()
+{
+    count_ = 0;
+}
+
+void
+ParticleStore::Resize(unsigned int count)
+{
+    X.Resize(count);
+    Y.Resize(count);
+    Z.Resize(count);
+    PredictedX.Resize(count);
+    PredictedY.Resize(count);
+    PredictedZ.Resize(count);
+    VelocityX.Resize(count);
+    VelocityY.Resize(count);
+    VelocityZ.Resize(count);
+    InvMass.Resize(count);
+
+    count_ = count;
+}
+
+unsigned int
+ParticleStore::GetCount() const
+{
+    return count_;
+}
+
+glm::vec3
+ParticleStore::GetPosition(unsigned int index) const
+{
+    return glm::vec3(X[index], Y[index], Z[index]);
+}
+
+glm::vec3
+ParticleStore::GetPredicted(unsigned int index) const
+{
+    return glm::vec3(PredictedX[index], PredictedY[index], PredictedZ[index]);
+}
+
+void
+ParticleStore::SetPosition(unsigned int index, const glm::vec3 &position)
+{
+    X[index] = position.x;
+    Y[index] = position.y;
+    Z[index] = position.z;
+}
@@ -0,0 +1,54 @@
+#ifndef _PARTICLESTORE_H_
+#define _PARTICLESTORE_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : ParticleStore.h
+ *
+ * Creation Date : 10/17/2026 - 10:24
+ * Last Modified : 10/17/2026 - 10:24
+ * ==========================================================================================
+ * Description   : Structure-of-arrays particle state used by ClothSolver.
+ *                 Each attribute is its own aligned, padded array so a constraint solve only
+ *                 streams the components it actually reads.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include "glm/glm.hpp"
+
+#include "AlignedArray.h"
+
+
+class ParticleStore
+{
+
+public:
+    AlignedArray<float> X;
+    AlignedArray<float> Y;
+    AlignedArray<float> Z;
+    AlignedArray<float> PredictedX;
+    AlignedArray<float> PredictedY;
+    AlignedArray<float> PredictedZ;
+    AlignedArray<float> VelocityX;
+    AlignedArray<float> VelocityY;
+    AlignedArray<float> VelocityZ;
+    AlignedArray<float> InvMass;
+
+    ParticleStore();
+
+    void Resize(unsigned int count);
+    unsigned int GetCount() const;
+
+    glm::vec3 GetPosition(unsigned int index) const;
+    glm::vec3 GetPredicted(unsigned int index) const;
+    void SetPosition(unsigned int index, const glm::vec3 &position);
+
+
+private:
+    unsigned int count_;
+
+};
+
+
+#endif // _PARTICLESTORE_H_
@@ -0,0 +1,80 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : PinSet.cpp
+ *
+ * Creation Date : 10/17/2026 - 11:05
+ * Last Modified : 10/17/2026 - 11:05
+ * ==========================================================================================
+ * Description   :
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <algorithm>
+
+#include "PinSet.h"
+
+
+// PUBLIC METHODS
+// --------------
+
+PinSet::PinSet()
+{
+    particleCount_ = 0;
+}
+
+void
+PinSet::Resize(unsigned int particleCount)
+{
+    mask_.assign((particleCount + 63) / 64, 0);
+    indices_.clear();
+    particleCount_ = particleCount;
+}
+
+// Returns false if the particle was already pinned (or is out of range).
+bool
+PinSet::Add(unsigned int index)
+{
+    if ((index >= particleCount_) || Contains(index))
+    {
+        return false;
+    }
+
+    mask_[index / 64] |= (uint64_t)1 << (index % 64);
+    indices_.insert(std::lower_bound(indices_.begin(), indices_.end(), index), index);
+
+    return true;
+}
+
+// Returns false if the particle was not pinned.
+bool
+PinSet::Remove(unsigned int index)
+{
+    if ((index >= particleCount_) || !Contains(index))
+    {
+        return false;
+    }
+
+    mask_[index / 64] &= ~((uint64_t)1 << (index % 64));
+    indices_.erase(std::lower_bound(indices_.begin(), indices_.end(), index));
+
+    return true;
+}
+
+bool
+PinSet::Contains(unsigned int index) const
+{
+    return (index < particleCount_) && ((mask_[index / 64] >> (index % 64)) & 1);
+}
+
+unsigned int
+PinSet::GetCount() const
+{
+    return (unsigned int)indices_.size();
+}
+
+const std::vector<unsigned int> &
+PinSet::GetIndices() const
+{
+    return indices_;
+}
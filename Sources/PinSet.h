@@ -0,0 +1,48 @@
+#ifndef _PINSET_H_
+#define _PINSET_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : PinSet.h
+ *
+ * Creation Date : 10/17/2026 - 11:05
+ * Last Modified : 10/17/2026 - 11:05
+ * ==========================================================================================
+ * Description   : Set of pinned (attached) particles.
+ *                 Membership is a packed bitmask for O(1) lookups; the pinned indices are also
+ *                 kept as a sorted list for code that only needs to walk the pins.
+ *                 The solver itself never queries this per particle: a pin is a zero inverse
+ *                 mass in the ParticleStore.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+#include <cstdint>
+
+
+class PinSet
+{
+
+public:
+    PinSet();
+
+    void Resize(unsigned int particleCount);
+
+    bool Add(unsigned int index);
+    bool Remove(unsigned int index);
+    bool Contains(unsigned int index) const;
+
+    unsigned int GetCount() const;
+    const std::vector<unsigned int> &GetIndices() const;
+
+
+private:
+    std::vector<uint64_t> mask_;
+    std::vector<unsigned int> indices_;
+    unsigned int particleCount_;
+
+};
+
+
+#endif // _PINSET_H_
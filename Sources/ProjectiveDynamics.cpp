@@ -0,0 +1,276 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : ProjectiveDynamics.cpp
+ *
+ * Creation Date : 10/17/2026 - 19:15
+ * Last Modified : 10/17/2026 - 19:15
+ * ==========================================================================================
+ * Description   : References:
+ *                 (1) Bouaziz et al., "Projective Dynamics: Fusing Constraint Projections for
+ *                     Fast Simulation"
+ *
+ *                 (2) Liu et al., "Fast Simulation of Mass-Spring Systems"
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+#include "ProjectiveDynamics.h"
+#include "DistanceKernels.h"
+#include "ParticleStore.h"
+#include "VertexIncidence.h"
+
+
+// PUBLIC METHODS
+// --------------
+
+ProjectiveDynamicsSystem::ProjectiveDynamicsSystem()
+{
+    analyzed_ = false;
+    factored_ = false;
+    timeStep_ = 0.0f;
+    stiffness_ = 0.0f;
+}
+
+bool
+ProjectiveDynamicsSystem::Prepare(const DistanceConstraintBatch &constraints,
+                                  const VertexIncidence &incidence,
+                                  const ParticleStore &particles,
+                                  float timeStep,
+                                  float stiffness)
+{
+    if (!analyzed_)
+    {
+        Analyze(constraints, incidence, particles);
+        factored_ = false;
+    }
+    if (factored_ && (timeStep == timeStep_) && (stiffness == stiffness_))
+    {
+        return true;
+    }
+
+    // Columns of free particle i: m_i / h^2 + k * (constraint count) on the diagonal, and -k
+    // for every constraint to another free particle.
+    double inverseTimeStepSquared = 1.0 / ((double)timeStep * (double)timeStep);
+    unsigned int unknownCount = (unsigned int)particle_.size();
+    values_.assign(rows_.size(), 0.0);
+    inertiaWeight_.resize(unknownCount);
+    for (unsigned int column = 0; column < unknownCount; ++column)
+    {
+        unsigned int particle = particle_[column];
+        auto columnBegin = rows_.begin() + columnStarts_[column];
+        auto columnEnd = rows_.begin() + columnStarts_[column + 1];
+        unsigned int diagonal = columnStarts_[column] + (unsigned int)(std::lower_bound(columnBegin, columnEnd, column) - columnBegin);
+
+        inertiaWeight_[column] = inverseTimeStepSquared / (double)particles.InvMass[particle];
+        values_[diagonal] += inertiaWeight_[column];
+
+        for (unsigned int slot = incidence.Offsets[particle]; slot < incidence.Offsets[particle + 1]; ++slot)
+        {
+            unsigned int constraint = incidence.Constraints[slot];
+            unsigned int other = (constraints.Index1[constraint] == particle) ? constraints.Index2[constraint]
+                                                                              : constraints.Index1[constraint];
+
+            values_[diagonal] += stiffness;
+            if (unknown_[other] != UINT_MAX)
+            {
+                values_[columnStarts_[column] + (unsigned int)(std::lower_bound(columnBegin, columnEnd, unknown_[other]) - columnBegin)] -= stiffness;
+            }
+        }
+    }
+
+    timeStep_ = timeStep;
+    stiffness_ = stiffness;
+    factored_ = factorization_.Factor(values_);
+
+    return factored_;
+}
+
+void
+ProjectiveDynamicsSystem::Invalidate()
+{
+    analyzed_ = false;
+    factored_ = false;
+}
+
+void
+ProjectiveDynamicsSystem::SetInertia(const ParticleStore &particles)
+{
+    inertiaX_ = particles.PredictedX;
+    inertiaY_ = particles.PredictedY;
+    inertiaZ_ = particles.PredictedZ;
+}
+
+void
+ProjectiveDynamicsSystem::Project(const DistanceConstraintBatch &constraints,
+                                  unsigned int begin,
+                                  unsigned int end,
+                                  const ParticleStore &particles,
+                                  DistanceResidual *residual)
+{
+    const float *px = particles.PredictedX.Data();
+    const float *py = particles.PredictedY.Data();
+    const float *pz = particles.PredictedZ.Data();
+
+    for (unsigned int constraint = begin; constraint < end; ++constraint)
+    {
+        unsigned int index1 = constraints.Index1[constraint];
+        unsigned int index2 = constraints.Index2[constraint];
+        float dx = px[index2] - px[index1];
+        float dy = py[index2] - py[index1];
+        float dz = pz[index2] - pz[index1];
+        float length = sqrtf(dx*dx + dy*dy + dz*dz);
+        float restLength = constraints.RestLength[constraint];
+
+        float scale = 1.0f;
+        if ((length > restLength) && (length > 1e-6f))
+        {
+            scale = restLength / length;
+            if ((constraints.InvWeightSum[constraint] > 0.0f) && (restLength > 0.0f))
+            {
+                float stretch = (length - restLength) / restLength;
+                residual->Max = std::max(residual->Max, stretch);
+                residual->SumSquares += (double)stretch * (double)stretch;
+            }
+        }
+
+        targetX_[constraint] = scale * dx;
+        targetY_[constraint] = scale * dy;
+        targetZ_[constraint] = scale * dz;
+    }
+}
+
+void
+ProjectiveDynamicsSystem::Gather(const DistanceConstraintBatch &constraints,
+                                 const VertexIncidence &incidence,
+                                 unsigned int begin,
+                                 unsigned int end,
+                                 const ParticleStore &particles)
+{
+    const float *px = particles.PredictedX.Data();
+    const float *py = particles.PredictedY.Data();
+    const float *pz = particles.PredictedZ.Data();
+    double stiffness = (double)stiffness_;
+
+    // b = M / h^2 s + k sum A^T p, plus the pinned neighbors moved over from the left-hand side.
+    for (unsigned int unknown = begin; unknown < end; ++unknown)
+    {
+        unsigned int particle = particle_[unknown];
+        double x = 0.0;
+        double y = 0.0;
+        double z = 0.0;
+        for (unsigned int slot = incidence.Offsets[particle]; slot < incidence.Offsets[particle + 1]; ++slot)
+        {
+            unsigned int constraint = incidence.Constraints[slot];
+            float sign = incidence.Signs[slot];
+            x += (double)(sign * targetX_[constraint]);
+            y += (double)(sign * targetY_[constraint]);
+            z += (double)(sign * targetZ_[constraint]);
+
+            unsigned int other = (constraints.Index1[constraint] == particle) ? constraints.Index2[constraint]
+                                                                              : constraints.Index1[constraint];
+            if (unknown_[other] == UINT_MAX)
+            {
+                x += (double)px[other];
+                y += (double)py[other];
+                z += (double)pz[other];
+            }
+        }
+
+        double inertia = inertiaWeight_[unknown];
+        solution_[3*unknown + 0] = inertia * (double)inertiaX_[particle] + stiffness * x;
+        solution_[3*unknown + 1] = inertia * (double)inertiaY_[particle] + stiffness * y;
+        solution_[3*unknown + 2] = inertia * (double)inertiaZ_[particle] + stiffness * z;
+    }
+}
+
+void
+ProjectiveDynamicsSystem::Solve(ParticleStore *particles)
+{
+    factorization_.Solve(solution_.data(), 3, work_.data());
+
+    unsigned int unknownCount = (unsigned int)particle_.size();
+    for (unsigned int unknown = 0; unknown < unknownCount; ++unknown)
+    {
+        unsigned int particle = particle_[unknown];
+        particles->PredictedX[particle] = (float)solution_[3*unknown + 0];
+        particles->PredictedY[particle] = (float)solution_[3*unknown + 1];
+        particles->PredictedZ[particle] = (float)solution_[3*unknown + 2];
+    }
+}
+
+unsigned int
+ProjectiveDynamicsSystem::GetUnknownCount() const
+{
+    return (unsigned int)particle_.size();
+}
+
+bool
+ProjectiveDynamicsSystem::IsFactored() const
+{
+    return factored_;
+}
+
+const SparseLDLT &
+ProjectiveDynamicsSystem::GetFactorization() const
+{
+    return factorization_;
+}
+
+
+// PRIVATE METHODS
+// ---------------
+
+void
+ProjectiveDynamicsSystem::Analyze(const DistanceConstraintBatch &constraints, const VertexIncidence &incidence, const ParticleStore &particles)
+{
+    unsigned int count = particles.GetCount();
+    unknown_.assign(count, UINT_MAX);
+    particle_.clear();
+    for (unsigned int particle = 0; particle < count; ++particle)
+    {
+        if (particles.InvMass[particle] > 0.0f)
+        {
+            unknown_[particle] = (unsigned int)particle_.size();
+            particle_.push_back(particle);
+        }
+    }
+
+    unsigned int unknownCount = (unsigned int)particle_.size();
+    columnStarts_.resize(unknownCount + 1);
+    rows_.clear();
+    columnStarts_[0] = 0;
+    for (unsigned int column = 0; column < unknownCount; ++column)
+    {
+        unsigned int particle = particle_[column];
+        rows_.push_back(column);
+        for (unsigned int slot = incidence.Offsets[particle]; slot < incidence.Offsets[particle + 1]; ++slot)
+        {
+            unsigned int constraint = incidence.Constraints[slot];
+            unsigned int other = (constraints.Index1[constraint] == particle) ? constraints.Index2[constraint]
+                                                                              : constraints.Index1[constraint];
+            if (unknown_[other] != UINT_MAX)
+            {
+                rows_.push_back(unknown_[other]);
+            }
+        }
+
+        auto columnBegin = rows_.begin() + columnStarts_[column];
+        std::sort(columnBegin, rows_.end());
+        rows_.erase(std::unique(columnBegin, rows_.end()), rows_.end());
+        columnStarts_[column + 1] = (unsigned int)rows_.size();
+    }
+
+    factorization_.Analyze(unknownCount, columnStarts_, rows_);
+
+    targetX_.Resize(constraints.Count);
+    targetY_.Resize(constraints.Count);
+    targetZ_.Resize(constraints.Count);
+    solution_.resize(3 * unknownCount);
+    work_.resize(3 * unknownCount);
+
+    analyzed_ = true;
+}
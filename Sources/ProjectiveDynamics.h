@@ -0,0 +1,107 @@
+#ifndef _PROJECTIVEDYNAMICS_H_
+#define _PROJECTIVEDYNAMICS_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : ProjectiveDynamics.h
+ *
+ * Creation Date : 10/17/2026 - 19:15
+ * Last Modified : 10/17/2026 - 19:15
+ * ==========================================================================================
+ * Description   : Projective Dynamics system for the distance constraints.
+ *                 The global step matrix M / h^2 + k sum A^T A only depends on the masses, the
+ *                 time step, the stiffness and the pins, so it is assembled and factored once;
+ *                 every iteration is then a local step (each constraint projects its edge on
+ *                 its rest length, in parallel) and a back-substitution.
+ *
+ *                 Pinned particles are not unknowns: their terms move to the right-hand side,
+ *                 so a MovePin() needs no new factorization, but pinning or unpinning does.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+
+#include "AlignedArray.h"
+#include "SparseLDLT.h"
+
+
+struct DistanceConstraintBatch;
+struct DistanceResidual;
+struct VertexIncidence;
+class ParticleStore;
+
+
+class ProjectiveDynamicsSystem
+{
+
+public:
+    ProjectiveDynamicsSystem();
+
+    // Refactors if the time step or stiffness changed since the last call, and analyzes the
+    // pattern again first if Invalidate() was called. Returns false if the factorization failed.
+    bool Prepare(const DistanceConstraintBatch &constraints,
+                 const VertexIncidence &incidence,
+                 const ParticleStore &particles,
+                 float timeStep,
+                 float stiffness);
+    // The set of pinned particles changed.
+    void Invalidate();
+
+    // Keeps the predicted positions as the inertial target of the substep.
+    void SetInertia(const ParticleStore &particles);
+    // Local step over constraints [begin, end): the target edge of every stretched constraint is
+    // its current edge scaled to the rest length; compressed ones keep their current edge. The
+    // stretch before projection is added to residual.
+    void Project(const DistanceConstraintBatch &constraints,
+                 unsigned int begin,
+                 unsigned int end,
+                 const ParticleStore &particles,
+                 DistanceResidual *residual);
+    // Global step, in two parts: the right-hand side of unknowns [begin, end) (any ranges can
+    // run in parallel), then one back-substitution for the three axes at once, written into the
+    // predicted positions of the free particles.
+    void Gather(const DistanceConstraintBatch &constraints,
+                const VertexIncidence &incidence,
+                unsigned int begin,
+                unsigned int end,
+                const ParticleStore &particles);
+    void Solve(ParticleStore *particles);
+
+    unsigned int GetUnknownCount() const;
+    bool IsFactored() const;
+    const SparseLDLT &GetFactorization() const;
+
+
+private:
+    SparseLDLT factorization_;
+    bool analyzed_;
+    bool factored_;
+    float timeStep_;
+    float stiffness_;
+    // Free particle -> unknown, UINT_MAX for pinned particles; and back.
+    std::vector<unsigned int> unknown_;
+    std::vector<unsigned int> particle_;
+    // Both triangles of the matrix, see SparseLDLT::Analyze().
+    std::vector<unsigned int> columnStarts_;
+    std::vector<unsigned int> rows_;
+    std::vector<double> values_;
+    // Per unknown: m / h^2.
+    std::vector<double> inertiaWeight_;
+    // Per constraint: target edge (second particle minus first).
+    AlignedArray<float> targetX_;
+    AlignedArray<float> targetY_;
+    AlignedArray<float> targetZ_;
+    AlignedArray<float> inertiaX_;
+    AlignedArray<float> inertiaY_;
+    AlignedArray<float> inertiaZ_;
+    // Right-hand side / solution, x y z interleaved, and solver workspace.
+    std::vector<double> solution_;
+    std::vector<double> work_;
+
+    void Analyze(const DistanceConstraintBatch &constraints, const VertexIncidence &incidence, const ParticleStore &particles);
+
+};
+
+
+#endif // _PROJECTIVEDYNAMICS_H_
@@ -0,0 +1,430 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : SelfCollision.cpp
+ *
+ * Creation Date : 10/17/2026 - 21:20
+ * Last Modified : 10/18/2026 - 11:40
+ * ==========================================================================================
+ * Description   : References:
+ *                 (1) Macklin et al., "Unified Particle Physics for Real-Time Applications"
+ *                     (particle contacts, found once per step in a hash grid)
+ *
+ *                 (2) Verlet, "Computer Experiments on Classical Fluids" (neighbor lists with a
+ *                     skin, searched again once a particle has moved half of it)
+ *
+ *                 A pair only comes closer by the difference of its two displacements, so
+ *                 what is bounded by half the skin is the distance of each displacement to a
+ *                 common one, the center of their bounds: cloth falling or swinging as a whole
+ *                 keeps its candidates.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+
+#include "SelfCollision.h"
+#include "ParticleStore.h"
+#include "ThreadPool.h"
+
+
+const unsigned int SELF_COLLISION_MIN_CHUNK = 1024;
+
+// Cells are twice the search radius, so the box around a particle's search sphere overlaps
+// 2x2x2 cells.
+const unsigned int NEARBY_CELL_COUNT = 8;
+
+// With a skin, one search in this many is preceded by a search without it, for the stats.
+const unsigned int PLAIN_SEARCH_SAMPLE_INTERVAL = 16;
+
+typedef std::chrono::steady_clock Clock;
+
+
+// PUBLIC METHODS
+// --------------
+
+SelfCollisionSystem::SelfCollisionSystem()
+{
+    pairCount_ = 0;
+    cacheValid_ = false;
+    cacheRadius_ = 0.0f;
+    cacheSkin_ = 0.0f;
+    cacheReach_ = 0.0f;
+    cacheAge_ = 0;
+    plainSearches_ = 0;
+    plainSearchTotal_ = 0.0f;
+}
+
+void
+SelfCollisionSystem::Build(const VertexGraph &neighbors, unsigned int particleCount)
+{
+    neighbors_ = neighbors;
+    contacts_.Resize(particleCount * SELF_COLLISION_MAX_CONTACTS);
+    contactCount_.Resize(particleCount);
+    deltaX_.Resize(particleCount);
+    deltaY_.Resize(particleCount);
+    deltaZ_.Resize(particleCount);
+    pairCount_ = 0;
+
+    candidates_.Resize(particleCount * SELF_COLLISION_MAX_CANDIDATES);
+    candidateCount_.Resize(particleCount);
+    referenceX_.Resize(particleCount);
+    referenceY_.Resize(particleCount);
+    referenceZ_.Resize(particleCount);
+    cacheValid_ = false;
+    cacheStats_ = ContactCacheStats();
+    plainSearches_ = 0;
+    plainSearchTotal_ = 0.0f;
+}
+
+unsigned int
+SelfCollisionSystem::Detect(ThreadPool *pool, const ParticleStore &particles, float searchRadius, float skin,
+                            unsigned int interval)
+{
+    Clock::time_point start = Clock::now();
+    // Without reuse, a skin would only make the search longer.
+    skin = (interval > 1) ? std::max(skin, 0.0f) : 0.0f;
+
+    bool hit = cacheValid_ && (cacheRadius_ == searchRadius) && (cacheSkin_ == skin) && (cacheAge_ + 1 < interval);
+    if (hit)
+    {
+        // Candidates too many to keep shorten the skin (see SearchCandidates()).
+        float bound = 0.5f * (cacheReach_ - searchRadius);
+        hit = (bound > 0.0f) && (GetRelativeDisplacementSquared(pool, particles) <= bound * bound);
+    }
+
+    unsigned int searches = cacheStats_.Detections - cacheStats_.Hits;
+    float sampleTime = 0.0f;
+    if (hit)
+    {
+        ++cacheAge_;
+    }
+    else
+    {
+        // What this search would cost without the skin; its candidates are overwritten below.
+        if ((skin > 0.0f) && (searches % PLAIN_SEARCH_SAMPLE_INTERVAL == 0))
+        {
+            Clock::time_point sampleStart = Clock::now();
+            SearchCandidates(pool, particles, searchRadius);
+            FilterCandidates(pool, particles, searchRadius);
+            sampleTime = std::chrono::duration<float, std::milli>(Clock::now() - sampleStart).count();
+            plainSearchTotal_ += sampleTime;
+            ++plainSearches_;
+        }
+
+        cacheReach_ = SearchCandidates(pool, particles, searchRadius + skin);
+        cacheValid_ = true;
+        cacheRadius_ = searchRadius;
+        cacheSkin_ = skin;
+        cacheAge_ = 0;
+    }
+    pairCount_ = FilterCandidates(pool, particles, searchRadius);
+
+    float time = std::chrono::duration<float, std::milli>(Clock::now() - start).count() - sampleTime;
+    ++cacheStats_.Detections;
+    if (hit)
+    {
+        ++cacheStats_.Hits;
+        cacheStats_.HitTime += time;
+    }
+    else
+    {
+        cacheStats_.SearchTime += time;
+        if (skin <= 0.0f)
+        {
+            plainSearchTotal_ += time;
+            ++plainSearches_;
+        }
+    }
+    cacheStats_.HitRate = (float)cacheStats_.Hits / (float)cacheStats_.Detections;
+    cacheStats_.PlainSearchTime = (plainSearches_ > 0) ? plainSearchTotal_ / (float)plainSearches_ : 0.0f;
+    cacheStats_.TimeSaved = (float)cacheStats_.Detections * cacheStats_.PlainSearchTime
+                          - cacheStats_.SearchTime - cacheStats_.HitTime;
+    return pairCount_;
+}
+
+void
+SelfCollisionSystem::Solve(ThreadPool *pool, float thickness, ParticleStore *particles)
+{
+    unsigned int count = particles->GetCount();
+    float *px = particles->PredictedX.Data();
+    float *py = particles->PredictedY.Data();
+    float *pz = particles->PredictedZ.Data();
+    const float *w = particles->InvMass.Data();
+
+    pool->ParallelFor(0, count, SELF_COLLISION_MIN_CHUNK,
+        [&](unsigned int begin, unsigned int end, unsigned int)
+        {
+            for (unsigned int particle = begin; particle < end; ++particle)
+            {
+                const unsigned int *contacts = contacts_.Data() + particle * SELF_COLLISION_MAX_CONTACTS;
+                float sumX = 0.0f;
+                float sumY = 0.0f;
+                float sumZ = 0.0f;
+                unsigned int active = 0;
+                for (unsigned int contact = 0; contact < contactCount_[particle]; ++contact)
+                {
+                    unsigned int other = contacts[contact];
+                    float dx = px[particle] - px[other];
+                    float dy = py[particle] - py[other];
+                    float dz = pz[particle] - pz[other];
+                    float distance = sqrtf(dx*dx + dy*dy + dz*dz);
+                    if ((distance >= thickness) || (distance <= 0.0f))
+                    {
+                        continue;
+                    }
+
+                    // This particle's share of pushing the pair back to thickness apart.
+                    float share = w[particle] / (w[particle] + w[other]);
+                    float scale = share * (thickness - distance) / distance;
+                    sumX += scale * dx;
+                    sumY += scale * dy;
+                    sumZ += scale * dz;
+                    ++active;
+                }
+
+                float average = (active > 0) ? 1.0f / (float)active : 0.0f;
+                deltaX_[particle] = sumX * average;
+                deltaY_[particle] = sumY * average;
+                deltaZ_[particle] = sumZ * average;
+            }
+        });
+
+    pool->ParallelFor(0, count, SELF_COLLISION_MIN_CHUNK,
+        [&](unsigned int begin, unsigned int end, unsigned int)
+        {
+            for (unsigned int particle = begin; particle < end; ++particle)
+            {
+                px[particle] += deltaX_[particle];
+                py[particle] += deltaY_[particle];
+                pz[particle] += deltaZ_[particle];
+            }
+        });
+}
+
+void
+SelfCollisionSystem::InvalidateCache()
+{
+    cacheValid_ = false;
+}
+
+unsigned int
+SelfCollisionSystem::GetContactCount() const
+{
+    return pairCount_;
+}
+
+const SpatialHash &
+SelfCollisionSystem::GetHash() const
+{
+    return hash_;
+}
+
+const ContactCacheStats &
+SelfCollisionSystem::GetCacheStats() const
+{
+    return cacheStats_;
+}
+
+
+// PRIVATE METHODS
+// ---------------
+
+bool
+SelfCollisionSystem::AreNeighbors(unsigned int first, unsigned int second) const
+{
+    auto rowBegin = neighbors_.Neighbors.begin() + neighbors_.Offsets[first];
+    auto rowEnd = neighbors_.Neighbors.begin() + neighbors_.Offsets[first + 1];
+    return std::binary_search(rowBegin, rowEnd, second);
+}
+
+float
+SelfCollisionSystem::GetRelativeDisplacementSquared(ThreadPool *pool, const ParticleStore &particles)
+{
+    const float *px = particles.PredictedX.Data();
+    const float *py = particles.PredictedY.Data();
+    const float *pz = particles.PredictedZ.Data();
+
+    // Bounds of the displacements, per chunk.
+    chunkDisplacement_.assign(6 * pool->GetThreadCount(), 0.0f);
+    pool->ParallelFor(0, particles.GetCount(), SELF_COLLISION_MIN_CHUNK,
+        [&](unsigned int begin, unsigned int end, unsigned int chunk)
+        {
+            glm::vec3 low(FLT_MAX);
+            glm::vec3 high(-FLT_MAX);
+            for (unsigned int particle = begin; particle < end; ++particle)
+            {
+                glm::vec3 displacement(px[particle] - referenceX_[particle], py[particle] - referenceY_[particle],
+                                       pz[particle] - referenceZ_[particle]);
+                low = glm::min(low, displacement);
+                high = glm::max(high, displacement);
+            }
+            float *bounds = chunkDisplacement_.data() + 6 * chunk;
+            bounds[0] = low.x;
+            bounds[1] = low.y;
+            bounds[2] = low.z;
+            bounds[3] = high.x;
+            bounds[4] = high.y;
+            bounds[5] = high.z;
+        });
+
+    glm::vec3 low(FLT_MAX);
+    glm::vec3 high(-FLT_MAX);
+    for (unsigned int chunk = 0; chunk < pool->GetThreadCount(); ++chunk)
+    {
+        const float *bounds = chunkDisplacement_.data() + 6 * chunk;
+        if (bounds[0] <= bounds[3])
+        {
+            low = glm::min(low, glm::vec3(bounds[0], bounds[1], bounds[2]));
+            high = glm::max(high, glm::vec3(bounds[3], bounds[4], bounds[5]));
+        }
+    }
+    if (low.x > high.x)
+    {
+        return 0.0f;
+    }
+
+    // Half the diagonal: no displacement is further from the center of the bounds.
+    glm::vec3 halfExtent = 0.5f * (high - low);
+    return glm::dot(halfExtent, halfExtent);
+}
+
+float
+SelfCollisionSystem::SearchCandidates(ThreadPool *pool, const ParticleStore &particles, float radius)
+{
+    unsigned int count = particles.GetCount();
+    const float *px = particles.PredictedX.Data();
+    const float *py = particles.PredictedY.Data();
+    const float *pz = particles.PredictedZ.Data();
+    const float *w = particles.InvMass.Data();
+
+    hash_.Build(pool, px, py, pz, count, 2.0f * radius);
+
+    float radiusSquared = radius * radius;
+    const unsigned int *points = hash_.GetPoints();
+    const unsigned int *ranges = hash_.GetSlotRanges();
+    const float *sorted = hash_.GetSortedPositions();
+    chunkReach_.assign(pool->GetThreadCount(), radiusSquared);
+    // In index order, which on a mesh is spatially coherent (more so after MeshOptimizer), so
+    // consecutive particles look at mostly the same slots while they are still in cache. Hash
+    // order is not: consecutive slots are unrelated cells.
+    pool->ParallelFor(0, count, SELF_COLLISION_MIN_CHUNK,
+        [&](unsigned int begin, unsigned int end, unsigned int chunk)
+        {
+            float reachSquared = radiusSquared;
+            for (unsigned int particle = begin; particle < end; ++particle)
+            {
+                unsigned int *candidates = candidates_.Data() + particle * SELF_COLLISION_MAX_CANDIDATES;
+                float distances[SELF_COLLISION_MAX_CANDIDATES];
+                unsigned int found = 0;
+                // Pinned particles never move, their free partners do all the work.
+                if (w[particle] > 0.0f)
+                {
+                    float x = px[particle];
+                    float y = py[particle];
+                    float z = pz[particle];
+                    int cell[3];
+                    hash_.GetCell(x - radius, y - radius, z - radius, cell);
+
+                    for (unsigned int nearby = 0; nearby < NEARBY_CELL_COUNT; ++nearby)
+                    {
+                        unsigned int slot = hash_.GetSlot(cell[0] + (int)(nearby & 1), cell[1] + (int)((nearby >> 1) & 1),
+                                                          cell[2] + (int)(nearby >> 2));
+                        unsigned int slotEnd = ranges[2 * slot + 1];
+                        for (unsigned int entry = ranges[2 * slot]; entry < slotEnd; ++entry)
+                        {
+                            float dx = sorted[4 * entry] - x;
+                            float dy = sorted[4 * entry + 1] - y;
+                            float dz = sorted[4 * entry + 2] - z;
+                            float distanceSquared = dx*dx + dy*dy + dz*dz;
+                            unsigned int other = points[entry];
+                            if ((distanceSquared >= radiusSquared) || (other == particle) || AreNeighbors(particle, other))
+                            {
+                                continue;
+                            }
+                            // Nearby cells can share a slot, so the same particle can come up twice.
+                            if (std::find(candidates, candidates + found, other) != candidates + found)
+                            {
+                                continue;
+                            }
+
+                            if (found < SELF_COLLISION_MAX_CANDIDATES)
+                            {
+                                candidates[found] = other;
+                                distances[found++] = distanceSquared;
+                                continue;
+                            }
+
+                            // Full: the nearest are kept, and every candidate is only certain to
+                            // be found up to the nearest one dropped.
+                            unsigned int farthest = (unsigned int)(std::max_element(distances, distances + found) - distances);
+                            float dropped = distanceSquared;
+                            if (distanceSquared < distances[farthest])
+                            {
+                                dropped = distances[farthest];
+                                candidates[farthest] = other;
+                                distances[farthest] = distanceSquared;
+                            }
+                            reachSquared = std::min(reachSquared, dropped);
+                        }
+                    }
+                }
+                candidateCount_[particle] = found;
+                referenceX_[particle] = px[particle];
+                referenceY_[particle] = py[particle];
+                referenceZ_[particle] = pz[particle];
+            }
+            chunkReach_[chunk] = reachSquared;
+        });
+
+    return sqrtf(*std::min_element(chunkReach_.begin(), chunkReach_.end()));
+}
+
+unsigned int
+SelfCollisionSystem::FilterCandidates(ThreadPool *pool, const ParticleStore &particles, float searchRadius)
+{
+    const float *px = particles.PredictedX.Data();
+    const float *py = particles.PredictedY.Data();
+    const float *pz = particles.PredictedZ.Data();
+    const float *w = particles.InvMass.Data();
+    float radiusSquared = searchRadius * searchRadius;
+
+    chunkPairs_.assign(pool->GetThreadCount(), 0);
+    pool->ParallelFor(0, particles.GetCount(), SELF_COLLISION_MIN_CHUNK,
+        [&](unsigned int begin, unsigned int end, unsigned int chunk)
+        {
+            for (unsigned int particle = begin; particle < end; ++particle)
+            {
+                const unsigned int *candidates = candidates_.Data() + particle * SELF_COLLISION_MAX_CANDIDATES;
+                unsigned int *contacts = contacts_.Data() + particle * SELF_COLLISION_MAX_CONTACTS;
+                unsigned int found = 0;
+                float x = px[particle];
+                float y = py[particle];
+                float z = pz[particle];
+                for (unsigned int candidate = 0; (candidate < candidateCount_[particle]) && (found < SELF_COLLISION_MAX_CONTACTS); ++candidate)
+                {
+                    unsigned int other = candidates[candidate];
+                    float dx = px[other] - x;
+                    float dy = py[other] - y;
+                    float dz = pz[other] - z;
+                    if (dx*dx + dy*dy + dz*dz >= radiusSquared)
+                    {
+                        continue;
+                    }
+
+                    contacts[found++] = other;
+                    chunkPairs_[chunk] += ((particle < other) || (w[other] == 0.0f)) ? 1 : 0;
+                }
+                contactCount_[particle] = found;
+            }
+        });
+
+    unsigned int pairs = 0;
+    for (auto pairIt = chunkPairs_.begin(); pairIt != chunkPairs_.end(); ++pairIt)
+    {
+        pairs += *pairIt;
+    }
+    return pairs;
+}
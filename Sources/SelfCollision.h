@@ -0,0 +1,146 @@
+#ifndef _SELFCOLLISION_H_
+#define _SELFCOLLISION_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : SelfCollision.h
+ *
+ * Creation Date : 10/17/2026 - 21:20
+ * Last Modified : 10/18/2026 - 11:40
+ * ==========================================================================================
+ * Description   : Particle-particle self-collision. The particles are spheres of diameter
+ *                 thickness: once per substep, every particle looks for others within a search
+ *                 radius in a spatial hash of the predicted positions, skipping its topological
+ *                 neighbors; every iteration then pushes the pairs closer than thickness apart.
+ *
+ *                 Each particle keeps its own list of contacts (both ends of a pair list it), so
+ *                 both the search and the projection run in parallel over the particles with no
+ *                 atomics, and come out the same whatever the thread count.
+ *
+ *                 Cloth moves little from one substep to the next, so the hash search can be
+ *                 cached: it looks a skin further than the search radius, and its candidates
+ *                 are kept, with the positions they were found at, for the following substeps.
+ *                 As long as no particle has moved more than half the skin relative to the
+ *                 others since, every pair now within the search radius was within the radius
+ *                 plus the skin then, and only the candidates' distances need checking. The
+ *                 hash is searched again after a given number of substeps, or as soon as a
+ *                 particle moves too far.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+
+#include "AlignedArray.h"
+#include "SpatialHash.h"
+#include "VertexGraph.h"
+
+
+class ParticleStore;
+class ThreadPool;
+
+
+// Contacts kept per particle, the first ones found in point order, and candidates kept per
+// particle by the cache, the nearest ones found.
+const unsigned int SELF_COLLISION_MAX_CONTACTS = 16;
+const unsigned int SELF_COLLISION_MAX_CANDIDATES = 32;
+
+
+struct ContactCacheStats
+{
+    // Counted since Build(): calls to Detect(), and the ones that reused the cached candidates
+    // instead of searching the hash.
+    unsigned int Detections = 0;
+    unsigned int Hits = 0;
+    float HitRate = 0.0f;
+    // Milliseconds spent in Detect() searching the hash, and reusing the candidates.
+    float SearchTime = 0.0f;
+    float HitTime = 0.0f;
+    // Average milliseconds of a search without the skin: the searches themselves when there
+    // is none, otherwise a skinless search timed before one search in 16 (not counted above).
+    float PlainSearchTime = 0.0f;
+    // What searching every call without the skin would have cost, minus SearchTime + HitTime:
+    // the longer searches the skin makes count against the hits. Negative when the cache loses.
+    float TimeSaved = 0.0f;
+};
+
+
+class SelfCollisionSystem
+{
+
+public:
+    SelfCollisionSystem();
+
+    // Pairs of neighbors in the graph never collide.
+    void Build(const VertexGraph &neighbors, unsigned int particleCount);
+    // Finds every pair closer than searchRadius on the predicted positions. The hash is rebuilt
+    // and searched within searchRadius + skin at most once every interval calls, and whenever a
+    // particle has moved more than skin / 2 relative to the rest since the last search (a
+    // translation of the whole cloth does not count); the calls in between only
+    // check the distances of the candidates it found. A skin of 0 or an interval of 1 searches
+    // every time. Returns the number of pairs.
+    unsigned int Detect(ThreadPool *pool, const ParticleStore &particles, float searchRadius, float skin,
+                        unsigned int interval);
+    // Jacobi pass over the contacts found by Detect(): each particle moves by the average of
+    // its share of the corrections that bring its pairs back to thickness apart.
+    void Solve(ThreadPool *pool, float thickness, ParticleStore *particles);
+
+    // Forces the next Detect() to search the hash, e.g. when particles are pinned or unpinned
+    // (pinned particles have no candidates).
+    void InvalidateCache();
+
+    unsigned int GetContactCount() const;
+    const SpatialHash &GetHash() const;
+    const ContactCacheStats &GetCacheStats() const;
+
+
+private:
+    VertexGraph neighbors_;
+    SpatialHash hash_;
+    // Particle p's contacts are contacts_[p * SELF_COLLISION_MAX_CONTACTS, + contactCount_[p]).
+    AlignedArray<unsigned int> contacts_;
+    AlignedArray<unsigned int> contactCount_;
+    AlignedArray<float> deltaX_;
+    AlignedArray<float> deltaY_;
+    AlignedArray<float> deltaZ_;
+    unsigned int pairCount_;
+
+    // Particle p's candidates are candidates_[p * SELF_COLLISION_MAX_CANDIDATES,
+    // + candidateCount_[p]), found at the predicted positions in reference[XYZ]_ with the
+    // radius and skin below. Every pair closer than cacheReach_ then is a candidate.
+    // cacheAge_ counts the calls since.
+    AlignedArray<unsigned int> candidates_;
+    AlignedArray<unsigned int> candidateCount_;
+    AlignedArray<float> referenceX_;
+    AlignedArray<float> referenceY_;
+    AlignedArray<float> referenceZ_;
+    bool cacheValid_;
+    float cacheRadius_;
+    float cacheSkin_;
+    float cacheReach_;
+    unsigned int cacheAge_;
+    ContactCacheStats cacheStats_;
+    // Skinless searches timed for PlainSearchTime, and their total milliseconds.
+    unsigned int plainSearches_;
+    float plainSearchTotal_;
+    // Per thread-pool chunk: pairs, bounds of the displacements (low x, y, z, high x, y, z),
+    // and squared reach.
+    std::vector<unsigned int> chunkPairs_;
+    std::vector<float> chunkDisplacement_;
+    std::vector<float> chunkReach_;
+
+    bool AreNeighbors(unsigned int first, unsigned int second) const;
+    // Squared bound on how far any particle has moved since the candidates were found,
+    // relative to the others (see SelfCollision.cpp).
+    float GetRelativeDisplacementSquared(ThreadPool *pool, const ParticleStore &particles);
+    // Finds the candidates within radius, keeping the nearest ones when there are too many.
+    // Returns the distance up to which the candidates are complete: radius, or less if some
+    // had to be dropped.
+    float SearchCandidates(ThreadPool *pool, const ParticleStore &particles, float radius);
+    // Keeps the candidates closer than searchRadius as the contacts. Returns the number of pairs.
+    unsigned int FilterCandidates(ThreadPool *pool, const ParticleStore &particles, float searchRadius);
+
+};
+
+
+#endif // _SELFCOLLISION_H_
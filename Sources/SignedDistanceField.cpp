@@ -0,0 +1,508 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : SignedDistanceField.cpp
+ *
+ * Creation Date : 10/17/2026 - 22:35
+ * Last Modified : 10/17/2026 - 22:35
+ * ==========================================================================================
+ * Description   : References:
+ *                 (1) Baerentzen, Aanaes, "Signed Distance Computation Using the Angle Weighted
+ *                     Pseudonormal"
+ *
+ *                 (2) Ericson, "Real-Time Collision Detection" (closest point on a triangle,
+ *                     section 5.1.5)
+ *
+ *                 The band is filled triangle by triangle: every node in a triangle's box grown
+ *                 by the band keeps the closest triangle so far, signed by the pseudo-normal of
+ *                 the feature (face, edge or vertex) its closest point lies on. Cost is the
+ *                 triangle count times the nodes in a box, so a finer grid or a wider band
+ *                 costs more to build but nothing more to query.
+ *
+ *                 Cache file, in the machine's byte order: "CSDF", version, key, node counts,
+ *                 origin, cell size, band, mesh bounds, then the node values.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <utility>
+
+#include "SignedDistanceField.h"
+#include "Mesh.h"
+
+
+const char SDF_FILE_MAGIC[4] = { 'C', 'S', 'D', 'F' };
+const unsigned int SDF_FILE_VERSION = 1;
+
+const unsigned long long FNV_OFFSET_BASIS = 14695981039346656037ull;
+const unsigned long long FNV_PRIME = 1099511628211ull;
+
+
+// Feature of a triangle the closest point lies on: corners 0-2, edges 3-5 (corner e to corner
+// e + 1), or the face.
+enum TriangleFeature : unsigned char
+{
+    FEATURE_VERTEX = 0,
+    FEATURE_EDGE = 3,
+    FEATURE_FACE = 6
+};
+
+struct PositionLess
+{
+    bool
+    operator()(const glm::vec3 &left, const glm::vec3 &right) const
+    {
+        if (left.x != right.x)
+        {
+            return left.x < right.x;
+        }
+        if (left.y != right.y)
+        {
+            return left.y < right.y;
+        }
+        return left.z < right.z;
+    }
+};
+
+
+// FUNCTIONS
+// ---------
+
+static inline void
+HashBytes(const void *data, size_t size, unsigned long long *hash)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    for (size_t index = 0; index < size; ++index)
+    {
+        *hash = (*hash ^ bytes[index]) * FNV_PRIME;
+    }
+}
+
+// Closest point to p on triangle abc, and the feature it lies on.
+static glm::vec3
+ClosestPointOnTriangle(const glm::vec3 &p, const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c,
+                       unsigned int *feature)
+{
+    glm::vec3 ab = b - a;
+    glm::vec3 ac = c - a;
+    glm::vec3 ap = p - a;
+    float d1 = glm::dot(ab, ap);
+    float d2 = glm::dot(ac, ap);
+    if ((d1 <= 0.0f) && (d2 <= 0.0f))
+    {
+        *feature = FEATURE_VERTEX;
+        return a;
+    }
+
+    glm::vec3 bp = p - b;
+    float d3 = glm::dot(ab, bp);
+    float d4 = glm::dot(ac, bp);
+    if ((d3 >= 0.0f) && (d4 <= d3))
+    {
+        *feature = FEATURE_VERTEX + 1;
+        return b;
+    }
+
+    float vc = d1*d4 - d3*d2;
+    if ((vc <= 0.0f) && (d1 >= 0.0f) && (d3 <= 0.0f))
+    {
+        *feature = FEATURE_EDGE;
+        return a + (d1 / (d1 - d3)) * ab;
+    }
+
+    glm::vec3 cp = p - c;
+    float d5 = glm::dot(ab, cp);
+    float d6 = glm::dot(ac, cp);
+    if ((d6 >= 0.0f) && (d5 <= d6))
+    {
+        *feature = FEATURE_VERTEX + 2;
+        return c;
+    }
+
+    float vb = d5*d2 - d1*d6;
+    if ((vb <= 0.0f) && (d2 >= 0.0f) && (d6 <= 0.0f))
+    {
+        *feature = FEATURE_EDGE + 2;
+        return a + (d2 / (d2 - d6)) * ac;
+    }
+
+    float va = d3*d6 - d5*d4;
+    if ((va <= 0.0f) && (d4 - d3 >= 0.0f) && (d5 - d6 >= 0.0f))
+    {
+        *feature = FEATURE_EDGE + 1;
+        return b + ((d4 - d3) / ((d4 - d3) + (d5 - d6))) * (c - b);
+    }
+
+    *feature = FEATURE_FACE;
+    float denominator = 1.0f / (va + vb + vc);
+    return a + (vb * denominator) * ab + (vc * denominator) * ac;
+}
+
+unsigned long long
+ComputeSignedDistanceFieldKey(const std::vector<Mesh> &meshes, unsigned int resolution, unsigned int bandCells)
+{
+    unsigned long long hash = FNV_OFFSET_BASIS;
+    HashBytes(&SDF_FILE_VERSION, sizeof(SDF_FILE_VERSION), &hash);
+    HashBytes(&resolution, sizeof(resolution), &hash);
+    HashBytes(&bandCells, sizeof(bandCells), &hash);
+    // Corner positions face by face, so the vertex numbering does not matter.
+    for (auto meshIt = meshes.begin(); meshIt != meshes.end(); ++meshIt)
+    {
+        for (auto faceIt = meshIt->Faces.begin(); faceIt != meshIt->Faces.end(); ++faceIt)
+        {
+            for (unsigned int corner = 0; corner < 3; ++corner)
+            {
+                const glm::vec3 &position = meshIt->Vertices[faceIt->Indices[corner]].Position;
+                HashBytes(&position.x, 3 * sizeof(float), &hash);
+            }
+        }
+    }
+    return hash;
+}
+
+bool
+LoadOrBuildSignedDistanceField(const std::vector<Mesh> &meshes, unsigned int resolution, unsigned int bandCells,
+                               const std::string &cachePath, SignedDistanceField *field)
+{
+    if (field->Load(cachePath, ComputeSignedDistanceFieldKey(meshes, resolution, bandCells)))
+    {
+        return true;
+    }
+
+    field->Build(meshes, resolution, bandCells);
+    field->Save(cachePath);
+    return false;
+}
+
+
+// PUBLIC METHODS
+// --------------
+
+SignedDistanceField::SignedDistanceField()
+{
+    key_ = 0;
+    // One node wide: every sample falls outside an empty field.
+    resolution_[0] = resolution_[1] = resolution_[2] = 1;
+    origin_ = glm::vec3(0.0f);
+    cellSize_ = 1.0f;
+    inverseCellSize_ = 1.0f;
+    band_ = 0.0f;
+    boundsMin_ = glm::vec3(0.0f);
+    boundsMax_ = glm::vec3(0.0f);
+}
+
+void
+SignedDistanceField::Build(const std::vector<Mesh> &meshes, unsigned int resolution, unsigned int bandCells)
+{
+    *this = SignedDistanceField();
+    key_ = ComputeSignedDistanceFieldKey(meshes, resolution, bandCells);
+
+    // Weld the corners by position.
+    std::map<glm::vec3, unsigned int, PositionLess> welded;
+    std::vector<glm::vec3> positions;
+    std::vector<unsigned int> triangles;
+    for (auto meshIt = meshes.begin(); meshIt != meshes.end(); ++meshIt)
+    {
+        for (auto faceIt = meshIt->Faces.begin(); faceIt != meshIt->Faces.end(); ++faceIt)
+        {
+            for (unsigned int corner = 0; corner < 3; ++corner)
+            {
+                const glm::vec3 &position = meshIt->Vertices[faceIt->Indices[corner]].Position;
+                auto weldIt = welded.insert(std::make_pair(position, (unsigned int)positions.size())).first;
+                if (weldIt->second == positions.size())
+                {
+                    positions.push_back(position);
+                }
+                triangles.push_back(weldIt->second);
+            }
+        }
+    }
+    if (triangles.empty())
+    {
+        return;
+    }
+
+    boundsMin_ = positions[0];
+    boundsMax_ = positions[0];
+    for (auto positionIt = positions.begin(); positionIt != positions.end(); ++positionIt)
+    {
+        boundsMin_ = glm::min(boundsMin_, *positionIt);
+        boundsMax_ = glm::max(boundsMax_, *positionIt);
+    }
+    glm::vec3 extent = boundsMax_ - boundsMin_;
+    float longest = std::max(std::max(extent.x, extent.y), extent.z);
+    if (longest <= 0.0f)
+    {
+        return;
+    }
+
+    cellSize_ = longest / (float)(std::max(resolution, 2u) - 1);
+    inverseCellSize_ = 1.0f / cellSize_;
+    band_ = (float)std::max(bandCells, 1u) * cellSize_;
+    // A band and a cell of padding: the border nodes are all beyond the band, where the flood
+    // fill starts.
+    float padding = band_ + cellSize_;
+    origin_ = boundsMin_ - glm::vec3(padding);
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+        resolution_[axis] = (unsigned int)ceilf((extent[axis] + 2.0f * padding) * inverseCellSize_) + 1;
+    }
+    unsigned int strideY = resolution_[0];
+    unsigned int strideZ = resolution_[0] * resolution_[1];
+    unsigned int nodeCount = strideZ * resolution_[2];
+
+    // Angle-weighted pseudo-normals: the face normal, the sum of the two faces' normals at an
+    // edge, and the sum of the faces' normals weighted by their angle at a vertex.
+    // Wound clockwise (negative volume), the faces point inward: their normals are flipped.
+    unsigned int triangleCount = (unsigned int)triangles.size() / 3;
+    float volume = 0.0f;
+    for (unsigned int triangle = 0; triangle < triangleCount; ++triangle)
+    {
+        const unsigned int *corners = triangles.data() + 3 * triangle;
+        volume += glm::dot(positions[corners[0]] - boundsMin_,
+                           glm::cross(positions[corners[1]] - boundsMin_, positions[corners[2]] - boundsMin_));
+    }
+    float orientation = (volume < 0.0f) ? -1.0f : 1.0f;
+
+    std::vector<glm::vec3> faceNormals(triangleCount);
+    std::vector<glm::vec3> vertexNormals(positions.size(), glm::vec3(0.0f));
+    std::map<std::pair<unsigned int, unsigned int>, glm::vec3> edgeNormals;
+    for (unsigned int triangle = 0; triangle < triangleCount; ++triangle)
+    {
+        const unsigned int *corners = triangles.data() + 3 * triangle;
+        glm::vec3 normal = glm::cross(positions[corners[1]] - positions[corners[0]], positions[corners[2]] - positions[corners[0]]);
+        float length = glm::length(normal);
+        faceNormals[triangle] = (length > 0.0f) ? (orientation / length) * normal : glm::vec3(0.0f);
+
+        for (unsigned int corner = 0; corner < 3; ++corner)
+        {
+            unsigned int vertex = corners[corner];
+            unsigned int next = corners[(corner + 1) % 3];
+            unsigned int previous = corners[(corner + 2) % 3];
+            glm::vec3 toNext = positions[next] - positions[vertex];
+            glm::vec3 toPrevious = positions[previous] - positions[vertex];
+            float lengths = glm::length(toNext) * glm::length(toPrevious);
+            float angle = (lengths > 0.0f) ? acosf(std::min(std::max(glm::dot(toNext, toPrevious) / lengths, -1.0f), 1.0f)) : 0.0f;
+            vertexNormals[vertex] += angle * faceNormals[triangle];
+            edgeNormals[std::make_pair(std::min(vertex, next), std::max(vertex, next))] += faceNormals[triangle];
+        }
+    }
+
+    // Per triangle, the pseudo-normal of each of its features in TriangleFeature order.
+    std::vector<glm::vec3> featureNormals(7 * triangleCount);
+    for (unsigned int triangle = 0; triangle < triangleCount; ++triangle)
+    {
+        const unsigned int *corners = triangles.data() + 3 * triangle;
+        glm::vec3 *normals = featureNormals.data() + 7 * triangle;
+        for (unsigned int corner = 0; corner < 3; ++corner)
+        {
+            unsigned int vertex = corners[corner];
+            unsigned int next = corners[(corner + 1) % 3];
+            normals[FEATURE_VERTEX + corner] = vertexNormals[vertex];
+            normals[FEATURE_EDGE + corner] = edgeNormals[std::make_pair(std::min(vertex, next), std::max(vertex, next))];
+        }
+        normals[FEATURE_FACE] = faceNormals[triangle];
+    }
+
+    values_.assign(nodeCount, band_);
+    std::vector<float> nearest(nodeCount, band_);
+    std::vector<unsigned char> inBand(nodeCount, 0);
+    for (unsigned int triangle = 0; triangle < triangleCount; ++triangle)
+    {
+        const unsigned int *corners = triangles.data() + 3 * triangle;
+        glm::vec3 a = positions[corners[0]];
+        glm::vec3 b = positions[corners[1]];
+        glm::vec3 c = positions[corners[2]];
+        glm::vec3 low = (glm::min(glm::min(a, b), c) - glm::vec3(band_) - origin_) * inverseCellSize_;
+        glm::vec3 high = (glm::max(glm::max(a, b), c) + glm::vec3(band_) - origin_) * inverseCellSize_;
+        unsigned int first[3];
+        unsigned int last[3];
+        for (unsigned int axis = 0; axis < 3; ++axis)
+        {
+            first[axis] = (unsigned int)std::max(ceilf(low[axis]), 0.0f);
+            last[axis] = std::min((unsigned int)high[axis], resolution_[axis] - 1);
+        }
+
+        for (unsigned int k = first[2]; k <= last[2]; ++k)
+        {
+            for (unsigned int j = first[1]; j <= last[1]; ++j)
+            {
+                for (unsigned int i = first[0]; i <= last[0]; ++i)
+                {
+                    unsigned int node = i + strideY * j + strideZ * k;
+                    glm::vec3 point = origin_ + cellSize_ * glm::vec3((float)i, (float)j, (float)k);
+                    unsigned int feature;
+                    glm::vec3 closest = ClosestPointOnTriangle(point, a, b, c, &feature);
+                    float distance = glm::length(point - closest);
+                    if (distance >= nearest[node])
+                    {
+                        continue;
+                    }
+
+                    nearest[node] = distance;
+                    inBand[node] = 1;
+                    bool inside = (glm::dot(point - closest, featureNormals[7 * triangle + feature]) < 0.0f);
+                    values_[node] = inside ? -distance : distance;
+                }
+            }
+        }
+    }
+
+    // Beyond the band, whatever the border can reach without crossing it is outside.
+    std::vector<unsigned char> outside(nodeCount, 0);
+    std::vector<unsigned int> stack;
+    for (unsigned int node = 0; node < nodeCount; ++node)
+    {
+        unsigned int i = node % strideY;
+        unsigned int j = (node / strideY) % resolution_[1];
+        unsigned int k = node / strideZ;
+        bool border = (i == 0) || (j == 0) || (k == 0) || (i + 1 == resolution_[0]) || (j + 1 == resolution_[1])
+                   || (k + 1 == resolution_[2]);
+        if (border && !inBand[node])
+        {
+            outside[node] = 1;
+            stack.push_back(node);
+        }
+    }
+    while (!stack.empty())
+    {
+        unsigned int node = stack.back();
+        stack.pop_back();
+        unsigned int i = node % strideY;
+        unsigned int j = (node / strideY) % resolution_[1];
+        unsigned int k = node / strideZ;
+        unsigned int neighbors[6];
+        unsigned int neighborCount = 0;
+        if (i > 0) neighbors[neighborCount++] = node - 1;
+        if (i + 1 < resolution_[0]) neighbors[neighborCount++] = node + 1;
+        if (j > 0) neighbors[neighborCount++] = node - strideY;
+        if (j + 1 < resolution_[1]) neighbors[neighborCount++] = node + strideY;
+        if (k > 0) neighbors[neighborCount++] = node - strideZ;
+        if (k + 1 < resolution_[2]) neighbors[neighborCount++] = node + strideZ;
+        for (unsigned int neighbor = 0; neighbor < neighborCount; ++neighbor)
+        {
+            unsigned int next = neighbors[neighbor];
+            if (!inBand[next] && !outside[next])
+            {
+                outside[next] = 1;
+                stack.push_back(next);
+            }
+        }
+    }
+    for (unsigned int node = 0; node < nodeCount; ++node)
+    {
+        if (!inBand[node] && !outside[node])
+        {
+            values_[node] = -band_;
+        }
+    }
+}
+
+bool
+SignedDistanceField::Save(const std::string &path) const
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    file.write(SDF_FILE_MAGIC, sizeof(SDF_FILE_MAGIC));
+    file.write((const char *)&SDF_FILE_VERSION, sizeof(SDF_FILE_VERSION));
+    file.write((const char *)&key_, sizeof(key_));
+    file.write((const char *)resolution_, sizeof(resolution_));
+    file.write((const char *)&origin_.x, 3 * sizeof(float));
+    file.write((const char *)&cellSize_, sizeof(cellSize_));
+    file.write((const char *)&band_, sizeof(band_));
+    file.write((const char *)&boundsMin_.x, 3 * sizeof(float));
+    file.write((const char *)&boundsMax_.x, 3 * sizeof(float));
+    file.write((const char *)values_.data(), (std::streamsize)(values_.size() * sizeof(float)));
+    return (bool)file;
+}
+
+bool
+SignedDistanceField::Load(const std::string &path, unsigned long long key)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    char magic[4];
+    unsigned int version = 0;
+    SignedDistanceField loaded;
+    file.read(magic, sizeof(magic));
+    file.read((char *)&version, sizeof(version));
+    file.read((char *)&loaded.key_, sizeof(loaded.key_));
+    if (!file || !std::equal(magic, magic + 4, SDF_FILE_MAGIC) || (version != SDF_FILE_VERSION) || (loaded.key_ != key))
+    {
+        return false;
+    }
+
+    file.read((char *)loaded.resolution_, sizeof(loaded.resolution_));
+    file.read((char *)&loaded.origin_.x, 3 * sizeof(float));
+    file.read((char *)&loaded.cellSize_, sizeof(loaded.cellSize_));
+    file.read((char *)&loaded.band_, sizeof(loaded.band_));
+    file.read((char *)&loaded.boundsMin_.x, 3 * sizeof(float));
+    file.read((char *)&loaded.boundsMax_.x, 3 * sizeof(float));
+    if (!file || (loaded.cellSize_ <= 0.0f))
+    {
+        return false;
+    }
+
+    loaded.inverseCellSize_ = 1.0f / loaded.cellSize_;
+    loaded.values_.resize((size_t)loaded.resolution_[0] * loaded.resolution_[1] * loaded.resolution_[2]);
+    file.read((char *)loaded.values_.data(), (std::streamsize)(loaded.values_.size() * sizeof(float)));
+    if (!file)
+    {
+        return false;
+    }
+
+    *this = loaded;
+    return true;
+}
+
+bool
+SignedDistanceField::IsEmpty() const
+{
+    return values_.empty();
+}
+
+unsigned long long
+SignedDistanceField::GetKey() const
+{
+    return key_;
+}
+
+float
+SignedDistanceField::GetCellSize() const
+{
+    return cellSize_;
+}
+
+float
+SignedDistanceField::GetBand() const
+{
+    return band_;
+}
+
+glm::vec3
+SignedDistanceField::GetBoundsMin() const
+{
+    return boundsMin_;
+}
+
+glm::vec3
+SignedDistanceField::GetBoundsMax() const
+{
+    return boundsMax_;
+}
+
+unsigned int
+SignedDistanceField::GetNodeCount() const
+{
+    return (unsigned int)values_.size();
+}
@@ -0,0 +1,150 @@
+#ifndef _SIGNEDDISTANCEFIELD_H_
+#define _SIGNEDDISTANCEFIELD_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : SignedDistanceField.h
+ *
+ * Creation Date : 10/17/2026 - 22:35
+ * Last Modified : 10/17/2026 - 22:35
+ * ==========================================================================================
+ * Description   : Signed distance to a triangle mesh (e.g. a Model's meshes), sampled on a
+ *                 regular grid: negative inside, positive outside. A query reads the 8 nodes
+ *                 around the point and interpolates them trilinearly, so it costs the same
+ *                 however many triangles the mesh has.
+ *
+ *                 Only the nodes within a narrow band of the surface get an exact distance;
+ *                 the others are clamped to plus or minus the band, which is all a collider
+ *                 needs. Inside and outside are told apart near the surface by the
+ *                 angle-weighted pseudo-normal of the closest feature, and beyond the band by a
+ *                 flood fill from the border of the grid, so the mesh must be closed. Its
+ *                 faces may be wound either way, as long as they all agree.
+ *
+ *                 Voxelizing takes time, so a field can be saved to a cache file tagged with a
+ *                 hash of the mesh and settings it came from, and loaded back as long as they
+ *                 still match (see LoadOrBuildSignedDistanceField()).
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include "glm/glm.hpp"
+
+
+class Mesh;
+
+
+// Nodes along the longest side of the mesh's bounds, and half-width of the band in cells.
+const unsigned int SDF_RESOLUTION = 64;
+const unsigned int SDF_BAND_CELLS = 3;
+
+
+class SignedDistanceField
+{
+
+public:
+    SignedDistanceField();
+
+    // Voxelizes the faces of every mesh, welding vertices at the same position so seams in the
+    // UVs or normals do not open the surface.
+    void Build(const std::vector<Mesh> &meshes, unsigned int resolution, unsigned int bandCells);
+    bool Save(const std::string &path) const;
+    // Fails, leaving the field as it was, if the file is missing or was made from another key.
+    bool Load(const std::string &path, unsigned long long key);
+
+    bool IsEmpty() const;
+    // Hash of the meshes and settings the field was built from.
+    unsigned long long GetKey() const;
+    float GetCellSize() const;
+    float GetBand() const;
+    // Bounds of the mesh itself; the grid extends a band and a cell beyond them.
+    glm::vec3 GetBoundsMin() const;
+    glm::vec3 GetBoundsMax() const;
+    unsigned int GetNodeCount() const;
+
+    // Distance at a point, and its gradient (of length about 1 in the band). Points outside the
+    // grid are further than the band from the surface: they get the band and a zero gradient.
+    float Sample(const glm::vec3 &point, glm::vec3 *gradient) const;
+
+
+private:
+    unsigned long long key_;
+    unsigned int resolution_[3];
+    glm::vec3 origin_;
+    float cellSize_;
+    float inverseCellSize_;
+    float band_;
+    glm::vec3 boundsMin_;
+    glm::vec3 boundsMax_;
+    // Node (i, j, k) is values_[i + resolution_[0] * (j + resolution_[1] * k)].
+    std::vector<float> values_;
+
+};
+
+
+// FUNCTIONS
+// ---------
+
+// Key of a field built from these meshes with these settings.
+unsigned long long ComputeSignedDistanceFieldKey(const std::vector<Mesh> &meshes, unsigned int resolution,
+                                                 unsigned int bandCells);
+// Loads cachePath if it holds the field of these meshes and settings, otherwise builds it and
+// writes it there. Returns true on a cache hit.
+bool LoadOrBuildSignedDistanceField(const std::vector<Mesh> &meshes, unsigned int resolution,
+                                    unsigned int bandCells, const std::string &cachePath,
+                                    SignedDistanceField *field);
+
+
+// Inline, the collider pass calls it for every particle.
+
+inline float
+SignedDistanceField::Sample(const glm::vec3 &point, glm::vec3 *gradient) const
+{
+    glm::vec3 cell = (point - origin_) * inverseCellSize_;
+    if ((cell.x < 0.0f) || (cell.y < 0.0f) || (cell.z < 0.0f)
+        || (cell.x >= (float)(resolution_[0] - 1)) || (cell.y >= (float)(resolution_[1] - 1))
+        || (cell.z >= (float)(resolution_[2] - 1)))
+    {
+        *gradient = glm::vec3(0.0f);
+        return band_;
+    }
+
+    unsigned int i = (unsigned int)cell.x;
+    unsigned int j = (unsigned int)cell.y;
+    unsigned int k = (unsigned int)cell.z;
+    float fx = cell.x - (float)i;
+    float fy = cell.y - (float)j;
+    float fz = cell.z - (float)k;
+    unsigned int strideY = resolution_[0];
+    unsigned int strideZ = resolution_[0] * resolution_[1];
+    const float *c = values_.data() + i + strideY * j + strideZ * k;
+    float c000 = c[0];
+    float c100 = c[1];
+    float c010 = c[strideY];
+    float c110 = c[strideY + 1];
+    float c001 = c[strideZ];
+    float c101 = c[strideZ + 1];
+    float c011 = c[strideZ + strideY];
+    float c111 = c[strideZ + strideY + 1];
+
+    // Interpolate along x, then y, then z; the gradient is the derivative of the same
+    // polynomial, so it is exact for the interpolated field.
+    float c00 = c000 + fx * (c100 - c000);
+    float c10 = c010 + fx * (c110 - c010);
+    float c01 = c001 + fx * (c101 - c001);
+    float c11 = c011 + fx * (c111 - c011);
+    float c0 = c00 + fy * (c10 - c00);
+    float c1 = c01 + fy * (c11 - c01);
+
+    float dx0 = (c100 - c000) + fy * ((c110 - c010) - (c100 - c000));
+    float dx1 = (c101 - c001) + fy * ((c111 - c011) - (c101 - c001));
+    gradient->x = (dx0 + fz * (dx1 - dx0)) * inverseCellSize_;
+    gradient->y = ((c10 - c00) + fz * ((c11 - c01) - (c10 - c00))) * inverseCellSize_;
+    gradient->z = (c1 - c0) * inverseCellSize_;
+    return c0 + fz * (c1 - c0);
+}
+
+
+#endif // _SIGNEDDISTANCEFIELD_H_
@@ -0,0 +1,182 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : SimulationThread.cpp
+ *
+ * Creation Date : 10/17/2026 - 16:05
+ * Last Modified : 10/17/2026 - 16:30
+ * ==========================================================================================
+ * Description   : References:
+ *                 (1) Glenn Fiedler, "Fix Your Timestep!"
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <chrono>
+
+#include "SimulationThread.h"
+#include "Mesh.h"
+
+
+// After a long stall (debugger, window drag...) only this many steps are replayed; the rest of
+// the backlog is dropped instead of spiraling into ever longer catch-up frames.
+const unsigned int MAX_STEPS_PER_UPDATE = 4;
+
+
+void
+SimulationState::WriteTo(Mesh *mesh) const
+{
+    for (unsigned int index = 0; index < Positions.size(); ++index)
+    {
+        mesh->Vertices[index].Position = Positions[index];
+    }
+}
+
+
+// PUBLIC METHODS
+// --------------
+
+SimulationThread::SimulationThread(ClothSolver *solver, double stepRate)
+    : running_(false), paused_(false), droppedSteps_(0)
+{
+    solver_ = solver;
+    stepNanoseconds_ = (int64_t)(1e9 / stepRate);
+
+    for (unsigned int slot = 0; slot < 3; ++slot)
+    {
+        states_.GetSlot(slot).Positions.resize(solver->GetVertexCount());
+        states_.GetSlot(slot).Velocities.resize(solver->GetVertexCount());
+    }
+    PublishState(0);
+    states_.Acquire();
+}
+
+SimulationThread::~SimulationThread()
+{
+    Stop();
+}
+
+void
+SimulationThread::Start()
+{
+    if (!running_.exchange(true))
+    {
+        thread_ = std::thread(&SimulationThread::Run, this);
+    }
+}
+
+void
+SimulationThread::Stop()
+{
+    if (running_.exchange(false))
+    {
+        thread_.join();
+    }
+}
+
+void
+SimulationThread::SetPaused(bool paused)
+{
+    paused_.store(paused, std::memory_order_relaxed);
+}
+
+bool
+SimulationThread::IsPaused() const
+{
+    return paused_.load(std::memory_order_relaxed);
+}
+
+bool
+SimulationThread::AcquireLatest()
+{
+    return states_.Acquire();
+}
+
+const SimulationState &
+SimulationThread::GetLatest() const
+{
+    return states_.GetFront();
+}
+
+double
+SimulationThread::GetStepSize() const
+{
+    return (double)stepNanoseconds_ * 1e-9;
+}
+
+uint64_t
+SimulationThread::GetDroppedStepCount() const
+{
+    return droppedSteps_.load(std::memory_order_relaxed);
+}
+
+
+// PRIVATE METHODS
+// ---------------
+
+void
+SimulationThread::Run()
+{
+    typedef std::chrono::steady_clock Clock;
+
+    float stepSize = (float)GetStepSize();
+    uint64_t step = 0;
+    int64_t accumulator = 0;
+    Clock::time_point lastTime = Clock::now();
+
+    while (running_.load(std::memory_order_relaxed))
+    {
+        Clock::time_point now = Clock::now();
+        int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastTime).count();
+        lastTime = now;
+
+        if (paused_.load(std::memory_order_relaxed))
+        {
+            accumulator = 0;
+        }
+        else
+        {
+            accumulator += elapsed;
+
+            unsigned int stepCount = 0;
+            while ((accumulator >= stepNanoseconds_) && (stepCount < MAX_STEPS_PER_UPDATE))
+            {
+                solver_->Step(stepSize);
+                accumulator -= stepNanoseconds_;
+                ++stepCount;
+                ++step;
+            }
+
+            if (accumulator >= stepNanoseconds_)
+            {
+                droppedSteps_.fetch_add((uint64_t)(accumulator / stepNanoseconds_), std::memory_order_relaxed);
+                accumulator %= stepNanoseconds_;
+            }
+
+            if (stepCount > 0)
+            {
+                PublishState(step);
+            }
+        }
+
+        // Sleep until the next step is due.
+        std::this_thread::sleep_until(now + std::chrono::nanoseconds(stepNanoseconds_ - accumulator));
+    }
+}
+
+void
+SimulationThread::PublishState(uint64_t step)
+{
+    SimulationState &state = states_.GetBack();
+    const ParticleStore &particles = solver_->GetParticles();
+    for (unsigned int index = 0; index < state.Positions.size(); ++index)
+    {
+        state.Positions[index] = particles.GetPosition(index);
+        state.Velocities[index] = glm::vec3(particles.VelocityX[index], particles.VelocityY[index], particles.VelocityZ[index]);
+    }
+    state.Step = step;
+    state.Time = (double)step * GetStepSize();
+    state.PublishTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    states_.Publish();
+}
@@ -0,0 +1,90 @@
+#ifndef _SIMULATIONTHREAD_H_
+#define _SIMULATIONTHREAD_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : SimulationThread.h
+ *
+ * Creation Date : 10/17/2026 - 16:05
+ * Last Modified : 10/17/2026 - 16:30
+ * ==========================================================================================
+ * Description   : Runs a ClothSolver on its own thread at a fixed time step.
+ *                 Time is accumulated in integer nanoseconds from a monotonic clock, so the
+ *                 step size never drifts and the clock does not lose precision with uptime.
+ *                 Every completed step is published through a TripleBuffer; the render loop
+ *                 picks up the newest state without ever waiting on the solver.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include "glm/glm.hpp"
+
+#include "ClothSolver.h"
+#include "TripleBuffer.h"
+
+
+class Mesh;
+
+
+struct SimulationState
+{
+    std::vector<glm::vec3> Positions;
+    std::vector<glm::vec3> Velocities;
+    // Number of fixed steps taken, and the matching simulation time in seconds.
+    uint64_t Step = 0;
+    double Time = 0.0;
+    // steady_clock time the state was published at, in nanoseconds.
+    int64_t PublishTime = 0;
+
+    void WriteTo(Mesh *mesh) const;
+};
+
+
+class SimulationThread
+{
+
+public:
+    // The solver belongs to the simulation thread between Start() and Stop().
+    SimulationThread(ClothSolver *solver, double stepRate = 60.0);
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread &) = delete;
+    SimulationThread &operator=(const SimulationThread &) = delete;
+
+    void Start();
+    void Stop();
+
+    // A paused simulation does not accumulate time, so unpausing does not trigger a burst of
+    // catch-up steps.
+    void SetPaused(bool paused);
+    bool IsPaused() const;
+
+    // Render thread only. Returns true if a newer state was published since the last call.
+    bool AcquireLatest();
+    const SimulationState &GetLatest() const;
+
+    double GetStepSize() const;
+    // Steps skipped because the solver could not keep up with real time.
+    uint64_t GetDroppedStepCount() const;
+
+
+private:
+    ClothSolver *solver_;
+    int64_t stepNanoseconds_;
+    TripleBuffer<SimulationState> states_;
+    std::thread thread_;
+    std::atomic<bool> running_;
+    std::atomic<bool> paused_;
+    std::atomic<uint64_t> droppedSteps_;
+
+    void Run();
+    void PublishState(uint64_t step);
+
+};
+
+
+#endif // _SIMULATIONTHREAD_H_
@@ -0,0 +1,295 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : SparseLDLT.cpp
+ *
+ * Creation Date : 10/17/2026 - 19:15
+ * Last Modified : 10/17/2026 - 19:15
+ * ==========================================================================================
+ * Description   : References:
+ *                 (1) Davis, "Algorithm 849: A Concise Sparse Cholesky Factorization Package"
+ *                     (up-looking LDL^T, elimination tree and row patterns)
+ *
+ *                 (2) George, Liu, "The Evolution of the Minimum Degree Ordering Algorithm"
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <algorithm>
+#include <queue>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+#include "SparseLDLT.h"
+
+
+// PUBLIC METHODS
+// --------------
+
+SparseLDLT::SparseLDLT()
+{
+    size_ = 0;
+}
+
+void
+SparseLDLT::Analyze(unsigned int size, const std::vector<unsigned int> &columnStarts, const std::vector<unsigned int> &rows)
+{
+    size_ = size;
+    columnStarts_ = columnStarts;
+    rows_ = rows;
+
+    permutation_ = ComputeMinimumDegreeOrdering(size, columnStarts, rows);
+    inversePermutation_.resize(size);
+    for (unsigned int k = 0; k < size; ++k)
+    {
+        inversePermutation_[permutation_[k]] = k;
+    }
+
+    // Elimination tree and column counts of L, c.f. ldl_symbolic.
+    std::vector<unsigned int> flag(size);
+    std::vector<unsigned int> columnCount(size);
+    parent_.assign(size, -1);
+    for (unsigned int k = 0; k < size; ++k)
+    {
+        flag[k] = k;
+        columnCount[k] = 0;
+
+        unsigned int column = permutation_[k];
+        for (unsigned int entry = columnStarts[column]; entry < columnStarts[column + 1]; ++entry)
+        {
+            unsigned int i = inversePermutation_[rows[entry]];
+            if (i >= k)
+            {
+                continue;
+            }
+
+            // Walk up the tree from i until a node already visited for row k.
+            for (; flag[i] != k; i = (unsigned int)parent_[i])
+            {
+                if (parent_[i] == -1)
+                {
+                    parent_[i] = (int)k;
+                }
+                ++columnCount[i];
+                flag[i] = k;
+            }
+        }
+    }
+
+    factorStarts_.resize(size + 1);
+    factorStarts_[0] = 0;
+    for (unsigned int k = 0; k < size; ++k)
+    {
+        factorStarts_[k + 1] = factorStarts_[k] + columnCount[k];
+    }
+    factorRows_.resize(factorStarts_[size]);
+    factorValues_.resize(factorStarts_[size]);
+    diagonal_.resize(size);
+}
+
+bool
+SparseLDLT::Factor(const std::vector<double> &values)
+{
+    // Up-looking factorization: row k of L from a sparse triangular solve with the rows above,
+    // whose pattern is the set of tree paths from the non-zeros of A's row k. c.f. ldl_numeric.
+    unsigned int size = size_;
+    std::vector<double> y(size, 0.0);
+    std::vector<unsigned int> pattern(size);
+    std::vector<unsigned int> flag(size);
+    std::vector<unsigned int> filled(size, 0);
+
+    for (unsigned int k = 0; k < size; ++k)
+    {
+        unsigned int top = size;
+        flag[k] = k;
+
+        unsigned int column = permutation_[k];
+        for (unsigned int entry = columnStarts_[column]; entry < columnStarts_[column + 1]; ++entry)
+        {
+            unsigned int i = inversePermutation_[rows_[entry]];
+            if (i > k)
+            {
+                continue;
+            }
+
+            y[i] += values[entry];
+            unsigned int length = 0;
+            for (; flag[i] != k; i = (unsigned int)parent_[i])
+            {
+                pattern[length++] = i;
+                flag[i] = k;
+            }
+            while (length > 0)
+            {
+                pattern[--top] = pattern[--length];
+            }
+        }
+
+        diagonal_[k] = y[k];
+        y[k] = 0.0;
+        for (; top < size; ++top)
+        {
+            unsigned int i = pattern[top];
+            double yi = y[i];
+            y[i] = 0.0;
+
+            unsigned int end = factorStarts_[i] + filled[i];
+            for (unsigned int entry = factorStarts_[i]; entry < end; ++entry)
+            {
+                y[factorRows_[entry]] -= factorValues_[entry] * yi;
+            }
+
+            double lki = yi / diagonal_[i];
+            diagonal_[k] -= lki * yi;
+            factorRows_[end] = k;
+            factorValues_[end] = lki;
+            ++filled[i];
+        }
+
+        if (diagonal_[k] <= 0.0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void
+SparseLDLT::Solve(double *x, unsigned int count, double *work) const
+{
+    for (unsigned int k = 0; k < size_; ++k)
+    {
+        for (unsigned int r = 0; r < count; ++r)
+        {
+            work[k * count + r] = x[permutation_[k] * count + r];
+        }
+    }
+
+    // L y = b, D z = y, L^T x = z.
+    for (unsigned int j = 0; j < size_; ++j)
+    {
+        const double *source = work + j * count;
+        for (unsigned int entry = factorStarts_[j]; entry < factorStarts_[j + 1]; ++entry)
+        {
+            double *target = work + factorRows_[entry] * count;
+            for (unsigned int r = 0; r < count; ++r)
+            {
+                target[r] -= factorValues_[entry] * source[r];
+            }
+        }
+    }
+    for (unsigned int j = 0; j < size_; ++j)
+    {
+        for (unsigned int r = 0; r < count; ++r)
+        {
+            work[j * count + r] /= diagonal_[j];
+        }
+    }
+    for (unsigned int j = size_; j-- > 0;)
+    {
+        double *target = work + j * count;
+        for (unsigned int entry = factorStarts_[j]; entry < factorStarts_[j + 1]; ++entry)
+        {
+            const double *source = work + factorRows_[entry] * count;
+            for (unsigned int r = 0; r < count; ++r)
+            {
+                target[r] -= factorValues_[entry] * source[r];
+            }
+        }
+    }
+
+    for (unsigned int k = 0; k < size_; ++k)
+    {
+        for (unsigned int r = 0; r < count; ++r)
+        {
+            x[permutation_[k] * count + r] = work[k * count + r];
+        }
+    }
+}
+
+unsigned int
+SparseLDLT::GetSize() const
+{
+    return size_;
+}
+
+unsigned int
+SparseLDLT::GetFactorNonZeros() const
+{
+    return (unsigned int)factorRows_.size();
+}
+
+
+// FUNCTIONS
+// ---------
+
+std::vector<unsigned int>
+ComputeMinimumDegreeOrdering(unsigned int size,
+                             const std::vector<unsigned int> &columnStarts,
+                             const std::vector<unsigned int> &rows)
+{
+    std::vector<std::vector<unsigned int>> adjacency(size);
+    for (unsigned int column = 0; column < size; ++column)
+    {
+        for (unsigned int entry = columnStarts[column]; entry < columnStarts[column + 1]; ++entry)
+        {
+            if (rows[entry] != column)
+            {
+                adjacency[column].push_back(rows[entry]);
+            }
+        }
+        std::sort(adjacency[column].begin(), adjacency[column].end());
+        adjacency[column].erase(std::unique(adjacency[column].begin(), adjacency[column].end()), adjacency[column].end());
+    }
+
+    // (degree, vertex), lowest first; stale entries are skipped when popped.
+    typedef std::pair<unsigned int, unsigned int> QueueEntry;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    for (unsigned int vertex = 0; vertex < size; ++vertex)
+    {
+        queue.push(QueueEntry((unsigned int)adjacency[vertex].size(), vertex));
+    }
+
+    std::vector<unsigned int> order;
+    order.reserve(size);
+    std::vector<bool> eliminated(size, false);
+    std::vector<unsigned int> merged;
+
+    while (!queue.empty())
+    {
+        QueueEntry entry = queue.top();
+        queue.pop();
+
+        unsigned int vertex = entry.second;
+        if (eliminated[vertex] || (entry.first != adjacency[vertex].size()))
+        {
+            continue;
+        }
+
+        eliminated[vertex] = true;
+        order.push_back(vertex);
+
+        // Eliminating a vertex turns its neighbors into a clique.
+        const std::vector<unsigned int> &clique = adjacency[vertex];
+        for (auto neighborIt = clique.begin(); neighborIt != clique.end(); ++neighborIt)
+        {
+            std::vector<unsigned int> &neighbors = adjacency[*neighborIt];
+            merged.clear();
+            std::set_union(neighbors.begin(), neighbors.end(), clique.begin(), clique.end(), std::back_inserter(merged));
+            neighbors.clear();
+            for (auto it = merged.begin(); it != merged.end(); ++it)
+            {
+                if ((*it != vertex) && (*it != *neighborIt))
+                {
+                    neighbors.push_back(*it);
+                }
+            }
+            queue.push(QueueEntry((unsigned int)neighbors.size(), *neighborIt));
+        }
+
+        std::vector<unsigned int>().swap(adjacency[vertex]);
+    }
+
+    return order;
+}
@@ -0,0 +1,71 @@
+#ifndef _SPARSELDLT_H_
+#define _SPARSELDLT_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : SparseLDLT.h
+ *
+ * Creation Date : 10/17/2026 - 19:15
+ * Last Modified : 10/17/2026 - 19:15
+ * ==========================================================================================
+ * Description   : Sparse LDL^T factorization of a symmetric positive definite matrix.
+ *                 Analyze() picks a fill-reducing ordering and computes the elimination tree
+ *                 and the structure of L once; Factor() can then be called again with new
+ *                 values on the same pattern, and Solve() is two triangular sweeps.
+ *
+ *                 Matrices are compressed sparse columns with both triangles stored (the
+ *                 pattern must be symmetric). Computations are in double precision.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+
+
+class SparseLDLT
+{
+
+public:
+    SparseLDLT();
+
+    void Analyze(unsigned int size, const std::vector<unsigned int> &columnStarts, const std::vector<unsigned int> &rows);
+    // values follows the rows array given to Analyze(). Returns false if the matrix turned out
+    // not to be positive definite (a zero pivot).
+    bool Factor(const std::vector<double> &values);
+    // Solves A X = B in place for count interleaved right-hand sides: x[i * count + r] is row i
+    // of the r-th one. Sweeping them together reads the factor once instead of count times.
+    // work holds GetSize() * count values.
+    void Solve(double *x, unsigned int count, double *work) const;
+
+    unsigned int GetSize() const;
+    // Non-zeros of L below the diagonal: a measure of the fill-in.
+    unsigned int GetFactorNonZeros() const;
+
+
+private:
+    unsigned int size_;
+    std::vector<unsigned int> columnStarts_;
+    std::vector<unsigned int> rows_;
+    // Ordering: permutation_[k] is the original index of the k-th eliminated unknown.
+    std::vector<unsigned int> permutation_;
+    std::vector<unsigned int> inversePermutation_;
+    // Elimination tree, and the strictly lower part of L in compressed columns.
+    std::vector<int> parent_;
+    std::vector<unsigned int> factorStarts_;
+    std::vector<unsigned int> factorRows_;
+    std::vector<double> factorValues_;
+    std::vector<double> diagonal_;
+
+};
+
+
+// Minimum degree ordering: repeatedly eliminates the unknown with the fewest neighbors in the
+// elimination graph. Exact degrees on an explicit graph, rather than AMD's approximate degrees
+// on a quotient graph: slower to compute but the same kind of ordering, and plenty fast for
+// meshes of a few hundred thousand vertices.
+std::vector<unsigned int> ComputeMinimumDegreeOrdering(unsigned int size,
+                                                       const std::vector<unsigned int> &columnStarts,
+                                                       const std::vector<unsigned int> &rows);
+
+
+#endif // _SPARSELDLT_H_
@@ -0,0 +1,182 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : SpatialHash.cpp
+ *
+ * Creation Date : 10/17/2026 - 21:20
+ * Last Modified : 10/17/2026 - 21:20
+ * ==========================================================================================
+ * Description   : References:
+ *                 (1) Teschner et al., "Optimized Spatial Hashing for Collision Detection of
+ *                     Deformable Objects"
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <algorithm>
+#include <cmath>
+
+#include "SpatialHash.h"
+#include "ThreadPool.h"
+
+
+// Below this many points per thread, splitting a pass costs more than it saves.
+const unsigned int SPATIAL_HASH_MIN_CHUNK = 2048;
+
+// The table has at least this many slots, and at least twice as many as there are points.
+const unsigned int MIN_SLOT_BITS = 10;
+const unsigned int MAX_SLOT_BITS = 30;
+
+
+// PUBLIC METHODS
+// --------------
+
+SpatialHash::SpatialHash()
+{
+    inverseCellSize_ = 1.0f;
+    cellSize_ = 1.0f;
+    slotMask_ = 0;
+    slotBits_ = 0;
+}
+
+void
+SpatialHash::Build(ThreadPool *pool, const float *x, const float *y, const float *z, unsigned int count,
+                   float cellSize)
+{
+    unsigned int slotBits = MIN_SLOT_BITS;
+    while ((slotBits < MAX_SLOT_BITS) && ((1u << slotBits) < 2 * count))
+    {
+        ++slotBits;
+    }
+    if ((slotBits != slotBits_) || (count != keys_.Size()))
+    {
+        slotBits_ = slotBits;
+        slotMask_ = (1u << slotBits) - 1;
+        keys_.Resize(count);
+        points_.Resize(count);
+        keyScratch_.Resize(count);
+        pointScratch_.Resize(count);
+        sortedPositions_.Resize(4 * count);
+        slotRanges_.Resize(2u << slotBits);
+    }
+    cellSize_ = cellSize;
+    inverseCellSize_ = 1.0f / cellSize;
+
+    pool->ParallelFor(0, count, SPATIAL_HASH_MIN_CHUNK,
+        [&](unsigned int begin, unsigned int end, unsigned int)
+        {
+            for (unsigned int index = begin; index < end; ++index)
+            {
+                int cell[3];
+                GetCell(x[index], y[index], z[index], cell);
+                keys_[index] = GetSlot(cell[0], cell[1], cell[2]);
+                points_[index] = index;
+            }
+        });
+
+    // Two counting-sort passes of half the slot bits each, keys_ -> scratch -> keys_. Within a
+    // pass, chunk c scatters its range after every lower chunk's points of the same digit, which
+    // keeps the sort stable.
+    unsigned int digitBits = (slotBits_ + 1) / 2;
+    unsigned int radix = 1u << digitBits;
+    unsigned int chunkCount = pool->GetThreadCount();
+    histograms_.resize(chunkCount * radix);
+    for (unsigned int pass = 0; pass < 2; ++pass)
+    {
+        unsigned int shift = pass * digitBits;
+        const unsigned int *sourceKeys = (pass == 0) ? keys_.Data() : keyScratch_.Data();
+        const unsigned int *sourcePoints = (pass == 0) ? points_.Data() : pointScratch_.Data();
+        unsigned int *targetKeys = (pass == 0) ? keyScratch_.Data() : keys_.Data();
+        unsigned int *targetPoints = (pass == 0) ? pointScratch_.Data() : points_.Data();
+
+        std::fill(histograms_.begin(), histograms_.end(), 0u);
+        pool->ParallelFor(0, count, SPATIAL_HASH_MIN_CHUNK,
+            [&](unsigned int begin, unsigned int end, unsigned int chunk)
+            {
+                unsigned int *histogram = &histograms_[chunk * radix];
+                for (unsigned int index = begin; index < end; ++index)
+                {
+                    ++histogram[(sourceKeys[index] >> shift) & (radix - 1)];
+                }
+            });
+
+        unsigned int offset = 0;
+        for (unsigned int digit = 0; digit < radix; ++digit)
+        {
+            for (unsigned int chunk = 0; chunk < chunkCount; ++chunk)
+            {
+                unsigned int digitCount = histograms_[chunk * radix + digit];
+                histograms_[chunk * radix + digit] = offset;
+                offset += digitCount;
+            }
+        }
+
+        pool->ParallelFor(0, count, SPATIAL_HASH_MIN_CHUNK,
+            [&](unsigned int begin, unsigned int end, unsigned int chunk)
+            {
+                unsigned int *histogram = &histograms_[chunk * radix];
+                for (unsigned int index = begin; index < end; ++index)
+                {
+                    unsigned int target = histogram[(sourceKeys[index] >> shift) & (radix - 1)]++;
+                    targetKeys[target] = sourceKeys[index];
+                    targetPoints[target] = sourcePoints[index];
+                }
+            });
+    }
+
+    pool->ParallelFor(0, slotMask_ + 1, SPATIAL_HASH_MIN_CHUNK,
+        [&](unsigned int begin, unsigned int end, unsigned int)
+        {
+            std::fill(slotRanges_.Data() + 2 * begin, slotRanges_.Data() + 2 * end, 0u);
+        });
+    pool->ParallelFor(0, count, SPATIAL_HASH_MIN_CHUNK,
+        [&](unsigned int begin, unsigned int end, unsigned int)
+        {
+            for (unsigned int index = begin; index < end; ++index)
+            {
+                unsigned int point = points_[index];
+                sortedPositions_[4 * index] = x[point];
+                sortedPositions_[4 * index + 1] = y[point];
+                sortedPositions_[4 * index + 2] = z[point];
+
+                unsigned int key = keys_[index];
+                if ((index == 0) || (keys_[index - 1] != key))
+                {
+                    slotRanges_[2 * key] = index;
+                }
+                if ((index + 1 == count) || (keys_[index + 1] != key))
+                {
+                    slotRanges_[2 * key + 1] = index + 1;
+                }
+            }
+        });
+}
+
+float
+SpatialHash::GetCellSize() const
+{
+    return cellSize_;
+}
+
+unsigned int
+SpatialHash::GetSlotCount() const
+{
+    return slotMask_ + 1;
+}
+
+const unsigned int *
+SpatialHash::GetPoints() const
+{
+    return points_.Data();
+}
+
+const unsigned int *
+SpatialHash::GetSlotRanges() const
+{
+    return slotRanges_.Data();
+}
+
+const float *
+SpatialHash::GetSortedPositions() const
+{
+    return sortedPositions_.Data();
+}
@@ -0,0 +1,91 @@
+#ifndef _SPATIALHASH_H_
+#define _SPATIALHASH_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : SpatialHash.h
+ *
+ * Creation Date : 10/17/2026 - 21:20
+ * Last Modified : 10/17/2026 - 21:20
+ * ==========================================================================================
+ * Description   : Uniform grid over an unbounded space: every cell is hashed into a table of
+ *                 about twice as many slots as there are points, and the points are sorted by
+ *                 slot so each slot is a contiguous range. Built from scratch every time, in
+ *                 time linear in the point count, so nothing needs updating as the points move.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+#include <cmath>
+
+#include "AlignedArray.h"
+
+
+class ThreadPool;
+
+
+class SpatialHash
+{
+
+public:
+    SpatialHash();
+
+    // Sorts points [0, count) into cells of the given size. The sort is a parallel LSD radix sort
+    // on the slot (a counting sort per digit, each chunk counting and scattering its own range),
+    // which is stable, so the order within a slot is the point order whatever the thread count.
+    void Build(ThreadPool *pool, const float *x, const float *y, const float *z, unsigned int count,
+               float cellSize);
+
+    float GetCellSize() const;
+    unsigned int GetSlotCount() const;
+    // Cell coordinates of a point, and the slot of a cell. Different cells can share a slot, so
+    // a slot may hold points far from the cell that was asked for.
+    void GetCell(float x, float y, float z, int *cell) const;
+    unsigned int GetSlot(int cellX, int cellY, int cellZ) const;
+    // Points sorted by slot; slot s holds Points[Ranges[2 s], Ranges[2 s + 1]).
+    const unsigned int *GetPoints() const;
+    const unsigned int *GetSlotRanges() const;
+    // Positions in the same order, 4 floats (x, y, z, unused) per point, so a slot's positions
+    // are one contiguous read instead of one cache miss per point and axis.
+    const float *GetSortedPositions() const;
+
+
+private:
+    float inverseCellSize_;
+    float cellSize_;
+    unsigned int slotMask_;
+    unsigned int slotBits_;
+    AlignedArray<unsigned int> keys_;
+    AlignedArray<unsigned int> points_;
+    AlignedArray<unsigned int> keyScratch_;
+    AlignedArray<unsigned int> pointScratch_;
+    AlignedArray<float> sortedPositions_;
+    // Begin and end of each slot side by side, one cache line for both.
+    AlignedArray<unsigned int> slotRanges_;
+    // One radix histogram per thread-pool chunk, turned into scatter offsets in place.
+    std::vector<unsigned int> histograms_;
+
+};
+
+
+// Inline, queries call them for every point.
+
+inline void
+SpatialHash::GetCell(float x, float y, float z, int *cell) const
+{
+    cell[0] = (int)floorf(x * inverseCellSize_);
+    cell[1] = (int)floorf(y * inverseCellSize_);
+    cell[2] = (int)floorf(z * inverseCellSize_);
+}
+
+inline unsigned int
+SpatialHash::GetSlot(int cellX, int cellY, int cellZ) const
+{
+    unsigned int hash = ((unsigned int)cellX * 73856093u) ^ ((unsigned int)cellY * 19349663u)
+                      ^ ((unsigned int)cellZ * 83492791u);
+    return hash & slotMask_;
+}
+
+
+#endif // _SPATIALHASH_H_
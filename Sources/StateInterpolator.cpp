@@ -0,0 +1,129 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : StateInterpolator.cpp
+ *
+ * Creation Date : 10/17/2026 - 16:30
+ * Last Modified : 10/17/2026 - 16:30
+ * ==========================================================================================
+ * Description   :
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <chrono>
+#include <cstring>
+
+#include "StateInterpolator.h"
+#include "Mesh.h"
+
+
+// PUBLIC METHODS
+// --------------
+
+StateInterpolator::StateInterpolator(SimulationThread *simulation, InterpolationMode mode)
+{
+    Mode = mode;
+    simulation_ = simulation;
+    latest_ = simulation->GetLatest();
+    previous_ = latest_;
+    // Forces the first Update() to write the mesh.
+    alpha_ = -1.0f;
+}
+
+bool
+StateInterpolator::Update(Mesh *mesh)
+{
+    bool newState = simulation_->AcquireLatest();
+    if (newState)
+    {
+        previous_.Positions.swap(latest_.Positions);
+        previous_.Velocities.swap(latest_.Velocities);
+        previous_.Step = latest_.Step;
+        previous_.Time = latest_.Time;
+        previous_.PublishTime = latest_.PublishTime;
+        latest_ = simulation_->GetLatest();
+    }
+
+    // The span covered by the two states, replayed starting from when the latest one arrived.
+    double span = latest_.Time - previous_.Time;
+    int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    float alpha = 1.0f;
+    if ((Mode != INTERPOLATION_NONE) && (span > 0.0))
+    {
+        alpha = (float)((double)(now - latest_.PublishTime) * 1e-9 / span);
+        alpha = glm::clamp(alpha, 0.0f, 1.0f);
+    }
+
+    if (!newState && (alpha == alpha_))
+    {
+        return false;
+    }
+    alpha_ = alpha;
+
+    unsigned int count = (unsigned int)latest_.Positions.size();
+    if (alpha >= 1.0f)
+    {
+        latest_.WriteTo(mesh);
+    }
+    else if (Mode == INTERPOLATION_LINEAR)
+    {
+        for (unsigned int index = 0; index < count; ++index)
+        {
+            mesh->Vertices[index].Position = glm::mix(previous_.Positions[index], latest_.Positions[index], alpha);
+        }
+    }
+    else
+    {
+        float t = alpha;
+        float t2 = t * t;
+        float t3 = t2 * t;
+        float h00 = 2.0f * t3 - 3.0f * t2 + 1.0f;
+        float h10 = (t3 - 2.0f * t2 + t) * (float)span;
+        float h01 = -2.0f * t3 + 3.0f * t2;
+        float h11 = (t3 - t2) * (float)span;
+
+        for (unsigned int index = 0; index < count; ++index)
+        {
+            mesh->Vertices[index].Position = h00 * previous_.Positions[index] + h10 * previous_.Velocities[index] +
+                                             h01 * latest_.Positions[index] + h11 * latest_.Velocities[index];
+        }
+    }
+
+    return true;
+}
+
+float
+StateInterpolator::GetAlpha() const
+{
+    return alpha_;
+}
+
+
+// FUNCTIONS
+// ---------
+
+const char *
+GetInterpolationModeName(InterpolationMode mode)
+{
+    switch (mode)
+    {
+        case INTERPOLATION_LINEAR: return "linear";
+        case INTERPOLATION_HERMITE: return "hermite";
+        default: return "none";
+    }
+}
+
+bool
+ParseInterpolationMode(const char *name, InterpolationMode *mode)
+{
+    for (unsigned int index = 0; index < INTERPOLATION_MODE_COUNT; ++index)
+    {
+        if (!strcmp(name, GetInterpolationModeName((InterpolationMode)index)))
+        {
+            *mode = (InterpolationMode)index;
+            return true;
+        }
+    }
+    return false;
+}
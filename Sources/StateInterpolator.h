@@ -0,0 +1,66 @@
+#ifndef _STATEINTERPOLATOR_H_
+#define _STATEINTERPOLATOR_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : StateInterpolator.h
+ *
+ * Creation Date : 10/17/2026 - 16:30
+ * Last Modified : 10/17/2026 - 16:30
+ * ==========================================================================================
+ * Description   : Render-side blending between the last two states published by a
+ *                 SimulationThread, so the cloth can be drawn at display rate (e.g. 144 Hz)
+ *                 while the solver only steps at 30 or 60 Hz.
+ *                 The displayed state lags the simulation by one published step: that is what
+ *                 makes it an interpolation (no guessing) rather than an extrapolation.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include "SimulationThread.h"
+
+
+class Mesh;
+
+
+enum InterpolationMode : unsigned char
+{
+    // Draw the latest state as is: motion steps at the simulation rate.
+    INTERPOLATION_NONE,
+    INTERPOLATION_LINEAR,
+    // Cubic Hermite through both positions and velocities: smoother at low simulation rates,
+    // at the cost of publishing velocities too.
+    INTERPOLATION_HERMITE,
+
+    INTERPOLATION_MODE_COUNT
+};
+
+
+class StateInterpolator
+{
+
+public:
+    InterpolationMode Mode;
+
+    StateInterpolator(SimulationThread *simulation, InterpolationMode mode = INTERPOLATION_LINEAR);
+
+    // Picks up any newly published state and writes the positions for the current time into
+    // the mesh. Returns false when nothing moved since the last call.
+    bool Update(Mesh *mesh);
+    // Blend factor used by the last Update(): 0 = previous state, 1 = latest.
+    float GetAlpha() const;
+
+
+private:
+    SimulationThread *simulation_;
+    SimulationState previous_;
+    SimulationState latest_;
+    float alpha_;
+
+};
+
+const char *GetInterpolationModeName(InterpolationMode mode);
+bool ParseInterpolationMode(const char *name, InterpolationMode *mode);
+
+
+#endif // _STATEINTERPOLATOR_H_
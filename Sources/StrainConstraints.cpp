@@ -0,0 +1,375 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : StrainConstraints.cpp
+ *
+ * Creation Date : 10/17/2026 - 20:55
+ * Last Modified : 10/18/2026 - 11:20
+ * ==========================================================================================
+ * Description   : References:
+ *                 (1) Mueller et al., "Strain Based Dynamics"
+ *
+ *                 (2) Bender et al., "Position-Based Simulation of Continuous Materials"
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <cmath>
+
+#include "StrainConstraints.h"
+#include "DistanceKernels.h"
+#include "Mesh.h"
+#include "ParticleStore.h"
+
+#if CLOTH_SIMD_X86
+#include <immintrin.h>
+#endif
+
+
+// Below this sum of weighted squared gradients a component is left alone (degenerate triangle,
+// pinned triangle, or shear between two collapsed axes).
+const float STRAIN_EPSILON = 1e-12f;
+
+
+// STRUCTURES
+// ----------
+
+void
+StrainBatch::Build(const std::vector<Face> &faces, const std::vector<unsigned int> &order,
+                   const std::vector<glm::vec3> &restPositions, const std::vector<glm::vec2> &texCoords)
+{
+    Count = (unsigned int)order.size();
+    for (unsigned int corner = 0; corner < STRAIN_STENCIL_SIZE; ++corner)
+    {
+        Index[corner].Resize(Count);
+    }
+    for (unsigned int row = 0; row < 2; ++row)
+    {
+        for (unsigned int column = 0; column < 2; ++column)
+        {
+            InvRest[row][column].Resize(Count);
+        }
+    }
+    Area.Resize(Count);
+
+    for (unsigned int slot = 0; slot < Count; ++slot)
+    {
+        const Face &face = faces[order[slot]];
+        for (unsigned int corner = 0; corner < STRAIN_STENCIL_SIZE; ++corner)
+        {
+            Index[corner][slot] = face.Indices[corner];
+        }
+
+        glm::vec3 edge1 = restPositions[face.Indices[1]] - restPositions[face.Indices[0]];
+        glm::vec3 edge2 = restPositions[face.Indices[2]] - restPositions[face.Indices[0]];
+        glm::vec3 normal = glm::cross(edge1, edge2);
+        float normalLength = glm::length(normal);
+        if (normalLength <= 0.0f)
+        {
+            continue;
+        }
+        normal /= normalLength;
+
+        // dx/du = [edge1 edge2] [uv1 - uv0, uv2 - uv0]^-1, first column.
+        glm::vec2 uv1 = texCoords[face.Indices[1]] - texCoords[face.Indices[0]];
+        glm::vec2 uv2 = texCoords[face.Indices[2]] - texCoords[face.Indices[0]];
+        float uvDeterminant = uv1.x * uv2.y - uv2.x * uv1.y;
+        glm::vec3 warp = (uvDeterminant != 0.0f) ? (edge1 * uv2.y - edge2 * uv1.y) / uvDeterminant : edge1;
+        warp -= normal * glm::dot(warp, normal);
+        float warpLength = glm::length(warp);
+        warp = (warpLength > 0.0f) ? warp / warpLength : edge1 / glm::length(edge1);
+        glm::vec3 weft = glm::cross(normal, warp);
+
+        // Rest-shape matrix in the material frame, columns are the two edges.
+        float d00 = glm::dot(edge1, warp);
+        float d01 = glm::dot(edge2, warp);
+        float d10 = glm::dot(edge1, weft);
+        float d11 = glm::dot(edge2, weft);
+        float determinant = d00 * d11 - d01 * d10;
+        if (determinant == 0.0f)
+        {
+            continue;
+        }
+
+        InvRest[0][0][slot] = d11 / determinant;
+        InvRest[0][1][slot] = -d01 / determinant;
+        InvRest[1][0][slot] = -d10 / determinant;
+        InvRest[1][1][slot] = d00 / determinant;
+        Area[slot] = 0.5f * normalLength;
+    }
+}
+
+
+// KERNELS
+// -------
+
+// The gradient of a component with respect to x1 and x2 is a1 f0 + b1 f1 and a2 f0 + b2 f1
+// (and minus their sum for x0), with f0 and f1 the columns of F:
+//     warp  C = 1/2 (f0.f0 - 1)   a = T00, T10        b = 0
+//     weft  C = 1/2 (f1.f1 - 1)   a = 0               b = T01, T11
+//     shear C = f0.f1             a = T01, T11        b = T00, T10
+static inline void
+GetGradientWeights(unsigned int component, float t00, float t01, float t10, float t11,
+                   float *a1, float *b1, float *a2, float *b2)
+{
+    switch (component)
+    {
+        case STRAIN_WARP: *a1 = t00; *b1 = 0.0f; *a2 = t10; *b2 = 0.0f; break;
+        case STRAIN_WEFT: *a1 = 0.0f; *b1 = t01; *a2 = 0.0f; *b2 = t11; break;
+        default: *a1 = t01; *b1 = t00; *a2 = t11; *b2 = t10; break;
+    }
+}
+
+static void
+SolveScalar(const StrainBatch &batch, unsigned int begin, unsigned int end, const float *stiffness,
+            const float *compliance, float *lambda, ParticleStore *particles, DistanceResidual *residual)
+{
+    float *px = particles->PredictedX.Data();
+    float *py = particles->PredictedY.Data();
+    float *pz = particles->PredictedZ.Data();
+    const float *w = particles->InvMass.Data();
+
+    for (unsigned int triangle = begin; triangle < end; ++triangle)
+    {
+        unsigned int i0 = batch.Index[0][triangle];
+        unsigned int i1 = batch.Index[1][triangle];
+        unsigned int i2 = batch.Index[2][triangle];
+        float area = batch.Area[triangle];
+        float t00 = batch.InvRest[0][0][triangle];
+        float t01 = batch.InvRest[0][1][triangle];
+        float t10 = batch.InvRest[1][0][triangle];
+        float t11 = batch.InvRest[1][1][triangle];
+        glm::vec3 x0(px[i0], py[i0], pz[i0]);
+        glm::vec3 x1(px[i1], py[i1], pz[i1]);
+        glm::vec3 x2(px[i2], py[i2], pz[i2]);
+
+        // Warp and weft stretch before the projection; a degenerate triangle has F = 0 and
+        // counts as compressed.
+        glm::vec3 warp = (x1 - x0) * t00 + (x2 - x0) * t10;
+        glm::vec3 weft = (x1 - x0) * t01 + (x2 - x0) * t11;
+        float stretch = fmaxf(fmaxf(glm::length(warp), glm::length(weft)) - 1.0f, 0.0f);
+        residual->Max = fmaxf(residual->Max, stretch);
+        residual->SumSquares += (double)(stretch * stretch);
+
+        for (unsigned int component = 0; component < STRAIN_COMPONENT_COUNT; ++component)
+        {
+            glm::vec3 edge1 = x1 - x0;
+            glm::vec3 edge2 = x2 - x0;
+            glm::vec3 f0 = edge1 * t00 + edge2 * t10;
+            glm::vec3 f1 = edge1 * t01 + edge2 * t11;
+            float constraint = (component == STRAIN_WARP) ? 0.5f * (glm::dot(f0, f0) - 1.0f)
+                             : (component == STRAIN_WEFT) ? 0.5f * (glm::dot(f1, f1) - 1.0f)
+                             : glm::dot(f0, f1);
+
+            float a1, b1, a2, b2;
+            GetGradientWeights(component, t00, t01, t10, t11, &a1, &b1, &a2, &b2);
+            glm::vec3 gradient1 = f0 * a1 + f1 * b1;
+            glm::vec3 gradient2 = f0 * a2 + f1 * b2;
+            glm::vec3 gradient0 = -(gradient1 + gradient2);
+            float gradientSum = w[i0] * glm::dot(gradient0, gradient0) + w[i1] * glm::dot(gradient1, gradient1)
+                              + w[i2] * glm::dot(gradient2, gradient2);
+            if (gradientSum <= STRAIN_EPSILON)
+            {
+                continue;
+            }
+
+            float alpha = lambda ? compliance[component] / area : 0.0f;
+            float *multiplier = lambda ? lambda + component * batch.Count + triangle : nullptr;
+            float previous = multiplier ? *multiplier : 0.0f;
+            float deltaLambda = (-constraint - alpha * previous) / (gradientSum + alpha);
+            if (multiplier)
+            {
+                *multiplier = previous + deltaLambda;
+            }
+
+            float scale = stiffness[component] * deltaLambda;
+            x0 += gradient0 * (scale * w[i0]);
+            x1 += gradient1 * (scale * w[i1]);
+            x2 += gradient2 * (scale * w[i2]);
+        }
+
+        px[i0] = x0.x; py[i0] = x0.y; pz[i0] = x0.z;
+        px[i1] = x1.x; py[i1] = x1.y; pz[i1] = x1.z;
+        px[i2] = x2.x; py[i2] = x2.y; pz[i2] = x2.z;
+    }
+}
+
+#if CLOTH_SIMD_X86
+
+CLOTH_TARGET_AVX2 static inline __m256
+Dot8(const __m256 *a, const __m256 *b)
+{
+    return _mm256_fmadd_ps(a[2], b[2], _mm256_fmadd_ps(a[1], b[1], _mm256_mul_ps(a[0], b[0])));
+}
+
+// Eight triangles per pass: the 9 coordinates are gathered once, the three components projected
+// on registers, and the results scattered back lane by lane (a color shares no vertex).
+CLOTH_TARGET_AVX2 static void
+SolveAvx2(const StrainBatch &batch, unsigned int begin, unsigned int end, const float *stiffness,
+          const float *compliance, float *lambda, ParticleStore *particles, DistanceResidual *residual)
+{
+    float *p[3] = { particles->PredictedX.Data(), particles->PredictedY.Data(), particles->PredictedZ.Data() };
+    const float *w = particles->InvMass.Data();
+    __m256 zero = _mm256_setzero_ps();
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 half = _mm256_set1_ps(0.5f);
+    __m256 epsilon = _mm256_set1_ps(STRAIN_EPSILON);
+    alignas(32) float result[STRAIN_STENCIL_SIZE][3][8];
+    alignas(32) float stretch[8];
+
+    unsigned int triangle = begin;
+    for (; triangle + 8 <= end; triangle += 8)
+    {
+        __m256 x[STRAIN_STENCIL_SIZE][3];
+        __m256 invMass[STRAIN_STENCIL_SIZE];
+        for (unsigned int corner = 0; corner < STRAIN_STENCIL_SIZE; ++corner)
+        {
+            __m256i index = _mm256_loadu_si256((const __m256i *)(batch.Index[corner].Data() + triangle));
+            for (unsigned int axis = 0; axis < 3; ++axis)
+            {
+                x[corner][axis] = _mm256_i32gather_ps(p[axis], index, 4);
+            }
+            invMass[corner] = _mm256_i32gather_ps(w, index, 4);
+        }
+        __m256 t00 = _mm256_loadu_ps(batch.InvRest[0][0].Data() + triangle);
+        __m256 t01 = _mm256_loadu_ps(batch.InvRest[0][1].Data() + triangle);
+        __m256 t10 = _mm256_loadu_ps(batch.InvRest[1][0].Data() + triangle);
+        __m256 t11 = _mm256_loadu_ps(batch.InvRest[1][1].Data() + triangle);
+        __m256 area = _mm256_loadu_ps(batch.Area.Data() + triangle);
+
+        __m256 warp[3];
+        __m256 weft[3];
+        for (unsigned int axis = 0; axis < 3; ++axis)
+        {
+            __m256 edge1 = _mm256_sub_ps(x[1][axis], x[0][axis]);
+            __m256 edge2 = _mm256_sub_ps(x[2][axis], x[0][axis]);
+            warp[axis] = _mm256_fmadd_ps(edge2, t10, _mm256_mul_ps(edge1, t00));
+            weft[axis] = _mm256_fmadd_ps(edge2, t11, _mm256_mul_ps(edge1, t01));
+        }
+        __m256 longest = _mm256_sqrt_ps(_mm256_max_ps(Dot8(warp, warp), Dot8(weft, weft)));
+        _mm256_store_ps(stretch, _mm256_max_ps(_mm256_sub_ps(longest, one), zero));
+        for (unsigned int lane = 0; lane < 8; ++lane)
+        {
+            residual->Max = fmaxf(residual->Max, stretch[lane]);
+            residual->SumSquares += (double)(stretch[lane] * stretch[lane]);
+        }
+
+        for (unsigned int component = 0; component < STRAIN_COMPONENT_COUNT; ++component)
+        {
+            __m256 f0[3];
+            __m256 f1[3];
+            for (unsigned int axis = 0; axis < 3; ++axis)
+            {
+                __m256 edge1 = _mm256_sub_ps(x[1][axis], x[0][axis]);
+                __m256 edge2 = _mm256_sub_ps(x[2][axis], x[0][axis]);
+                f0[axis] = _mm256_fmadd_ps(edge2, t10, _mm256_mul_ps(edge1, t00));
+                f1[axis] = _mm256_fmadd_ps(edge2, t11, _mm256_mul_ps(edge1, t01));
+            }
+
+            __m256 constraint;
+            __m256 a1, b1, a2, b2;
+            switch (component)
+            {
+                case STRAIN_WARP:
+                    constraint = _mm256_mul_ps(half, _mm256_sub_ps(Dot8(f0, f0), one));
+                    a1 = t00; b1 = zero; a2 = t10; b2 = zero;
+                    break;
+                case STRAIN_WEFT:
+                    constraint = _mm256_mul_ps(half, _mm256_sub_ps(Dot8(f1, f1), one));
+                    a1 = zero; b1 = t01; a2 = zero; b2 = t11;
+                    break;
+                default:
+                    constraint = Dot8(f0, f1);
+                    a1 = t01; b1 = t00; a2 = t11; b2 = t10;
+                    break;
+            }
+
+            __m256 gradient[STRAIN_STENCIL_SIZE][3];
+            for (unsigned int axis = 0; axis < 3; ++axis)
+            {
+                gradient[1][axis] = _mm256_fmadd_ps(f1[axis], b1, _mm256_mul_ps(f0[axis], a1));
+                gradient[2][axis] = _mm256_fmadd_ps(f1[axis], b2, _mm256_mul_ps(f0[axis], a2));
+                gradient[0][axis] = _mm256_sub_ps(zero, _mm256_add_ps(gradient[1][axis], gradient[2][axis]));
+            }
+            __m256 gradientSum = _mm256_mul_ps(invMass[0], Dot8(gradient[0], gradient[0]));
+            gradientSum = _mm256_fmadd_ps(invMass[1], Dot8(gradient[1], gradient[1]), gradientSum);
+            gradientSum = _mm256_fmadd_ps(invMass[2], Dot8(gradient[2], gradient[2]), gradientSum);
+            __m256 active = _mm256_cmp_ps(gradientSum, epsilon, _CMP_GT_OQ);
+
+            __m256 numerator = _mm256_sub_ps(zero, constraint);
+            __m256 denominator = gradientSum;
+            __m256 previous = zero;
+            float *multiplier = lambda ? lambda + component * batch.Count + triangle : nullptr;
+            if (multiplier)
+            {
+                // Degenerate triangles have a zero area; the blend keeps them off the division.
+                __m256 alpha = _mm256_div_ps(_mm256_set1_ps(compliance[component]), _mm256_blendv_ps(one, area, active));
+                previous = _mm256_loadu_ps(multiplier);
+                numerator = _mm256_sub_ps(numerator, _mm256_mul_ps(alpha, previous));
+                denominator = _mm256_add_ps(denominator, alpha);
+            }
+            __m256 deltaLambda = _mm256_and_ps(active, _mm256_div_ps(numerator, _mm256_blendv_ps(one, denominator, active)));
+            if (multiplier)
+            {
+                _mm256_storeu_ps(multiplier, _mm256_add_ps(previous, deltaLambda));
+            }
+
+            __m256 scale = _mm256_mul_ps(_mm256_set1_ps(stiffness[component]), deltaLambda);
+            for (unsigned int corner = 0; corner < STRAIN_STENCIL_SIZE; ++corner)
+            {
+                __m256 factor = _mm256_mul_ps(scale, invMass[corner]);
+                for (unsigned int axis = 0; axis < 3; ++axis)
+                {
+                    x[corner][axis] = _mm256_fmadd_ps(gradient[corner][axis], factor, x[corner][axis]);
+                }
+            }
+        }
+
+        for (unsigned int corner = 0; corner < STRAIN_STENCIL_SIZE; ++corner)
+        {
+            for (unsigned int axis = 0; axis < 3; ++axis)
+            {
+                _mm256_store_ps(result[corner][axis], x[corner][axis]);
+            }
+        }
+        for (unsigned int corner = 0; corner < STRAIN_STENCIL_SIZE; ++corner)
+        {
+            const unsigned int *index = batch.Index[corner].Data() + triangle;
+            for (unsigned int lane = 0; lane < 8; ++lane)
+            {
+                p[0][index[lane]] = result[corner][0][lane];
+                p[1][index[lane]] = result[corner][1][lane];
+                p[2][index[lane]] = result[corner][2][lane];
+            }
+        }
+    }
+
+    SolveScalar(batch, triangle, end, stiffness, compliance, lambda, particles, residual);
+}
+
+#endif
+
+
+// FUNCTIONS
+// ---------
+
+void
+SolveStrainConstraints(SimdLevel level,
+                       const StrainBatch &batch,
+                       unsigned int begin,
+                       unsigned int end,
+                       const float *stiffness,
+                       const float *compliance,
+                       float *lambda,
+                       ParticleStore *particles,
+                       DistanceResidual *residual)
+{
+#if CLOTH_SIMD_X86
+    // 8-wide only; SSE runs the scalar kernel.
+    if (level >= SIMD_AVX2)
+    {
+        SolveAvx2(batch, begin, end, stiffness, compliance, lambda, particles, residual);
+        return;
+    }
+#endif
+    SolveScalar(batch, begin, end, stiffness, compliance, lambda, particles, residual);
+}
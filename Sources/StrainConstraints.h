@@ -0,0 +1,82 @@
+#ifndef _STRAINCONSTRAINTS_H_
+#define _STRAINCONSTRAINTS_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : StrainConstraints.h
+ *
+ * Creation Date : 10/17/2026 - 20:55
+ * Last Modified : 10/18/2026 - 11:20
+ * ==========================================================================================
+ * Description   : Continuum stretch and shear on the triangles. Each triangle keeps the inverse
+ *                 of its 2x2 rest-shape matrix in material coordinates, so the deformation
+ *                 gradient is F = [x1 - x0, x2 - x0] T, and the three components of the Green
+ *                 strain 1/2 (F^T F - I) are projected one after the other: warp (along the U
+ *                 texture axis), weft (across it) and shear, each with its own stiffness.
+ *
+ *                 Unlike edge springs, the material axes come from the UVs, so the cloth can be
+ *                 stiffer along the warp than the weft, and one triangle replaces both its
+ *                 edges and the shear diagonals across them.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+#include "glm/glm.hpp"
+
+#include "AlignedArray.h"
+#include "CpuFeatures.h"
+
+
+struct DistanceResidual;
+struct Face;
+class ParticleStore;
+
+
+const unsigned int STRAIN_STENCIL_SIZE = 3;
+
+enum StrainComponent : unsigned char
+{
+    STRAIN_WARP,
+    STRAIN_WEFT,
+    STRAIN_SHEAR,
+
+    STRAIN_COMPONENT_COUNT
+};
+
+
+struct StrainBatch
+{
+    AlignedArray<unsigned int> Index[STRAIN_STENCIL_SIZE];
+    // Inverse rest-shape matrix, InvRest[row][column].
+    AlignedArray<float> InvRest[2][2];
+    AlignedArray<float> Area;
+    unsigned int Count = 0;
+
+    // Triangles are stored in the given order. The material frame of a triangle is its rest
+    // plane with the first axis along the direction the U texture coordinate grows in (the
+    // first edge when the UVs are degenerate), the second one perpendicular to it, so F^T F = I
+    // at rest. Degenerate triangles get a zero matrix and never move anything.
+    void Build(const std::vector<Face> &faces, const std::vector<unsigned int> &order,
+               const std::vector<glm::vec3> &restPositions, const std::vector<glm::vec2> &texCoords);
+};
+
+
+// Projects triangles [begin, end) in place, so the range must not contain two triangles sharing
+// a vertex (one color). XPBD when lambda is given: lambda holds STRAIN_COMPONENT_COUNT arrays of
+// Count multipliers, one after the other, and the compliance of a component is
+// compliance[c] / (area h^2), given here as compliance[c] / h^2. Otherwise PBD, each component's
+// correction scaled by stiffness[c]. The stretch of each triangle before its projection, the
+// larger of its warp and weft (|f0| - 1 and |f1| - 1, 0 when compressed), is added to residual.
+void SolveStrainConstraints(SimdLevel level,
+                            const StrainBatch &batch,
+                            unsigned int begin,
+                            unsigned int end,
+                            const float *stiffness,
+                            const float *compliance,
+                            float *lambda,
+                            ParticleStore *particles,
+                            DistanceResidual *residual);
+
+
+#endif // _STRAINCONSTRAINTS_H_
@@ -0,0 +1,131 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : Tethers.cpp
+ *
+ * Creation Date : 10/17/2026 - 18:10
+ * Last Modified : 10/17/2026 - 18:10
+ * ==========================================================================================
+ * Description   : References:
+ *                 (1) Kim, Chentanez, Mueller, "Long Range Attachments - A Method to Simulate
+ *                     Inextensible Clothing in Computer Games"
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <cmath>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <utility>
+
+#include "Tethers.h"
+#include "DistanceKernels.h"
+#include "VertexIncidence.h"
+#include "ParticleStore.h"
+#include "PinSet.h"
+
+
+// STRUCTURES
+// ----------
+
+void
+TetherBatch::Build(const DistanceConstraintBatch &constraints,
+                   const VertexIncidence &incidence,
+                   const PinSet &pins,
+                   const ParticleStore &particles)
+{
+    unsigned int vertexCount = particles.GetCount();
+    const float unreached = 1e30f;
+    std::vector<float> distance(vertexCount, unreached);
+    std::vector<unsigned int> anchor(vertexCount, 0);
+
+    // (distance, vertex), closest first.
+    typedef std::pair<float, unsigned int> QueueEntry;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+
+    const std::vector<unsigned int> &pinned = pins.GetIndices();
+    for (auto pinIt = pinned.begin(); pinIt != pinned.end(); ++pinIt)
+    {
+        distance[*pinIt] = 0.0f;
+        anchor[*pinIt] = *pinIt;
+        queue.push(QueueEntry(0.0f, *pinIt));
+    }
+
+    while (!queue.empty())
+    {
+        QueueEntry entry = queue.top();
+        queue.pop();
+
+        unsigned int vertex = entry.second;
+        if (entry.first > distance[vertex])
+        {
+            continue;
+        }
+
+        for (unsigned int slot = incidence.Offsets[vertex]; slot < incidence.Offsets[vertex + 1]; ++slot)
+        {
+            unsigned int constraint = incidence.Constraints[slot];
+            unsigned int other = (constraints.Index1[constraint] == vertex) ? constraints.Index2[constraint]
+                                                                            : constraints.Index1[constraint];
+            float candidate = distance[vertex] + constraints.RestLength[constraint];
+            if (candidate < distance[other])
+            {
+                distance[other] = candidate;
+                anchor[other] = anchor[vertex];
+                queue.push(QueueEntry(candidate, other));
+            }
+        }
+    }
+
+    Count = 0;
+    for (unsigned int vertex = 0; vertex < vertexCount; ++vertex)
+    {
+        Count += ((distance[vertex] > 0.0f) && (distance[vertex] < unreached)) ? 1 : 0;
+    }
+
+    Particle.Resize(Count);
+    Anchor.Resize(Count);
+    MaxLength.Resize(Count);
+
+    unsigned int tether = 0;
+    for (unsigned int vertex = 0; vertex < vertexCount; ++vertex)
+    {
+        if ((distance[vertex] > 0.0f) && (distance[vertex] < unreached))
+        {
+            Particle[tether] = vertex;
+            Anchor[tether] = anchor[vertex];
+            MaxLength[tether] = distance[vertex];
+            ++tether;
+        }
+    }
+}
+
+
+// FUNCTIONS
+// ---------
+
+void
+SolveTethers(const TetherBatch &tethers, unsigned int begin, unsigned int end, float slack, ParticleStore *particles)
+{
+    float *px = particles->PredictedX.Data();
+    float *py = particles->PredictedY.Data();
+    float *pz = particles->PredictedZ.Data();
+
+    for (unsigned int tether = begin; tether < end; ++tether)
+    {
+        unsigned int particle = tethers.Particle[tether];
+        unsigned int anchor = tethers.Anchor[tether];
+        float dx = px[particle] - px[anchor];
+        float dy = py[particle] - py[anchor];
+        float dz = pz[particle] - pz[anchor];
+        float distance = sqrtf(dx*dx + dy*dy + dz*dz);
+        float limit = slack * tethers.MaxLength[tether];
+
+        // Inequality: only too-far particles move, straight back onto the sphere around the
+        // anchor (which has no mass to share the correction with).
+        float pull = (distance > limit) ? 1.0f - limit / distance : 0.0f;
+        px[particle] -= pull * dx;
+        py[particle] -= pull * dy;
+        pz[particle] -= pull * dz;
+    }
+}
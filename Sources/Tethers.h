@@ -0,0 +1,51 @@
+#ifndef _TETHERS_H_
+#define _TETHERS_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : Tethers.h
+ *
+ * Creation Date : 10/17/2026 - 18:10
+ * Last Modified : 10/17/2026 - 18:10
+ * ==========================================================================================
+ * Description   : Long-range attachment constraints.
+ *                 Every free particle is tethered to its nearest pin (along the mesh) and may
+ *                 not get further from it than their rest geodesic distance. The pin's pull
+ *                 then reaches the whole cloth in one projection, instead of creeping down one
+ *                 edge per iteration, which is what makes a hanging cloth sag and stretch.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include "AlignedArray.h"
+
+
+struct DistanceConstraintBatch;
+struct VertexIncidence;
+class ParticleStore;
+class PinSet;
+
+
+struct TetherBatch
+{
+    AlignedArray<unsigned int> Particle;
+    AlignedArray<unsigned int> Anchor;
+    // Geodesic rest distance between the particle and its anchor.
+    AlignedArray<float> MaxLength;
+    unsigned int Count = 0;
+
+    // Multi-source Dijkstra from every pin over the constraint graph, weighted by rest length.
+    // Pinned particles and particles no pin can reach get no tether. Sorted by particle.
+    void Build(const DistanceConstraintBatch &constraints,
+               const VertexIncidence &incidence,
+               const PinSet &pins,
+               const ParticleStore &particles);
+};
+
+
+// Pulls the particles of tethers [begin, end) back inside slack * MaxLength of their anchor.
+// One tether per particle, so any range can run in parallel with any other.
+void SolveTethers(const TetherBatch &tethers, unsigned int begin, unsigned int end, float slack, ParticleStore *particles);
+
+
+#endif // _TETHERS_H_
@@ -0,0 +1,142 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : ThreadPool.cpp
+ *
+ * Creation Date : 10/17/2026 - 13:05
+ * Last Modified : 10/17/2026 - 13:05
+ * ==========================================================================================
+ * Description   :
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include "ThreadPool.h"
+
+
+// PUBLIC METHODS
+// --------------
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+{
+    task_ = nullptr;
+    begin_ = 0;
+    end_ = 0;
+    chunkCount_ = 0;
+    pending_ = 0;
+    generation_ = 0;
+    stop_ = false;
+
+    if (threadCount == 0)
+    {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0)
+    {
+        threadCount = 1;
+    }
+
+    // Worker i always runs chunk i; chunk 0 belongs to the caller.
+    for (unsigned int index = 1; index < threadCount; ++index)
+    {
+        workers_.push_back(std::thread(&ThreadPool::WorkerLoop, this, index));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+
+    for (auto workerIt = workers_.begin(); workerIt != workers_.end(); ++workerIt)
+    {
+        workerIt->join();
+    }
+}
+
+unsigned int
+ThreadPool::GetThreadCount() const
+{
+    return (unsigned int)workers_.size() + 1;
+}
+
+void
+ThreadPool::ParallelFor(unsigned int begin, unsigned int end, unsigned int minChunkSize, const Task &task)
+{
+    if (end <= begin)
+    {
+        return;
+    }
+
+    unsigned int count = end - begin;
+    unsigned int chunkCount = (minChunkSize > 0) ? count / minChunkSize : count;
+    chunkCount = (chunkCount < GetThreadCount()) ? chunkCount : GetThreadCount();
+
+    if (chunkCount <= 1)
+    {
+        task(begin, end, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        begin_ = begin;
+        end_ = end;
+        chunkCount_ = chunkCount;
+        pending_ = chunkCount - 1;
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    RunChunk(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this]() { return pending_ == 0; });
+    task_ = nullptr;
+}
+
+
+// PRIVATE METHODS
+// ---------------
+
+void
+ThreadPool::WorkerLoop(unsigned int chunkIndex)
+{
+    unsigned int seenGeneration = 0;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;)
+    {
+        wake_.wait(lock, [this, seenGeneration]() { return stop_ || (generation_ != seenGeneration); });
+        if (stop_)
+        {
+            return;
+        }
+        seenGeneration = generation_;
+
+        if (chunkIndex < chunkCount_)
+        {
+            lock.unlock();
+            RunChunk(chunkIndex);
+            lock.lock();
+
+            if (--pending_ == 0)
+            {
+                done_.notify_one();
+            }
+        }
+    }
+}
+
+void
+ThreadPool::RunChunk(unsigned int chunkIndex)
+{
+    unsigned long long count = end_ - begin_;
+    unsigned int chunkBegin = begin_ + (unsigned int)(count * chunkIndex / chunkCount_);
+    unsigned int chunkEnd = begin_ + (unsigned int)(count * (chunkIndex + 1) / chunkCount_);
+
+    (*task_)(chunkBegin, chunkEnd, chunkIndex);
+}
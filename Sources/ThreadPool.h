@@ -0,0 +1,66 @@
+#ifndef _THREADPOOL_H_
+#define _THREADPOOL_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : ThreadPool.h
+ *
+ * Creation Date : 10/17/2026 - 13:05
+ * Last Modified : 10/17/2026 - 13:05
+ * ==========================================================================================
+ * Description   : Fixed set of worker threads running fork-join parallel loops.
+ *                 A loop is split into one contiguous chunk per thread (the calling thread takes
+ *                 the first one), so chunk boundaries only depend on the range and the thread
+ *                 count.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+
+class ThreadPool
+{
+
+public:
+    // Arguments: chunk begin, chunk end, chunk index.
+    typedef std::function<void(unsigned int, unsigned int, unsigned int)> Task;
+
+    // threadCount includes the calling thread; 0 picks the hardware concurrency.
+    explicit ThreadPool(unsigned int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    unsigned int GetThreadCount() const;
+
+    // Runs task over [begin, end) and returns once every chunk is done. Ranges shorter than
+    // minChunkSize per thread use fewer threads.
+    void ParallelFor(unsigned int begin, unsigned int end, unsigned int minChunkSize, const Task &task);
+
+
+private:
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const Task *task_;
+    unsigned int begin_;
+    unsigned int end_;
+    unsigned int chunkCount_;
+    unsigned int pending_;
+    unsigned int generation_;
+    bool stop_;
+
+    void WorkerLoop(unsigned int chunkIndex);
+    void RunChunk(unsigned int chunkIndex);
+
+};
+
+
+#endif // _THREADPOOL_H_
@@ -0,0 +1,106 @@
+#ifndef _TRIANGLEBVH_H_
+#define _TRIANGLEBVH_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : TriangleBvh.h
+ *
+ * Creation Date : 10/17/2026 - 21:45
+ * Last Modified : 10/17/2026 - 21:45
+ * ==========================================================================================
+ * Description   : Bounding volume hierarchy over the triangles of a mesh, for self-collision
+ *                 queries. Each leaf box bounds its triangles swept from their start to their end
+ *                 positions, so an overlap test covers the whole step.
+ *
+ *                 The topology of the tree is kept from step to step and only its boxes are
+ *                 refitted, bottom-up, which is linear and cheap. As the cloth deforms, the
+ *                 boxes of a refitted tree grow to overlap more and more; GetQuality() measures
+ *                 that against the tree as it was built, and a rebuild resets it.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+#include <utility>
+
+#include "AlignedArray.h"
+
+
+struct Face;
+
+
+struct BvhNode
+{
+    float Min[3];
+    float Max[3];
+    // Leaves hold Order[First, First + Count); internal nodes have Count 0, their left child
+    // right after them and their right child at Right.
+    unsigned int First;
+    unsigned int Count;
+    unsigned int Right;
+};
+
+struct BvhQueryStats
+{
+    // Box tests between two nodes, and between two triangles of overlapping leaves.
+    unsigned long long NodeTests = 0;
+    unsigned long long TriangleTests = 0;
+};
+
+
+class TriangleBvh
+{
+
+public:
+    TriangleBvh();
+
+    void SetTriangles(const std::vector<Face> &faces);
+    unsigned int GetTriangleCount() const;
+    // Corner c of triangle t.
+    unsigned int GetVertex(unsigned int triangle, unsigned int corner) const;
+
+    // Recomputes every triangle's box over both positions, grown by margin, then every node's
+    // box from its children's. Builds the tree first if there is none yet.
+    void Refit(const float *startX, const float *startY, const float *startZ,
+               const float *endX, const float *endY, const float *endZ, float margin);
+    // Rebuilds the tree top-down on the boxes of the last Refit(): median split of the box
+    // centers along their widest axis.
+    void Build();
+    // Sum of the internal nodes' surface areas over the root's, divided by the same ratio when
+    // the tree was last built: 1 right after a build, and growing as refits loosen the tree.
+    float GetQuality() const;
+    unsigned int GetNodeCount() const;
+
+    // Every pair of distinct triangles whose boxes overlap, smaller index first. Neighboring
+    // triangles always overlap; telling which of their features may still collide is left to
+    // the caller.
+    void FindOverlappingPairs(std::vector<std::pair<unsigned int, unsigned int>> *pairs, BvhQueryStats *stats) const;
+
+
+private:
+    AlignedArray<unsigned int> vertices_[3];
+    // Triangle boxes, min x, y, z then max x, y, z for each, side by side since the traversal
+    // always reads all six.
+    AlignedArray<float> triangleBoxes_;
+    std::vector<BvhNode> nodes_;
+    std::vector<unsigned int> order_;
+    float builtCost_;
+
+    unsigned int BuildNode(unsigned int first, unsigned int count);
+    float ComputeCost() const;
+    bool NodesOverlap(unsigned int first, unsigned int second) const;
+    bool TrianglesOverlap(unsigned int first, unsigned int second) const;
+
+};
+
+
+// Inline, collision tests call it for every corner of every candidate pair.
+
+inline unsigned int
+TriangleBvh::GetVertex(unsigned int triangle, unsigned int corner) const
+{
+    return vertices_[corner][triangle];
+}
+
+
+#endif // _TRIANGLEBVH_H_
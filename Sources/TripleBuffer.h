@@ -0,0 +1,88 @@
+#ifndef _TRIPLEBUFFER_H_
+#define _TRIPLEBUFFER_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : TripleBuffer.h
+ *
+ * Creation Date : 10/17/2026 - 16:05
+ * Last Modified : 10/17/2026 - 16:05
+ * ==========================================================================================
+ * Description   : Lock-free single-producer / single-consumer triple buffer.
+ *                 The producer fills the back slot and publishes it, the consumer picks up the
+ *                 most recently published slot. Neither side ever waits for the other: the
+ *                 producer never blocks on a slow reader and the reader always gets the newest
+ *                 complete value, skipping any it was too slow to see.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <atomic>
+
+
+template <typename T>
+class TripleBuffer
+{
+
+public:
+    TripleBuffer() : middle_(1)
+    {
+        back_ = 0;
+        front_ = 2;
+    }
+
+    TripleBuffer(const TripleBuffer &) = delete;
+    TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+    // Producer side. The back slot belongs to the producer until Publish().
+    T &GetBack()
+    {
+        return slots_[back_];
+    }
+
+    void Publish()
+    {
+        // The published slot becomes the middle one; the producer takes over the old middle.
+        unsigned int previous = middle_.exchange(back_ | DIRTY_BIT, std::memory_order_acq_rel);
+        back_ = previous & INDEX_MASK;
+    }
+
+    // Consumer side. Returns true when a newer value was published since the last call.
+    bool Acquire()
+    {
+        if (!(middle_.load(std::memory_order_acquire) & DIRTY_BIT))
+        {
+            return false;
+        }
+
+        unsigned int previous = middle_.exchange(front_, std::memory_order_acq_rel);
+        front_ = previous & INDEX_MASK;
+        return true;
+    }
+
+    const T &GetFront() const
+    {
+        return slots_[front_];
+    }
+
+    // Only before the producer and consumer threads start, e.g. to size every slot.
+    T &GetSlot(unsigned int index)
+    {
+        return slots_[index];
+    }
+
+
+private:
+    static const unsigned int INDEX_MASK = 3;
+    static const unsigned int DIRTY_BIT = 4;
+
+    T slots_[3];
+    // back_ is only touched by the producer, front_ only by the consumer.
+    unsigned int back_;
+    std::atomic<unsigned int> middle_;
+    unsigned int front_;
+
+};
+
+
+#endif // _TRIPLEBUFFER_H_
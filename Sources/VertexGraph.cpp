@@ -0,0 +1,109 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : VertexGraph.cpp
+ *
+ * Creation Date : 10/17/2026 - 20:05
+ * Last Modified : 10/17/2026 - 20:05
+ * ==========================================================================================
+ * Description   :
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <algorithm>
+
+#include "VertexGraph.h"
+#include "DistanceConstraint.h"
+
+
+// FUNCTIONS
+// ---------
+
+VertexGraph
+BuildVertexGraph(const std::map<unsigned int, std::vector<unsigned int>> &neighbors,
+                 const std::vector<DistanceConstraint> &constraints,
+                 unsigned int vertexCount)
+{
+    std::vector<std::vector<unsigned int>> lists(vertexCount);
+    for (auto neighborIt = neighbors.begin(); neighborIt != neighbors.end(); ++neighborIt)
+    {
+        if (neighborIt->first < vertexCount)
+        {
+            lists[neighborIt->first] = neighborIt->second;
+        }
+    }
+    for (auto constraintIt = constraints.begin(); constraintIt != constraints.end(); ++constraintIt)
+    {
+        lists[constraintIt->Vertex1Index].push_back(constraintIt->Vertex2Index);
+        lists[constraintIt->Vertex2Index].push_back(constraintIt->Vertex1Index);
+    }
+
+    VertexGraph graph;
+    graph.Offsets.resize(vertexCount + 1);
+    graph.Offsets[0] = 0;
+    for (unsigned int vertex = 0; vertex < vertexCount; ++vertex)
+    {
+        std::vector<unsigned int> &list = lists[vertex];
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+
+        graph.Neighbors.insert(graph.Neighbors.end(), list.begin(), list.end());
+        graph.Offsets[vertex + 1] = (unsigned int)graph.Neighbors.size();
+    }
+
+    return graph;
+}
+
+ConstraintColoring
+ColorVertices(const VertexGraph &graph)
+{
+    unsigned int vertexCount = (unsigned int)graph.Offsets.size() - 1;
+
+    // forbidden[color] == vertex + 1 marks a color taken by one of the vertex's neighbors.
+    const unsigned int NO_COLOR = 0xFFFFFFFF;
+    std::vector<unsigned int> colors(vertexCount, NO_COLOR);
+    std::vector<unsigned int> forbidden;
+    std::vector<unsigned int> colorSizes;
+
+    for (unsigned int vertex = 0; vertex < vertexCount; ++vertex)
+    {
+        for (unsigned int slot = graph.Offsets[vertex]; slot < graph.Offsets[vertex + 1]; ++slot)
+        {
+            unsigned int color = colors[graph.Neighbors[slot]];
+            if (color != NO_COLOR)
+            {
+                forbidden[color] = vertex + 1;
+            }
+        }
+
+        unsigned int color = 0;
+        while ((color < forbidden.size()) && (forbidden[color] == vertex + 1))
+        {
+            ++color;
+        }
+        if (color == forbidden.size())
+        {
+            forbidden.push_back(0);
+            colorSizes.push_back(0);
+        }
+
+        colors[vertex] = color;
+        ++colorSizes[color];
+    }
+
+    ConstraintColoring coloring;
+    coloring.Offsets.assign(colorSizes.size() + 1, 0);
+    for (unsigned int color = 0; color < colorSizes.size(); ++color)
+    {
+        coloring.Offsets[color + 1] = coloring.Offsets[color] + colorSizes[color];
+    }
+
+    coloring.Order.resize(vertexCount);
+    std::vector<unsigned int> next(coloring.Offsets.begin(), coloring.Offsets.end() - 1);
+    for (unsigned int vertex = 0; vertex < vertexCount; ++vertex)
+    {
+        coloring.Order[next[colors[vertex]]++] = vertex;
+    }
+
+    return coloring;
+}
@@ -0,0 +1,46 @@
+#ifndef _VERTEXGRAPH_H_
+#define _VERTEXGRAPH_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : VertexGraph.h
+ *
+ * Creation Date : 10/17/2026 - 20:05
+ * Last Modified : 10/17/2026 - 20:05
+ * ==========================================================================================
+ * Description   : Vertex adjacency in compressed rows, and a vertex coloring over it for
+ *                 solvers that update vertices rather than constraints in parallel.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <map>
+#include <vector>
+
+#include "ConstraintColoring.h"
+
+
+class DistanceConstraint;
+
+
+struct VertexGraph
+{
+    // Vertex v's neighbors are Neighbors[Offsets[v], Offsets[v + 1]), sorted.
+    std::vector<unsigned int> Offsets;
+    std::vector<unsigned int> Neighbors;
+};
+
+
+// Mesh::Neighbors (face adjacency) in compressed rows, plus the ends of any constraint face
+// adjacency does not cover (shear and bend edges), so that two vertices sharing a constraint are
+// always neighbors.
+VertexGraph BuildVertexGraph(const std::map<unsigned int, std::vector<unsigned int>> &neighbors,
+                             const std::vector<DistanceConstraint> &constraints,
+                             unsigned int vertexCount);
+
+// Greedy coloring: no two neighbors share a color. Same layout as a constraint coloring, over
+// vertices: color c is the vertices Order[Offsets[c], Offsets[c + 1]).
+ConstraintColoring ColorVertices(const VertexGraph &graph);
+
+
+#endif // _VERTEXGRAPH_H_
@@ -0,0 +1,49 @@
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : VertexIncidence.cpp
+ *
+ * Creation Date : 10/17/2026 - 14:10
+ * Last Modified : 10/17/2026 - 14:10
+ * ==========================================================================================
+ * Description   :
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include "VertexIncidence.h"
+#include "DistanceConstraint.h"
+
+
+VertexIncidence
+BuildVertexIncidence(const std::vector<DistanceConstraint> &constraints, unsigned int vertexCount)
+{
+    unsigned int constraintCount = (unsigned int)constraints.size();
+    VertexIncidence incidence;
+
+    incidence.Offsets.assign(vertexCount + 1, 0);
+    for (unsigned int index = 0; index < constraintCount; ++index)
+    {
+        ++incidence.Offsets[constraints[index].Vertex1Index + 1];
+        ++incidence.Offsets[constraints[index].Vertex2Index + 1];
+    }
+    for (unsigned int vertex = 0; vertex < vertexCount; ++vertex)
+    {
+        incidence.Offsets[vertex + 1] += incidence.Offsets[vertex];
+    }
+
+    incidence.Constraints.resize(incidence.Offsets[vertexCount]);
+    incidence.Signs.resize(incidence.Offsets[vertexCount]);
+    std::vector<unsigned int> cursor(incidence.Offsets.begin(), incidence.Offsets.end() - 1);
+    for (unsigned int index = 0; index < constraintCount; ++index)
+    {
+        unsigned int slot = cursor[constraints[index].Vertex1Index]++;
+        incidence.Constraints[slot] = index;
+        incidence.Signs[slot] = -1.0f;
+
+        slot = cursor[constraints[index].Vertex2Index]++;
+        incidence.Constraints[slot] = index;
+        incidence.Signs[slot] = 1.0f;
+    }
+
+    return incidence;
+}
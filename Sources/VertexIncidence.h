@@ -0,0 +1,38 @@
+#ifndef _VERTEXINCIDENCE_H_
+#define _VERTEXINCIDENCE_H_
+
+/* ==========================================================================================
+ * Project Name  : ClothSimulation
+ * File Name     : VertexIncidence.h
+ *
+ * Creation Date : 10/17/2026 - 14:10
+ * Last Modified : 10/17/2026 - 14:10
+ * ==========================================================================================
+ * Description   : Vertex -> incident distance constraints, in compressed sparse row form.
+ *                 Lets per-vertex loops gather from their constraints instead of every
+ *                 constraint scattering into shared vertices.
+ *
+ * Author        : Mehdi Rouijel
+ * ========================================================================================== */
+
+#include <vector>
+
+
+class DistanceConstraint;
+
+
+struct VertexIncidence
+{
+    // Vertex v's constraints are Constraints[Offsets[v], Offsets[v + 1]), in increasing order.
+    std::vector<unsigned int> Offsets;
+    std::vector<unsigned int> Constraints;
+    // -1 if v is the constraint's first vertex, +1 if it is the second, matching the sign of
+    // the correction DistanceConstraint::Solve() applies to that end.
+    std::vector<float> Signs;
+};
+
+
+VertexIncidence BuildVertexIncidence(const std::vector<DistanceConstraint> &constraints, unsigned int vertexCount);
+
+
+#endif // _VERTEXINCIDENCE_H_
@@ -0,0 +1,32 @@
+#!/bin/sh
+# ==========================================================================================
+# Project Name  : ClothSimulation
+# File Name     : build.sh
+#
+# Creation Date : 10/17/2026 - 09:55
+# Last Modified : 10/17/2026 - 22:35
+# ==========================================================================================
+# Description   : Headless build (Linux), no window and no GL context needed at runtime.
+#                 Requires g++ and the system Assimp library.
+#
+# Author        : Mehdi Rouijel
+# ==========================================================================================
+
+CompilerFlags="-std=c++14 -O2 -g -Wall -Wextra -Wno-unused-parameter"
+IncludesPath="../Includes"
+AdditionalLibs="-lassimp -ldl -lpthread"
+
+SolverSources="../Sources/ClothSolver.cpp ../Sources/DistanceConstraint.cpp ../Sources/ParticleStore.cpp ../Sources/PinSet.cpp ../Sources/CpuFeatures.cpp ../Sources/DistanceKernels.cpp ../Sources/ConstraintColoring.cpp ../Sources/ThreadPool.cpp ../Sources/VertexIncidence.cpp ../Sources/SimulationThread.cpp ../Sources/StateInterpolator.cpp ../Sources/Tethers.cpp ../Sources/ParticleHierarchy.cpp ../Sources/ProjectiveDynamics.cpp ../Sources/SparseLDLT.cpp ../Sources/BlockSparseMatrix.cpp ../Sources/ImplicitEuler.cpp ../Sources/VertexGraph.cpp ../Sources/BlockDescent.cpp ../Sources/BendingConstraints.cpp ../Sources/StrainConstraints.cpp ../Sources/SpatialHash.cpp ../Sources/SelfCollision.cpp ../Sources/TriangleBvh.cpp ../Sources/ContinuousCollision.cpp ../Sources/Colliders.cpp"
+MeshSources="../Sources/Mesh.cpp ../Sources/Model.cpp ../Sources/MeshTopology.cpp ../Sources/MeshOptimizer.cpp ../Sources/SignedDistanceField.cpp"
+
+
+mkdir -p ../Build
+cd ../Build || exit 1
+
+echo "Compilation started on - $(date) -"
+echo
+gcc -O2 -c ../Sources/glad.c -I $IncludesPath || exit 1
+g++ $CompilerFlags -I $IncludesPath $SolverSources $MeshSources ../Sources/Headless/ClothHeadless.cpp ../Sources/Headless/PerfCounter.cpp \
+    glad.o $AdditionalLibs -o ClothHeadless || exit 1
+echo
+echo "Compilation finished on - $(date) -"